@@ -23,6 +23,7 @@ namespace fippp
 			opts.bdsfopt = confReader.getValueAsInt("bdsfopt", "DEFAULT");
 			opts.bdsComb = confReader.getValueAsInt("bdsComb", "DEFAULT");
 			opts.codeOnly = confReader.getValueAsInt("codeOnly", "DEFAULT");
+			opts.measUpdate = confReader.getValueAsInt("measUpdate", "DEFAULT");
 			opts.exPrns = confReader.getValue("exPrns", "DEFAULT");
 			opts.obsCorr = confReader.getValueAsInt("obsCorr", "DEFAULT");
 			opts.ifcbCorr = confReader.getValueAsInt("ifcbCorr", "DEFAULT");
@@ -47,6 +48,11 @@ namespace fippp
 			opts.sampleIntrval = confReader.getValueAsDouble("sampleInterval", "DEFAULT");
 			opts.isDir = confReader.getValueAsInt("FileDir", "DEFAULT");
 			opts.dir = confReader.getValue("folder", "DEFAULT");
+			opts.threads = confReader.getValueAsInt("threads", "DEFAULT");
+			opts.fastRead = confReader.getValueAsInt("fastRead", "DEFAULT");
+			opts.prefetch = confReader.getValueAsInt("prefetch", "DEFAULT");
+			opts.productCache = confReader.getValue("productCache", "DEFAULT");
+			opts.cipStep = confReader.getValueAsDouble("cipStep", "DEFAULT");
 			opts.EstimateBias = confReader.getValueAsInt("EstimateBias", "DEFAULT");
 			///////////////////// Output /////////////////////////////
 			opts.outdir = confReader.getValue("outdir", "DEFAULT");
@@ -59,7 +65,11 @@ namespace fippp
 			opts.outResP = confReader.getValueAsInt("outResP", "DEFAULT");
 			opts.outResL = confReader.getValueAsInt("outResL", "DEFAULT");
 			opts.outPdop = confReader.getValueAsInt("outPdop", "DEFAULT");
+			opts.outQueue = confReader.getValueAsInt("outQueue", "DEFAULT");
 			opts.trace = confReader.getValueAsInt("trace", "DEFAULT");
+			opts.traceCompress = confReader.getValueAsInt("traceCompress", "DEFAULT");
+			opts.traceDecimate = confReader.getValueAsInt("traceDecimate", "DEFAULT");
+			opts.traceMaxDim = confReader.getValueAsInt("traceMaxDim", "DEFAULT");
 			//opts.outAmbF = confReader.getValueAsInt("outAmbF", "DEFAULT");
 
 			//////////////// File ////////////////////
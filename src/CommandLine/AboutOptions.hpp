@@ -34,6 +34,7 @@ namespace fippp
 			int    bdsfopt;
 			int    bdsComb;
 			int    codeOnly;
+			int    measUpdate;
 			std::string exPrns;
 			int    sppDcbCorr;
 			int	   obsCorr;
@@ -54,6 +55,11 @@ namespace fippp
 			int sampleIntrval;
 			int isDir;
 			string dir;
+			int threads;
+			int fastRead;
+			int prefetch;
+			string productCache;
+			double cipStep;
 			/////////// output//////
 			string aimOutPath;
 			string outdir;
@@ -66,7 +72,11 @@ namespace fippp
 			int	   outResP;
 			int	   outResL;
 			int	   outPdop;
+			int	   outQueue;
 			int	   trace;
+			int	   traceCompress;
+			int	   traceDecimate;
+			int	   traceMaxDim;
 			int	   outAmbF;
 
 			/////// files //////////
@@ -155,6 +165,16 @@ namespace fippp
 			modelCount
 		};
 		/// <summary>
+		/// kalman filter measurement update engines
+		/// </summary>
+		enum MeasUpdateModes
+		{
+			InfoForm = 0,
+			UDSeq,
+
+			measUpdateCount
+		};
+		/// <summary>
 		/// ambFixMode opts
 		/// </summary>
 		enum AmbFixModes
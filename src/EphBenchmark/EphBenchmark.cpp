@@ -0,0 +1,249 @@
+#pragma ident "$Id$"
+/*
+* Throughput of the broadcast ephemeris evaluation, with and
+* without the per-satellite ephemeris cache, for GPS/GAL/BDS/GLO.
+*
+* Usage: EphBenchmark -n brdm0010.23p [-s 30] [-r 3]
+*/
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <set>
+
+#include "BasicFramework.hpp"
+#include "Rinex3EphemerisStore.hpp"
+#include "Rinex3NavStream.hpp"
+#include "StringUtils.hpp"
+
+using namespace std;
+using namespace gpstk;
+using namespace gpstk::StringUtils;
+
+class EphBenchmark : public BasicFramework
+{
+public:
+	EphBenchmark(char* arg0);
+
+protected:
+
+	// Method that will take care of processing
+	virtual void process();
+
+private:
+
+	// Time the evaluation of the satellites of one system
+	void runSystem(const Rinex3EphemerisStore& nav,
+		const SatelliteSystem& sys, const string& name);
+
+	// satellites and first/last ephemeris epoch of each system, as read
+	map<SatelliteSystem, set<SatID> > sysSats;
+	map<SatelliteSystem, pair<CommonTime, CommonTime> > sysSpan;
+
+	CommandOptionWithAnyArg _navFile;
+	CommandOptionWithNumberArg _step;
+	CommandOptionWithNumberArg _rounds;
+
+	double step;
+	int rounds;
+};
+
+EphBenchmark::EphBenchmark(char* arg0)
+	: BasicFramework(arg0,
+		"Compare the throughput of Rinex3EphemerisStore::getXvt() "
+		"with and without the ephemeris cache."),
+	  _navFile('n', "nav",
+		" [-n|--nav]             RINEX navigation file(s).", true),
+	  _step('s', "step",
+		" [-s|--step]            Time step, seconds (default 30)."),
+	  _rounds('r', "rounds",
+		" [-r|--rounds]          Passes over the time span (default 3)."),
+	  step(30.0), rounds(3)
+{
+	_step.setMaxCount(1);
+	_rounds.setMaxCount(1);
+}
+
+void EphBenchmark::process()
+{
+	if (_step.getCount())
+		step = asDouble(_step.getValue()[0]);
+	if (_rounds.getCount())
+		rounds = asInt(_rounds.getValue()[0]);
+	if (step <= 0.0 || rounds <= 0)
+	{
+		cerr << "step and rounds must be positive" << endl;
+		exitCode = OPTION_ERROR;
+		return;
+	}
+
+	// searched as in the product store
+	Rinex3EphemerisStore nav;
+	nav.SearchNear();
+	for (size_t i = 0; i < _navFile.getValue().size(); i++)
+	{
+		const string& file = _navFile.getValue()[i];
+		try
+		{
+			if (nav.loadFile(file) < 0)
+			{
+				cerr << "cannot read " << file << ": " << nav.what << endl;
+				exitCode = EXIST_ERROR;
+				return;
+			}
+
+			// the per-system stores of GPS/GAL/BDS are not seen by
+			// isPresent(), so the satellites are listed from the file
+			Rinex3NavStream ns(file.c_str());
+			ns.exceptions(ios::failbit);
+
+			Rinex3NavHeader head;
+			Rinex3NavData data;
+			ns >> head;
+			while (1)
+			{
+				ns >> data;
+				if (!ns.good() || ns.eof())
+					break;
+
+				SatelliteSystem sys(data.sat.system);
+				sysSats[sys].insert(data.sat);
+				if (sysSpan.find(sys) == sysSpan.end())
+				{
+					sysSpan[sys] = make_pair(data.time, data.time);
+				}
+				else
+				{
+					pair<CommonTime, CommonTime>& span = sysSpan[sys];
+					if (data.time < span.first) span.first = data.time;
+					if (span.second < data.time) span.second = data.time;
+				}
+			}
+		}
+		catch (Exception& e)
+		{
+			cerr << "cannot read " << file << ": " << e.getText() << endl;
+			exitCode = EXIST_ERROR;
+			return;
+		}
+	}
+
+	cout << setw(5) << "sys" << setw(5) << "sats" << setw(10) << "calls"
+		<< setw(8) << "failed" << setw(12) << "plain/s" << setw(12)
+		<< "cached/s" << setw(9) << "speedup" << setw(12) << "max dpos"
+		<< endl;
+
+	runSystem(nav, SatelliteSystem::GPS, "GPS");
+	runSystem(nav, SatelliteSystem::Galileo, "GAL");
+	runSystem(nav, SatelliteSystem::BeiDou, "BDS");
+	runSystem(nav, SatelliteSystem::Glonass, "GLO");
+}
+
+void EphBenchmark::runSystem(const Rinex3EphemerisStore& nav,
+	const SatelliteSystem& sys, const string& name)
+{
+	if (sysSats.find(sys) == sysSats.end())
+	{
+		cout << setw(5) << name << "  no ephemeris" << endl;
+		return;
+	}
+	vector<SatID> sats(sysSats[sys].begin(), sysSats[sys].end());
+	CommonTime first(sysSpan[sys].first), last(sysSpan[sys].second);
+
+	// epochs of the receiver, in GPS time as the observations
+	first.setTimeSystem(TimeSystem::GPS);
+	last.setTimeSystem(TimeSystem::GPS);
+	vector<CommonTime> epochs;
+	for (CommonTime t = first; t <= last; t += step)
+		epochs.push_back(t);
+
+	// the same requests, epoch by epoch as in the processing
+	vector<Xvt> plain(epochs.size()*sats.size());
+	vector<Xvt> cached(plain.size());
+	vector<char> ok(plain.size(), 0);
+	long failed(0);
+
+	chrono::steady_clock::duration plainTime(0), cachedTime(0);
+	for (int r = 0; r < rounds; r++)
+	{
+		chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+		for (size_t i = 0; i < epochs.size(); i++)
+		{
+			for (size_t j = 0; j < sats.size(); j++)
+			{
+				size_t k = i*sats.size() + j;
+				try
+				{
+					plain[k] = nav.getXvt(sats[j], epochs[i]);
+					ok[k] = 1;
+				}
+				catch (InvalidRequest&)
+				{
+					ok[k] = 0;
+				}
+			}
+		}
+		chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+
+		Rinex3EphemerisStore::EphCache cache;
+		for (size_t i = 0; i < epochs.size(); i++)
+		{
+			for (size_t j = 0; j < sats.size(); j++)
+			{
+				size_t k = i*sats.size() + j;
+				try
+				{
+					cached[k] = nav.getXvt(sats[j], epochs[i], cache);
+				}
+				catch (InvalidRequest&)
+				{
+				}
+			}
+		}
+		chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+
+		plainTime += t1 - t0;
+		cachedTime += t2 - t1;
+	}
+
+	double maxDiff(0.0);
+	for (size_t k = 0; k < plain.size(); k++)
+	{
+		if (!ok[k])
+		{
+			failed++;
+			continue;
+		}
+		for (int c = 0; c < 3; c++)
+			maxDiff = std::max(maxDiff, std::abs(plain[k].x[c] - cached[k].x[c]));
+	}
+
+	double calls = double(plain.size()) * rounds;
+	double plainSec = chrono::duration<double>(plainTime).count();
+	double cachedSec = chrono::duration<double>(cachedTime).count();
+
+	cout << setw(5) << name << setw(5) << sats.size()
+		<< setw(10) << plain.size() << setw(8) << failed
+		<< fixed << setprecision(0)
+		<< setw(12) << (plainSec > 0.0 ? calls / plainSec : 0.0)
+		<< setw(12) << (cachedSec > 0.0 ? calls / cachedSec : 0.0)
+		<< setprecision(2)
+		<< setw(9) << (cachedSec > 0.0 ? plainSec / cachedSec : 0.0)
+		<< scientific << setprecision(1) << setw(12) << maxDiff
+		<< endl;
+	cout.unsetf(ios::floatfield);
+}
+
+int main(int argc, char* argv[])
+{
+	EphBenchmark program(argv[0]);
+	if (!program.initialize(argc, argv))
+		return 0;
+
+	if (!program.run())
+		return 1;
+
+	return program.exitCode;
+}
@@ -12,9 +12,12 @@ positioning_algo::positioning_algo(char *arg0)
     : BasicFramework(arg0, ""),
       // Option initialization. "true" means a mandatory option
 	  _configFile(CommandOption::stdType, 'c', "config",
-		       " [-c|--config]          Name of config file.", true)
+		       " [-c|--config]          Name of config file.", true),
+	  _threads('t', "threads",
+		       " [-t|--threads]         Number of stations processed concurrently.")
 {
     _configFile.setMaxCount(1);
+    _threads.setMaxCount(1);
 } // End of constructor details
 
 // Method that will be executed AFTER initialization but BEFORE processing
@@ -120,13 +123,108 @@ integer clock product combined with ROUND method!" << std::endl;
 		std::cout << "BDS-3Comb: " << opts.bComFromInt(cfgOpts.bdsComb).bCobAsString() << endl;
 	}
 
-	// ==>2nd, Parse required options
+
+	// ==>2nd, collect the stations to be processed
+	vector<string> obsFiles;
+	FindFile ff;
+	if (cfgOpts.isDir)
+	{
+		// traverse the folder to get the files.
+		if (cfgOpts.dir != "")
+		{
+			ff.setPath(cfgOpts.dir);
+			ff.traverseDir();
+		}
+		if (!ff.findObsFiles(obsFiles))
+		{
+			std::cerr << "Cannot get obs file!" << std::endl;
+			return;
+		}
+	}
+	else
+	{
+		obsFiles.push_back(cfgOpts.obsFile);
+	}
+
+	// number of stations processed at the same time,
+	// the command line overrides the config file.
+	int numThreads(cfgOpts.threads);
+	if (_threads.getCount())
+		numThreads = asInt(_threads.getValue()[0]);
+	if (numThreads <= 0)
+		numThreads = std::max(1, int(std::thread::hardware_concurrency()));
+	numThreads = std::min(numThreads, int(obsFiles.size()));
+	if (debug)
+		std::cout << "threads: " << numThreads << endl;
+
+	// every worker owns its tables and processor chain,
+	// and takes the next unprocessed station until all are done.
+	std::atomic<size_t> nextStation(0);
+	std::atomic<bool> stop(false);
+	std::mutex errorMutex;
+	ProductCache productCache;
+	std::vector<Exception> errors;
+	auto runWorker = [&]()
+	{
+		try
+		{
+			StationWorker worker;
+			worker.ff = ff;
+			worker.pProductCache = &productCache;
+			loadTables(cfgOpts, worker);
+			while (!stop)
+			{
+				size_t i = nextStation++;
+				if (i >= obsFiles.size())
+					break;
+				if (!processStation(obsFiles[i], cfgOpts, worker))
+					stop = true;
+			}
+		}
+		catch (Exception& e)
+		{
+			stop = true;
+			std::lock_guard<std::mutex> lock(errorMutex);
+			errors.push_back(e);
+		}
+		catch (std::exception& e)
+		{
+			// e.g. bad_alloc, reported by process() as the others
+			stop = true;
+			std::lock_guard<std::mutex> lock(errorMutex);
+			errors.push_back(Exception(std::string("std::exception: ") + e.what()));
+		}
+	};
+
+	if (numThreads == 1)
+	{
+		runWorker();
+	}
+	else
+	{
+		std::vector<std::thread> pool;
+		for (int i = 0; i < numThreads; i++)
+			pool.push_back(std::thread(runWorker));
+		for (auto& t : pool)
+			t.join();
+	}
+
+	if (!errors.empty())
+	{
+		Exception e(errors.front());
+		GPSTK_RETHROW(e);
+	}
+}   // End of process()
+
+// Method that loads the tables used by every station
+void positioning_algo::loadTables(const Options::options_t& cfgOpts,
+	StationWorker& worker) noexcept(false)
+{
 	/* get leap second file name from config file and read it stored to leapSecStore! */
-	LeapSecStore    leapSecStore;
 	try
 	{
-		std::string& leapSecFileName = cfgOpts.leapSecFileName;
-		leapSecStore.loadFile(leapSecFileName);
+		const std::string& leapSecFileName = cfgOpts.leapSecFileName;
+		worker.leapSecStore.loadFile(leapSecFileName);
 
 		if (debug)
 		{
@@ -135,17 +233,15 @@ integer clock product combined with ROUND method!" << std::endl;
 	}
 	catch (Exception& e)
 	{
-		std::cerr << "read leap second file error!" << endl;
-		std::cerr << e << endl;
-		std::exit(-1);
+		e.addText("read leap second file error!");
+		GPSTK_RETHROW(e);
 	}
 
 	//get de405 file name from config file and read it stored to solarSys!
-	SolarSystem     solarSys;
 	try
 	{
-		std::string& jplFileName = cfgOpts.jplFileName;
-		solarSys.initializeWithBinaryFile(jplFileName);
+		const std::string& jplFileName = cfgOpts.jplFileName;
+		worker.solarSys.initializeWithBinaryFile(jplFileName);
 		if (debug)
 		{
 			std::cout << "solarSys:" << jplFileName << endl;
@@ -153,17 +249,15 @@ integer clock product combined with ROUND method!" << std::endl;
 	}
 	catch (Exception& e)
 	{
-		std::cerr << "read de405 file error!" << endl;
-		std::cerr << e << endl;
-		std::exit(-1);
+		e.addText("read de405 file error!");
+		GPSTK_RETHROW(e);
 	}
 
 	//get atx file name from config file and read it!
-	AntexReader     antexReader;
 	try
 	{
-		std::string& atxFileName = cfgOpts.atxFileName;
-		antexReader.open(atxFileName);
+		const std::string& atxFileName = cfgOpts.atxFileName;
+		worker.antexReader.open(atxFileName);
 		if (debug)
 		{
 			std::cout << "antexReader:" << atxFileName << endl;
@@ -171,17 +265,15 @@ integer clock product combined with ROUND method!" << std::endl;
 	}
 	catch (Exception& e)
 	{
-		std::cerr << "read atx file error!" << endl;
-		std::cerr << e << endl;
-		std::exit(-1);
+		e.addText("read atx file error!");
+		GPSTK_RETHROW(e);
 	}
 
 	//get ocean load file name from config file and read it!
-	BLQDataReader   blqReader;
 	try
 	{
-		std::string& blqFileName = cfgOpts.blqFileName;
-		blqReader.open(blqFileName);
+		const std::string& blqFileName = cfgOpts.blqFileName;
+		worker.blqReader.open(blqFileName);
 		if (debug)
 		{
 			std::cout << "blqReader:" << blqFileName << endl;
@@ -189,796 +281,735 @@ integer clock product combined with ROUND method!" << std::endl;
 	}
 	catch (Exception& e)
 	{
-		std::cerr << "read ocean load file error!" << endl;
-		std::cerr << e << endl;
-		std::exit(-1);
+		e.addText("read ocean load file error!");
+		GPSTK_RETHROW(e);
 	}
+}   // End of loadTables()
+
+// Method that processes a single rinex observation file, returns
+// false if the remaining stations shall not be processed.
+bool positioning_algo::processStation(const std::string& obsFile,
+	Options::options_t cfgOpts,
+	StationWorker& worker) noexcept(false)
+{
+	// objects owned by the current worker
+	Options& opts = worker.opts;
+	FindFile& ff = worker.ff;
+	LeapSecStore& leapSecStore = worker.leapSecStore;
+	SolarSystem& solarSys = worker.solarSys;
+	AntexReader& antexReader = worker.antexReader;
+	BLQDataReader& blqReader = worker.blqReader;
 
-	FindFile ff;
 	double clkStart, clkEnd;
-	do
+	clkStart = Counter::now();
+	// files
+	string ephFile;
+	string biasFile;
+
+	string xyzFile;
+	vector<string> ifcbFileVec;
+	vector<string> sp3FileVec;
+	vector<string> clkFileVec;
+	vector<string> erpFileVec;
+
+	map<TypeID, string> updFileMap;
+
+	// class
+	XYZStore xyzStore;
+
+	Triple refPos;
+	Triple rcvPos;
+	
+
+	// get file that process
+	if (!cfgOpts.isDir)
 	{
-		clkStart = Counter::now();
-		// traverse the folder to get the files.
-		if (cfgOpts.isDir&&cfgOpts.dir!="")
+		try
 		{
-			ff.setPath(cfgOpts.dir);
-			ff.traverseDir();
-		}
-		// files
-		string obsFile;
-		string ephFile;
-		string biasFile;
-
-		string xyzFile;
-		vector<string> ifcbFileVec;
-		vector<string> sp3FileVec;
-		vector<string> clkFileVec;
-		vector<string> erpFileVec;
-
-		map<TypeID, string> updFileMap;
-
-		// class
-		Rinex3EphemerisStore brdcEph;
-		brdcEph.SearchNear();
-		SP3EphemerisStore sp3Store;
-		sp3Store.rejectBadPositions(true);
-		sp3Store.rejectBadClocks(true);
-		EOPDataStore erpStore;
-		BiasDataReader biasReader;
-		IFCBDataReader ifcbReader;
-		XYZStore xyzStore;
-		UPDDataReader updReader;
-
-		Triple refPos;
-		Triple rcvPos;
-		
-
-		// get file that process
-		if (!cfgOpts.isDir)
-		{
-			try
+			ephFile = cfgOpts.ephFile;
+			xyzFile = cfgOpts.xyzFile;
+			biasFile = cfgOpts.biasFile;
+			if (cfgOpts.ifcbCorr)
 			{
-				obsFile = cfgOpts.obsFile;
-				ephFile = cfgOpts.ephFile;
-				xyzFile = cfgOpts.xyzFile;
-				biasFile = cfgOpts.biasFile;
-				if (cfgOpts.ifcbCorr)
-				{
-					string& ifcbFile = cfgOpts.ifcbFile;
-					stringSplit(ifcbFile, ifcbFileVec, ' ');
-				}
-				string& sp3File = cfgOpts.sp3File;
-				stringSplit(sp3File, sp3FileVec, ' ');
+				string& ifcbFile = cfgOpts.ifcbFile;
+				stringSplit(ifcbFile, ifcbFileVec, ' ');
+			}
+			string& sp3File = cfgOpts.sp3File;
+			stringSplit(sp3File, sp3FileVec, ' ');
 
-				string& clkFile = cfgOpts.clkFile;
-				stringSplit(clkFile, clkFileVec, ' ');
+			string& clkFile = cfgOpts.clkFile;
+			stringSplit(clkFile, clkFileVec, ' ');
 
-				string erpFile = cfgOpts.erpFile;
-				stringSplit(erpFile, erpFileVec, ' ');
-				if (cfgOpts.ambFixMode)
-				{
-					updFileMap[TypeID::EWL] = cfgOpts.ewlUPD;
-					updFileMap[TypeID::WL] = cfgOpts.wlUPD;
-					updFileMap[TypeID::NL] = cfgOpts.nlUPD;
-				}
-			}
-			catch (Exception e)
+			string erpFile = cfgOpts.erpFile;
+			stringSplit(erpFile, erpFileVec, ' ');
+			if (cfgOpts.ambFixMode)
 			{
-				std::cerr << e << endl;
-				std::cerr << "ERROR: get file from config file error!" << endl;
-				std::exit(-1);
+				updFileMap[TypeID::EWL] = cfgOpts.ewlUPD;
+				updFileMap[TypeID::WL] = cfgOpts.wlUPD;
+				updFileMap[TypeID::NL] = cfgOpts.nlUPD;
 			}
 		}
-		else
+		catch (Exception& e)
 		{
-			try
-			{
-				if (!ff.findObsFile(obsFile))
-				{
-					std::cerr << "Cannot get obs file!" << std::endl;
-					return;
-				}
-				ff.addPObs(obsFile);
-			}
-			catch (Exception e)
-			{
-				std::cout << e.getText() << endl;
-				return;
-			}
-			
-		}	// End of get files
+			e.addText("ERROR: get file from config file error!");
+			GPSTK_RETHROW(e);
+		}
+	}	// End of get files
+
+	Rinex3ObsHeader rxHeader;
+	Rinex3ObsData rxData;
+	Rinex3ObsStream rxStream(obsFile.c_str(), ios::in);   // Object to read Rinex observation data files
+	if (!rxStream)
+	{
+		std::cerr << "can't open file:" << obsFile.c_str() << endl;
+	}
+	else
+	{
+		std::cout << "obsFile: " << obsFile << endl;
+	}
+	// now, let's read data for current satiation
+	rxStream >> rxHeader;
+	// the records are parsed from a memory copy of the file
+	rxStream.setFastRead(cfgOpts.fastRead != 0);
 
-		Rinex3ObsHeader rxHeader;
-		Rinex3ObsData rxData;
-		Rinex3ObsStream rxStream(obsFile.c_str(), ios::in);   // Object to read Rinex observation data files
-		if (!rxStream)
+	// first time
+	CommonTime firstEpoch, lastEpoch, headEpoch;
+	headEpoch = rxHeader.firstObs.convertToCommonTime();
+	double interval = rxHeader.interval;
+	firstEpoch = rxHeader.firstObs.convertToCommonTime() + int(cfgOpts.begin_sod / interval) * interval;
+	lastEpoch = rxHeader.firstObs.convertToCommonTime() + int(cfgOpts.end_sod / interval) * interval;
+	// Check whether the obstype meets the requirements
+	if(!opts.checkObsType(rxHeader, cfgOpts)) 
+		return true;
+	// added by ragn wang.
+	rxHeader.beginEpoch = firstEpoch;
+	rxHeader.endEpoch = lastEpoch;
+	// header of the file with the observation types as TypeID, shared
+	// by all the epochs
+	std::shared_ptr<const gnssRinexFileHeader> fileHeader;
+	try
+	{
+		fileHeader = std::make_shared<const gnssRinexFileHeader>(rxHeader);
+	}
+	catch (InvalidType& e)
+	{
+		std::cerr << e << std::endl;
+		std::cerr << "unknown observation type in: " << obsFile << std::endl;
+		return true;
+	}
+	if (cfgOpts.isDir)
+	{
+		if (!ff.findEphFile(headEpoch, ephFile))
 		{
-			std::cerr << "can't open file:" << obsFile.c_str() << endl;
+			std::cout << "Cannot find EPH File in: " << cfgOpts.dir << std::endl;
+			return false;
 		}
-		else
+		if (!ff.findSnxFile(headEpoch, xyzFile)) 
 		{
-			std::cout << "obsFile: " << obsFile << endl;
-		}
-		// now, let's read data for current satiation
-		rxStream >> rxHeader;
-
-		// first time
-		CommonTime firstEpoch, lastEpoch, headEpoch;
-		headEpoch = rxHeader.firstObs.convertToCommonTime();
-		double interval = rxHeader.interval;
-		firstEpoch = rxHeader.firstObs.convertToCommonTime() + int(cfgOpts.begin_sod / interval) * interval;
-		lastEpoch = rxHeader.firstObs.convertToCommonTime() + int(cfgOpts.end_sod / interval) * interval;
-		// Check whether the obstype meets the requirements
-		if(!opts.checkObsType(rxHeader, cfgOpts)) 
-			continue;
-		// added by ragn wang.
-		rxHeader.beginEpoch = firstEpoch;
-		rxHeader.endEpoch = lastEpoch;
-		if (cfgOpts.isDir)
-		{
-			if (!ff.findEphFile(headEpoch, ephFile))
-			{
-				std::cout << "Cannot find EPH File in: " << cfgOpts.dir << std::endl;
-				return;
-			}
-			if (!ff.findSnxFile(headEpoch, xyzFile)) 
-			{
-				std::cout << "Cannot find Snx File in: " << cfgOpts.dir << std::endl;
-				return;
-			}
-			if (cfgOpts.obsCorr ? 
-				(cfgOpts.obsCorr==Options::DCB?
-				(!ff.findDCBFile(headEpoch, biasFile)) :
-				(!ff.findBiaFile(headEpoch, biasFile))
-					):0
-				)
-			{
-				std::cout << "Cannot find Bias File in: " << cfgOpts.dir << std::endl;
-				return;
-			}
-			if (cfgOpts.ifcbCorr && (!ff.findSGGIfcb(headEpoch, ifcbFileVec)))
-			{
-				std::cout << "Cannot find IFCB File in: " << cfgOpts.dir << std::endl;
-				return;
-			}
-
-			if (!ff.findClkFile(headEpoch, clkFileVec))
-			{
-				std::cout << "Cannot find CLK File in: " << cfgOpts.dir << std::endl;
-				return;
-			}
-			if (!ff.findErpFile(headEpoch, erpFileVec))
-			{
-				std::cout << "Cannot find ERP File in: " << cfgOpts.dir << std::endl;
-				return;
-			}
-			if (!ff.findSp3File(headEpoch, sp3FileVec))
-			{
-				std::cout << "Cannot find SP3 File in: " << cfgOpts.dir << std::endl;
-				return;
-			}
-			if (cfgOpts.ambFixMode && (!ff.findUPDFile(headEpoch, updFileMap)))
-			{
-				std::cout << "Cannot find upd files in: " << cfgOpts.dir << std::endl;
-				return;
-			}
+			std::cout << "Cannot find Snx File in: " << cfgOpts.dir << std::endl;
+			return false;
 		}
-
-		// load file data
-		// read ephFile
-		try
+		if (cfgOpts.obsCorr ? 
+			(cfgOpts.obsCorr==Options::DCB?
+			(!ff.findDCBFile(headEpoch, biasFile)) :
+			(!ff.findBiaFile(headEpoch, biasFile))
+				):0
+			)
 		{
-			if (debug)
-			{
-				std::cout << "Broadcast ephemeris file: " << ephFile << endl;
-			}
-			brdcEph.loadFile(ephFile);
+			std::cout << "Cannot find Bias File in: " << cfgOpts.dir << std::endl;
+			return false;
 		}
-		catch (Exception& e)
+		if (cfgOpts.ifcbCorr && (!ff.findSGGIfcb(headEpoch, ifcbFileVec)))
 		{
-			cerr << e.getLocation();
-			cerr << " cannot read: " << ephFile << endl;
-			GPSTK_THROW(e);
+			std::cout << "Cannot find IFCB File in: " << cfgOpts.dir << std::endl;
+			return false;
 		}
-		// read bias file
-		try
+
+		if (!ff.findClkFile(headEpoch, clkFileVec))
 		{
-            if(cfgOpts.obsCorr)
-                biasReader.open(biasFile);
-			if (debug)
-				std::cout << "biasReader:" << biasFile << endl;
+			std::cout << "Cannot find CLK File in: " << cfgOpts.dir << std::endl;
+			return false;
 		}
-		catch (Exception e)
+		if (!ff.findErpFile(headEpoch, erpFileVec))
 		{
-			std::cerr << e << endl;
-			std::cerr << "unknown error in read erp file" << endl;
-			std::exit(-1);
+			std::cout << "Cannot find ERP File in: " << cfgOpts.dir << std::endl;
+			return false;
 		}
-		// read xyzFile
-		try
+		if (!ff.findSp3File(headEpoch, sp3FileVec))
 		{
-			if (debug)
-				std::cout << "station reference coord file: " << xyzFile << std::endl;
-			if (std::string::npos == xyzFile.find(".snx"))
-			{
-				xyzStore.loadFile(xyzFile);
-				CommonTime posTi;
-				refPos = xyzStore.getPos(rxHeader.markerName.substr(0, 4), posTi);
-			}
-			else
-				xyzStore.loadFile(xyzFile, upperCase(rxHeader.markerName.substr(0, 4)), refPos);
-		}   //End of read xyzFile
-		catch (std::exception& e)
+			std::cout << "Cannot find SP3 File in: " << cfgOpts.dir << std::endl;
+			return false;
+		}
+		if (cfgOpts.ambFixMode && (!ff.findUPDFile(headEpoch, updFileMap)))
 		{
-			std::cerr << e.what() << std::endl;
+			std::cout << "Cannot find upd files in: " << cfgOpts.dir << std::endl;
+			return false;
 		}
-		// read precise files.
-		if (cfgOpts.mode != Options::SPP)
+	}
+
+	// load file data
+	// the products are shared by all the stations of the same day
+	ProductStore::ProductFiles productFiles;
+	productFiles.epoch = headEpoch;
+	productFiles.ephFile = ephFile;
+	productFiles.biasFile = biasFile;
+	productFiles.sp3Files = sp3FileVec;
+	productFiles.clkFiles = clkFileVec;
+	productFiles.erpFiles = erpFileVec;
+	productFiles.ifcbFiles = ifcbFileVec;
+	productFiles.updFiles = updFileMap;
+	std::shared_ptr<const ProductStore> products(
+		worker.pProductCache->get(productFiles, cfgOpts));
+	const Rinex3EphemerisStore& brdcEph = products->getBrdcEph();
+	const SP3EphemerisStore& sp3Store = products->getSP3Store();
+	const EOPDataStore& erpStore = products->getERPStore();
+	const BiasDataReader& biasReader = products->getBiasReader();
+	const IFCBDataReader& ifcbReader = products->getIFCBReader();
+	const UPDDataReader& updReader = products->getUPDReader();
+
+	// read xyzFile
+	try
+	{
+		if (debug)
+			std::cout << "station reference coord file: " << xyzFile << std::endl;
+		if (std::string::npos == xyzFile.find(".snx"))
 		{
-			try
-			{
-				// read sp3file
-				for (auto f : sp3FileVec)
-				{
-					if (debug)
-						std::cout << "sp3 file:" << f << endl;
-					try
-					{
-						sp3Store.loadSP3File(f);
-					}
-					catch (Exception& e)
-					{
-						std::cerr << e << endl;
-						std::cerr << "unknown error in read sp3 data" << endl;
-						std::exit(-1);
-					}
-				}
-				// read clk file
-				for (auto f : clkFileVec)
-				{
-					if (debug)
-						std::cout << "clk file:" << f << endl;
-					try
-					{
-						sp3Store.loadRinexClockFile(f);
-						if (cfgOpts.ambFixMode &&
-							cfgOpts.ambProduct == Options::IRC)
-						{
-							updReader.loadIRCWL(f, headEpoch);
-						}
-					}
-					catch (Exception& e)
-					{
-						std::cerr << e << endl;
-						std::cerr << "unknown error in read clk file" << endl;
-						std::exit(-1);
-					}
-				}
-				// check IRC
-				if (cfgOpts.ambFixMode &&
-					cfgOpts.ambProduct == Options::IRC &&
-					(!updReader.checkWLData()))
-				{
-					std::cout << "unknown error in loading IRC Product WL data!" << std::endl;
-					exit(-1);
-				}
+			xyzStore.loadFile(xyzFile);
+			CommonTime posTi;
+			refPos = xyzStore.getPos(rxHeader.markerName.substr(0, 4), posTi);
+		}
+		else
+			xyzStore.loadFile(xyzFile, upperCase(rxHeader.markerName.substr(0, 4)), refPos);
+	}   //End of read xyzFile
+	catch (std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+	}
+	// DecimateData data 
+	//filter observation according the start and end epoch and process interval in seted in the config file
+	DecimateData decimateData;
+	decimateData.setInitialEpoch(firstEpoch);
+	decimateData.setEndEpoch(lastEpoch);
+	decimateData.setSampleInterval(cfgOpts.sampleIntrval);
 
-				// read erp file
-				for (auto f : erpFileVec)
-				{
-					try
-					{
-						if (debug)
-						{
-							std::cout << "erp file:" << f << endl;
-						}
-						erpStore.loadIGSFile(f);
-					}
-					catch (Exception e)
-					{
-						std::cerr << e << endl;
-						std::cerr << "unknown error in read erp file" << endl;
-						std::exit(-1);
-					}
-				}
-				// read ifcb file
-				if (cfgOpts.ifcbCorr)
-				{
-					try
-					{
-						for (auto f : ifcbFileVec)
-						{
-							if (debug)
-								std::cout << "ifcb file:" << f << endl;
-							ifcbReader.open(f);
-						}
-					}
-					catch (Exception e)
-					{
-						std::cerr << e << endl;
-						std::cerr << "unknown error in read ifcb file" << endl;
-						std::exit(-1);
-					}
-				}
-				//read upd
-				if (cfgOpts.ambFixMode && cfgOpts.ambProduct == Options::UPD)
-				{
-					try
-					{
-						updReader.loadFile(updFileMap);
-					}
-					catch (Exception& e)
-					{
-						cerr << e.what() << endl;
-						GPSTK_THROW(e);
-					}
+	// ReferenceSystem
+	//used for calculate the transformation matrix between two coordination reference system
+	//such as:CIS2ECEF and so on
+	ReferenceSystem refSys;
+	refSys.setEOPDataStore(erpStore);
+	refSys.setLeapSecStore(leapSecStore);
+	// precession-nutation interpolated on a grid of cipStep seconds
+	if (cfgOpts.cipStep > 0.0)
+	{
+		refSys.setCIPInterpolation(cfgOpts.cipStep);
+		if (debug)
+		{
+			ReferenceSystem::CIPAccuracy cipAcc = refSys.checkCIPInterpolation(
+				refSys.GPS2UTC(firstEpoch), refSys.GPS2UTC(lastEpoch), 100);
+			std::cout << "CIP interpolation error (uas): X " << cipAcc.X
+				<< " Y " << cipAcc.Y << " s " << cipAcc.s
+				<< " xp " << cipAcc.xp << " yp " << cipAcc.yp
+				<< " UT1 (us) " << cipAcc.UT1mUTC
+				<< ", cost (us) " << cipAcc.interpTime*1e6
+				<< " vs " << cipAcc.fullTime*1e6 << endl;
+		}
+	}
 
-				}	// End of read upd files
+	// keep satellite system for positioning
+	//filter observation according the input system information in config file
+	KeepSystems keepSystems(cfgOpts.system);
 
-			}
-			catch (Exception e)
+	// filter out bad code/phase observables
+	//use for filter observation according to the range of pseudo range observation
+	//default:[15000000.0,45000000.0]
+	//if the observation is zero,that must be removed from the observation list
+	FilterCode filterCode;
+
+	// optimal observations
+	//choose one optimal observation if there are more than one observation in this frequency band.
+	ChooseOptimalObs chooseObs;
+
+	//  code biases
+	//used for correct the C1 pseudo range observation to P1 observation
+	CorrectCodeBiases codeBias;
+	codeBias.setDCBStore(biasReader);
+	codeBias.setDCBCorr(cfgOpts.obsCorr);
+	codeBias.setBDSFf(cfgOpts.bdsfopt);
+	CorrectPhaseBiases phaseBias;
+	if (cfgOpts.obsCorr==Options::OSB)
+		phaseBias.setBiasStore(biasReader);
+	// convert 4-char TypeID to 2-char TypeID for easy use in following classes
+	//store short types of satellite observations
+	//such as: L1CG=> L1G; C1WG=>C1G
+	ConvertObs convertObs;
+	// used for correct the L5G phase ifcb value.
+	CorrectIFCB cifcb;
+	cifcb.setIFCBStore(ifcbReader);
+	
+	//used for filter observation type according default type.
+	RequiredObs reqObs;
+	reqObs.setOpts(cfgOpts);
+	// detect cycle slips, ragn wang
+	DetectCSGF detectGFCS;
+	DetectCSMW detectMWCS;
+	// now, let's compute mw12 for gps/galileo/bds
+	ComputeCombination computeMW;
+	ComputeCombination computeGF;
+	// the combination is consistent with the CODE's orbit/clock products
+	ComputeCombination computeLC;
+	// undifference-prefit
+	ComputeCombination computePrefit;
+	// compute residual include ambiguity, clk
+	ComputeResidual computeResidual;
+	// add combination options
+	LinearCombinations linear;
+	CombinationOptions combOpts(linear);
+	combOpts.setOpts(cfgOpts);
+	combOpts.addReqObsType(reqObs);
+	combOpts.addComputeCSType(computeMW, computeGF);
+	combOpts.addCSType(detectGFCS, detectMWCS);
+	combOpts.addLCType(computeLC);
+	combOpts.addPrefitType(computePrefit, computeResidual);
+	// mark satellite-arc
+	//update the epoch time of cycle slip and the num of cycle slip when it appears.
+	MarkArc markArc;
+	EraseSat eraseSat(cfgOpts);
+	// compute satellite-positions according to sp3
+	ComputeSatPos computeSatPos(sp3Store);
+
+	// now, geometry-based models
+	ComputeDerivative computeDerivative;
+	// tropospheric model
+	SaasTropModel saasTM;
+	ComputeTropModel computeTrop;
+	computeTrop.setTropModel(saasTM);
+	// grav
+	GravitationalDelay gravDelay;
+	// Sun/Moon and Earth orientation of the epoch, shared by
+	// the eclipse, phase center, wind-up and tide models
+	ComputeEpochContext epochContext;
+	epochContext.setReferenceSystem(refSys);
+	epochContext.setSolarSystem(solarSys);
+	// attitude
+	ComputeSatAttitude satAttitude;
+	satAttitude.setReferenceSystem(refSys);
+	satAttitude.setSolarSystem(solarSys);
+	satAttitude.setAntexReader(antexReader);
+
+	// eclipsed filter 
+	EclipsedSatFilter eclipsedSV;
+	eclipsedSV.setAntexReader(antexReader);
+
+	// pc center
+	ComputeSatPCenter satPCenter;
+	satPCenter.setAntexReader(antexReader);
+	satPCenter.setEclipse(eclipsedSV);
+
+	ComputeWindUp windUp;
+	windUp.setEclipse(eclipsedSV);
+
+	// solid/ocean/polar tides
+	ComputeStaTides staTides;
+	staTides.setReferenceSystem(refSys);
+	staTides.setSolarSystem(solarSys);
+	staTides.setBLQDataReader(blqReader);
+
+	// receiver bias
+	//get pco and tide etc. for correction reveiver position
+	CorrectRecBias recBias;
+	recBias.setTidePointer(staTides);
+	recBias.setAntexReader(antexReader);
+	recBias.setUseAzimuth(false);
+	// the reference station position
+	XYZ2NEU xyz2neu;
+	xyz2neu.setRefPos(refPos);
+	// out put pos file path
+	vector<string> res;
+	string obsName("");
+	string fileRootPath("");
+	char splitType('\\');
+
+	pathSplitType(obsFile, res, splitType);
+	if (res.size() == 0)
+	{
+		Exception e("Cannot get file root path");
+		GPSTK_THROW(e);
+	}
+	obsName = res[res.size() - 1];
+	auto itName(find(res.begin(), res.end(), obsName));
+	res.erase(itName);
+	stringStitch(res, fileRootPath, splitType);
+	
+	string bds3Type, codeOnly;
+	if(cfgOpts.system.find("C")!=string::npos)
+		bds3Type = opts.bComFromInt(cfgOpts.bdsComb).bCobAsString() + "_";
+	if (cfgOpts.codeOnly)
+		codeOnly = "P_";
+
+	std::string proMode(opts.modeFromInt(cfgOpts.mode).modeAsString());
+	std::string ionMode(opts.ionFromInt(cfgOpts.ionoopt).ionAsString());
+	std::string aimDir(cfgOpts.outdir);
+	
+	// creat output dir path
+	if (aimDir == "")
+	{
+		fileRootPath += proMode + "_" + ionMode + "_" + cfgOpts.system 
+			+ "_" + bds3Type + splitType;
+		_mkdir(fileRootPath.c_str());
+	}
+	else
+	{
+		fileRootPath += aimDir + splitType;
+		_mkdir(fileRootPath.c_str());
+	}
+
+	std::string fwdOutFile = fileRootPath + codeOnly +
+		proMode + "_" + ionMode + "_" + bds3Type +
+		cfgOpts.system + "_" + upperCase(obsName);
+	// Obtaining the output Obs name is 
+	// convenient for outputting other files.
+	cfgOpts.aimOutPath=fwdOutFile;
+	fwdOutFile += ".pos";
+	if (cfgOpts.mode == Options::SPP)
+	{
+		fwdOutFile = fileRootPath + proMode + "_" +
+			cfgOpts.system + "_" + upperCase(obsName) + ".pos";
+	}
+	// the solution files are written by this thread; it is declared
+	// before the streams and solvers so that it outlives them
+	SolutionWriter solWriter(cfgOpts.outQueue);
+	SolutionStream floatOutStream;
+	if (cfgOpts.ambFixMode)
+	{
+		if (cfgOpts.floatFix)
+		{
+			if (!floatOutStream.open(fwdOutFile, &solWriter))
 			{
-				std::cerr << e << std::endl;
+				Exception e("can't open fwdOutFile: " + fwdOutFile);
+				GPSTK_THROW(e);
 			}
-			// end of load file data
-		}	// End of if !SPP
-
-		// DecimateData data 
-		//filter observation according the start and end epoch and process interval in seted in the config file
-		DecimateData decimateData;
-		decimateData.setInitialEpoch(firstEpoch);
-		decimateData.setEndEpoch(lastEpoch);
-		decimateData.setSampleInterval(cfgOpts.sampleIntrval);
-
-		// ReferenceSystem
-		//used for calculate the transformation matrix between two coordination reference system
-		//such as:CIS2ECEF and so on
-		ReferenceSystem refSys;
-		refSys.setEOPDataStore(erpStore);
-		refSys.setLeapSecStore(leapSecStore);
-
-		// keep satellite system for positioning
-		//filter observation according the input system information in config file
-		KeepSystems keepSystems(cfgOpts.system);
-
-		// filter out bad code/phase observables
-		//use for filter observation according to the range of pseudo range observation
-		//default:[15000000.0,45000000.0]
-		//if the observation is zero,that must be removed from the observation list
-		FilterCode filterCode;
-
-		// optimal observations
-		//choose one optimal observation if there are more than one observation in this frequency band.
-		ChooseOptimalObs chooseObs;
-
-		//  code biases
-		//used for correct the C1 pseudo range observation to P1 observation
-		CorrectCodeBiases codeBias;
-		codeBias.setDCBStore(biasReader);
-		codeBias.setDCBCorr(cfgOpts.obsCorr);
-		codeBias.setBDSFf(cfgOpts.bdsfopt);
-		CorrectPhaseBiases phaseBias;
-		if (cfgOpts.obsCorr==Options::OSB)
-			phaseBias.setBiasStore(biasReader);
-		// convert 4-char TypeID to 2-char TypeID for easy use in following classes
-		//store short types of satellite observations
-		//such as: L1CG=> L1G; C1WG=>C1G
-		ConvertObs convertObs;
-		// used for correct the L5G phase ifcb value.
-		CorrectIFCB cifcb;
-		cifcb.setIFCBStore(ifcbReader);
-		
-		//used for filter observation type according default type.
-		RequiredObs reqObs;
-		reqObs.setOpts(cfgOpts);
-		// detect cycle slips, ragn wang
-		DetectCSGF detectGFCS;
-		DetectCSMW detectMWCS;
-		// now, let's compute mw12 for gps/galileo/bds
-		ComputeCombination computeMW;
-		ComputeCombination computeGF;
-		// the combination is consistent with the CODE's orbit/clock products
-		ComputeCombination computeLC;
-		// undifference-prefit
-		ComputeCombination computePrefit;
-		// compute residual include ambiguity, clk
-		ComputeResidual computeResidual;
-		// add combination options
-		LinearCombinations linear;
-		CombinationOptions combOpts(linear);
-		combOpts.setOpts(cfgOpts);
-		combOpts.addReqObsType(reqObs);
-		combOpts.addComputeCSType(computeMW, computeGF);
-		combOpts.addCSType(detectGFCS, detectMWCS);
-		combOpts.addLCType(computeLC);
-		combOpts.addPrefitType(computePrefit, computeResidual);
-		// mark satellite-arc
-		//update the epoch time of cycle slip and the num of cycle slip when it appears.
-		MarkArc markArc;
-		EraseSat eraseSat(cfgOpts);
-		// compute satellite-positions according to sp3
-		ComputeSatPos computeSatPos(sp3Store);
-
-		// now, geometry-based models
-		ComputeDerivative computeDerivative;
-		// tropospheric model
-		SaasTropModel saasTM;
-		ComputeTropModel computeTrop;
-		computeTrop.setTropModel(saasTM);
-		// grav
-		GravitationalDelay gravDelay;
-		// attitude
-		ComputeSatAttitude satAttitude;
-		satAttitude.setReferenceSystem(refSys);
-		satAttitude.setSolarSystem(solarSys);
-		satAttitude.setAntexReader(antexReader);
-
-		// eclipsed filter 
-		EclipsedSatFilter eclipsedSV;
-		eclipsedSV.setAntexReader(antexReader);
-
-		// pc center
-		ComputeSatPCenter satPCenter;
-		satPCenter.setAntexReader(antexReader);
-		satPCenter.setEclipse(eclipsedSV);
-
-		ComputeWindUp windUp;
-		windUp.setEclipse(eclipsedSV);
-
-		// solid/ocean/polar tides
-		ComputeStaTides staTides;
-		staTides.setReferenceSystem(refSys);
-		staTides.setSolarSystem(solarSys);
-		staTides.setBLQDataReader(blqReader);
-
-		// receiver bias
-		//get pco and tide etc. for correction reveiver position
-		CorrectRecBias recBias;
-		recBias.setTidePointer(staTides);
-		recBias.setAntexReader(antexReader);
-		recBias.setUseAzimuth(false);
-		// the reference station position
-		XYZ2NEU xyz2neu;
-		xyz2neu.setRefPos(refPos);
-		// out put pos file path
-		vector<string> res;
-		string obsName("");
-		string fileRootPath("");
-		char splitType('\\');
-
-		pathSplitType(obsFile, res, splitType);
-		if (res.size() == 0)
-		{
-			Exception e("Cannot get file root path");
-			GPSTK_THROW(e);
-		}
-		obsName = res[res.size() - 1];
-		auto itName(find(res.begin(), res.end(), obsName));
-		res.erase(itName);
-		stringStitch(res, fileRootPath, splitType);
-		
-		string bds3Type, codeOnly;
-		if(cfgOpts.system.find("C")!=string::npos)
-			bds3Type = opts.bComFromInt(cfgOpts.bdsComb).bCobAsString() + "_";
-		if (cfgOpts.codeOnly)
-			codeOnly = "P_";
-
-		std::string proMode(opts.modeFromInt(cfgOpts.mode).modeAsString());
-		std::string ionMode(opts.ionFromInt(cfgOpts.ionoopt).ionAsString());
-		std::string aimDir(cfgOpts.outdir);
-		
-		// creat output dir path
-		if (aimDir == "")
-		{
-			fileRootPath += proMode + "_" + ionMode + "_" + cfgOpts.system 
-				+ "_" + bds3Type + splitType;
-			_mkdir(fileRootPath.c_str());
-		}
-		else
-		{
-			fileRootPath += aimDir + splitType;
-			_mkdir(fileRootPath.c_str());
 		}
 
-		std::string fwdOutFile = fileRootPath + codeOnly +
-			proMode + "_" + ionMode + "_" + bds3Type +
-			cfgOpts.system + "_" + upperCase(obsName);
-		// Obtaining the output Obs name is 
-		// convenient for outputting other files.
-		cfgOpts.aimOutPath=fwdOutFile;
-		fwdOutFile += ".pos";
-		if (cfgOpts.mode == Options::SPP)
+		fwdOutFile = fileRootPath +
+			proMode + "_" +
+			ionMode + "_" +
+			opts.ambFixFromInt(cfgOpts.ambFixMode).ambFixModeAsStr() + "_" +
+			opts.ambFixFrqFromInt(cfgOpts.fixFreq).ambFixFrqAsStr() + "_" +
+			cfgOpts.system + "_" + upperCase(obsName) + ".pos";
+	}
+
+	SolutionStream fwdOutStream;
+	if (cfgOpts.outPos)
+	{
+		if (!fwdOutStream.open(fwdOutFile, &solWriter))
 		{
-			fwdOutFile = fileRootPath + proMode + "_" +
-				cfgOpts.system + "_" + upperCase(obsName) + ".pos";
+			Exception e("can't open fwdOutFile: " + fwdOutFile);
+			GPSTK_THROW(e);
 		}
-		std::ofstream floatOutStream;
+	}
+
+	// solver SPP
+	SPP spp(brdcEph, cfgOpts);
+	bool isSPP(false);
+	spp.setRefPos(refPos);
+	if (cfgOpts.mode == Options::SPP&&cfgOpts.outPos)
+	{
+		spp.setFwdOutStream(&fwdOutStream);
+	}
+	// SolverPPPAll object
+	SolverPPPAll pppFilter;
+	pppFilter.setSysLinear(computePrefit.getLinear());
+	pppFilter.setOpts(cfgOpts);
+	pppFilter.setUpEquations();			// add variable into equation
+	pppFilter.setRefPos(refPos);
+	pppFilter.setSolutionWriter(&solWriter);
+
+	// PPPAR
+	PPPAR pppAR;
+	pppAR.setOpts(cfgOpts);
+	pppAR.setRefPos(refPos);
+	if (cfgOpts.outPos)
+	{
 		if (cfgOpts.ambFixMode)
 		{
+			pppAR.setStream(&fwdOutStream);
 			if (cfgOpts.floatFix)
-			{
-				floatOutStream.open(fwdOutFile.c_str(), ios::out);
-				if (!floatOutStream.is_open())
-				{
-					std::cerr << "can't open fwdOutFile!" << endl;
-					std::exit(-1);
-				}
-			}
-
-			fwdOutFile = fileRootPath +
-				proMode + "_" +
-				ionMode + "_" +
-				opts.ambFixFromInt(cfgOpts.ambFixMode).ambFixModeAsStr() + "_" +
-				opts.ambFixFrqFromInt(cfgOpts.fixFreq).ambFixFrqAsStr() + "_" +
-				cfgOpts.system + "_" + upperCase(obsName) + ".pos";
+				pppFilter.setFwdOutStream(&floatOutStream);
 		}
-
-		std::ofstream fwdOutStream;
-		if (cfgOpts.outPos)
+		else
+			pppFilter.setFwdOutStream(&fwdOutStream);
+	}
+	// set trace
+	TraceStream traceOutStream;
+	if (cfgOpts.trace)
+	{
+		if (cfgOpts.trace == TraceStream::Binary)
+			traceOutStream.open(cfgOpts.aimOutPath + ".trb",
+				TraceStream::Binary, cfgOpts.traceCompress != 0);
+		else
+			traceOutStream.open(cfgOpts.aimOutPath + ".trace",
+				TraceStream::Text);
+		if (!traceOutStream.is_open())
 		{
-			fwdOutStream.open(fwdOutFile.c_str(), ios::out);
-			if (!fwdOutStream.is_open())
+			Exception e("can't open trace file: " + cfgOpts.aimOutPath);
+			GPSTK_THROW(e);
+		}
+		traceOutStream.setDecimation(cfgOpts.traceDecimate);
+		traceOutStream.setMaxDim(cfgOpts.traceMaxDim);
+		spp.setTraceStream(&traceOutStream);
+		pppFilter.setTraceStream(&traceOutStream);
+		pppAR.setTraceStream(&traceOutStream);
+	}
+	
+	
+	// front stages of the chain, they do not depend on the filter
+	// and are run ahead of it by the prefetch thread
+	auto prepareEpoch = [&](PrefetchedEpoch& epoch)
+	{
+		// read data (epoch by epoch)
+		try
+		{
+			rxStream >> rxData;
+			if (rxStream.eof())
 			{
-				std::cerr << "can't open fwdOutFile!" << endl;
-				std::exit(-1);
+				epoch.status = PrefetchedEpoch::End;
+				return;
 			}
 		}
+		catch (FFStreamError& e)
+		{
+			epoch.status = PrefetchedEpoch::ReadError;
+			epoch.message = "Cannot get obs epoch data!";
+			return;
+		}
+		catch (EndOfFile& e)
+		{
+			epoch.status = PrefetchedEpoch::End;
+			return;
+		}
+		epoch.time = rxData.time;
 
-		// solver SPP
-		SPP spp(brdcEph, cfgOpts);
-		bool isSPP(false);
-		spp.setRefPos(refPos);
-		if (cfgOpts.mode == Options::SPP&&cfgOpts.outPos)
+		// now, convert to gnssRinex
+		// Add the corresponding data header to the epoch observation data
+		// And match the observation type with the observation value as a key-value pair
+		epoch.gRin.reset(new gnssRinex(rxData, fileHeader));
+		gnssRinex& gRin(*epoch.gRin);
+		gRin.header.refPos = refPos;
+		gRin.header.system = cfgOpts.system;
+		try
 		{
-			spp.setFwdOutStream(&fwdOutStream);
+			// Determine whether the current epoch is within 
+			// the input start and end time
+			decimateData.Process(gRin);
 		}
-		// SolverPPPAll object
-		SolverPPPAll pppFilter;
-		pppFilter.setSysLinear(computePrefit.getLinear());
-		pppFilter.setOpts(cfgOpts);
-		pppFilter.setUpEquations();			// add variable into equation
-		pppFilter.setRefPos(refPos);
+		//jump this epoch
+		catch (DecimateException& e)
+		{
+			ostringstream os;
+			os << e;
+			epoch.status = PrefetchedEpoch::Skipped;
+			epoch.message = os.str();
+			return;
+		}
+		if (gRin.header.epochFlag > 1)
+		{
+			epoch.status = PrefetchedEpoch::Skipped;
+			epoch.message = "current epoch data cannot be used!";
+			return;
+		}
+
+		// Added enu/neu rotate Matrix
+		// to the observation map
+		xyz2neu.Process(gRin);
 
-		// PPPAR
-		PPPAR pppAR;
-		pppAR.setOpts(cfgOpts);
-		pppAR.setRefPos(refPos);
-		if (cfgOpts.outPos)
+		// keep only given system
+		keepSystems.Process(gRin);
+		// remove exclude sats.
+		eraseSat.Process(gRin);
+		// Filter out the set of observations with 
+		// pseudorange values of 0 and out of range (CLSD)
+		filterCode.Process(gRin);
+		// Keep CL Observations
+		chooseObs.Process(gRin);
+	};
+	EpochPrefetcher prefetcher(prepareEpoch, cfgOpts.prefetch);
+
+	// now, let's process gnss data for curret station
+	std::cout << "now, start processing file:" << obsFile << endl;
+	PrefetchedEpoch epoch;
+	while (prefetcher.pop(epoch))
+	{
+		try
 		{
-			if (cfgOpts.ambFixMode)
+			if (epoch.status == PrefetchedEpoch::End)
+				break;
+			if (epoch.status == PrefetchedEpoch::Failed)
 			{
-				pppAR.setStream(&fwdOutStream);
-				if (cfgOpts.floatFix)
-					pppFilter.setFwdOutStream(&floatOutStream);
+				std::cerr << epoch.message << endl;
+				break;
 			}
-			else
-				pppFilter.setFwdOutStream(&fwdOutStream);
-		}
-		// set trace
-		std::ofstream traceOutStream;
-		if (cfgOpts.trace)
-		{
-			traceOutStream.open((cfgOpts.aimOutPath + ".trace").c_str(), ios::out);
-			if (!traceOutStream.is_open())
-				exit(-1);
-			spp.setTraceStream(&traceOutStream);
-			pppFilter.setTraceStream(&traceOutStream);
-			pppAR.setTraceStream(&traceOutStream);
-		}
-		
-		
-		// now, let's process gnss data for curret station
-		std::cout << "now, start processing file:" << obsFile << endl;
-		while (true)
-		{
-			try
+			if (epoch.status != PrefetchedEpoch::Ready)
 			{
-				// read data (epoch by epoch)
-				try
-				{
-					rxStream >> rxData;
-					rxData.auxHeader = rxHeader;
-					if (rxStream.eof())	break;
-				}
-				catch (FFStreamError& e)
-				{
-					std::cerr << "Cannot get obs epoch data!" << std::endl;
-					continue;
-				}
-				catch (EndOfFile& e)
-				{
-					break;
-				}
-
-				// now, convert to gnssRinex
-				// Add the corresponding data header to the epoch observation data
-				// And match the observation type with the observation value as a key-value pair
-				gnssRinex gRin(rxData);
-				gRin.header.refPos = refPos;
-				gRin.header.system = cfgOpts.system;
-				try
-				{
-					// Determine whether the current epoch is within 
-					// the input start and end time
-					decimateData.Process(gRin);
-				}
-				//jump this epoch
-				catch (DecimateException& e)
-				{
-					std::cerr << e << std::endl;
-					continue;
-				}
-				if (gRin.header.epochFlag > 1)
-				{
-					std::cerr << "current epoch data cannot be used!" << std::endl;
-					continue;
-				}
+				std::cerr << epoch.message << std::endl;
+				continue;
+			}
+			gnssRinex& gRin(*epoch.gRin);
+			traceOutStream.setEpoch(gRin.header.epoch);
 
-				// Added enu/neu rotate Matrix
-				// to the observation map
-				xyz2neu.Process(gRin);
-
-				// keep only given system
-				keepSystems.Process(gRin);
-				// remove exclude sats.
-				eraseSat.Process(gRin);
-				// Filter out the set of observations with 
-				// pseudorange values of 0 and out of range (CLSD)
-				filterCode.Process(gRin);
-				// Keep CL Observations
-				chooseObs.Process(gRin);
-				// spp
-				if (cfgOpts.sppDcbCorr)
-					codeBias.Process(gRin);
+			// spp
+			if (cfgOpts.sppDcbCorr)
+				codeBias.Process(gRin);
 
-				if (cfgOpts.mode == Options::SPP)
-				{
+			if (cfgOpts.mode == Options::SPP)
+			{
+				spp.Process(gRin);
+				continue;
+			}
+			// initialize rcvPos for first epoch
+			if (gRin.header.epoch == gRin.header.beginEpoch||
+				!isSPP)
+			{
+				try {
 					spp.Process(gRin);
-					continue;
+					rcvPos = gRin.header.rcvPos;
+					isSPP = true;
 				}
-				// initialize rcvPos for first epoch
-				if (gRin.header.epoch == gRin.header.beginEpoch||
-					!isSPP)
+				catch(...)
 				{
-					try {
-						spp.Process(gRin);
-						rcvPos = gRin.header.rcvPos;
-						isSPP = true;
-					}
-					catch(...)
+					if (gRin.header.antennaPosition.mag() != 0)
+					{ rcvPos = gRin.header.antennaPosition; isSPP=true; }
+					else if (gRin.header.refPos.mag() != 0)
+					{ rcvPos = gRin.header.refPos; isSPP = true; }
+					else
 					{
-						if (gRin.header.antennaPosition.mag() != 0)
-						{ rcvPos = gRin.header.antennaPosition; isSPP=true; }
-						else if (gRin.header.refPos.mag() != 0)
-						{ rcvPos = gRin.header.refPos; isSPP = true; }
-						else
-						{
-							isSPP = false;
-							pppFilter.printNewLine();
-							if (cfgOpts.ambFixMode)
-								pppAR.printNewLine();
-							continue;
-						}
-					}
-					if (cfgOpts.mode == Options::PPP_KIN)
 						isSPP = false;
+						pppFilter.printNewLine();
+						if (cfgOpts.ambFixMode)
+							pppAR.printNewLine();
+						continue;
+					}
 				}
-				traceT(&traceOutStream, "receiver pos: ", rcvPos);
-				traceT(&traceOutStream, "receiver refrence pos: ", refPos);
-				// set rcvPos
-				computeTrop.setAllParameters(gRin.header.epoch, rcvPos, 1);
-				computeDerivative.setCoordinates(rcvPos);
-				gravDelay.setNominalPosition(rcvPos);
-				satPCenter.setNominalPosition(rcvPos);
-				windUp.setNominalPosition(rcvPos);
-				staTides.setNominalPosition(rcvPos);
-				recBias.setNominalPosition(rcvPos);
-				pppFilter.setRcvPos(rcvPos);
-				pppAR.setRcvPos(rcvPos);
-				//code bias correction
-				if (cfgOpts.obsCorr > Options::NONE) 
-				{
-					if (!cfgOpts.sppDcbCorr)
-						codeBias.Process(gRin);
-					if (cfgOpts.obsCorr == Options::OSB)
-						phaseBias.Process(gRin);
-				}
-				// C1WG->C1G, L1WG->L1G
-				convertObs.Process(gRin);
-				if (cfgOpts.ifcbCorr)
-					cifcb.Process(gRin);
-				// required obs
-				reqObs.Process(gRin);
-				// if all satellites are removed, then continue
-				if (gRin.numSats() == 0)
-				{
-					std::cout << "The number of sat is 0!"
-						<< std::endl;
-					pppFilter.printNewLine();
-					if (cfgOpts.ambFixMode)
-						pppAR.printNewLine();
-					continue;
-				}
-				// compute satellite position and velocity
-				computeSatPos.Process(gRin);
-				//// detect cs
-				computeMW.Process(gRin);
-				detectMWCS.Process(gRin);
-				computeGF.Process(gRin);
-				detectGFCS.Process(gRin);
-				markArc.Process(gRin);
-				// Compute and obtain multi-frequency combined observations
-				computeLC.Process(gRin);
-				// compute dops{GDOP, PDOP, HDOP, VDOP}
-				computeDerivative.Process(gRin);
-				//observation correction relative with satellite attitude
-				eclipsedSV.Process(gRin);
-				gravDelay.Process(gRin);
-				satPCenter.Process(gRin);
-				windUp.Process(gRin);
-				//observation correction of tropospheric delay
-				computeTrop.Process(gRin);
-				// Observation station tide correction
-				staTides.Process(gRin);
-				// Receiver Antenna Correction
-				recBias.Process(gRin);
-				// filter-related class
-				// Add weights based on satellite elevation weighting
-				// elevation-weight for solver
-				ComputeElevWeights elevWeights;
-				elevWeights.Process(gRin);
-				// Compute residuals for individual and combined observation equations
-				computePrefit.Process(gRin);
-				if (gRin.numSats() < 4)
-				{
-					std::cout <<
-						static_cast<YDSTime>(gRin.header.epoch)
-						<< "sat number: "
-						<< gRin.numSats()
-						<< std::endl;
-					pppFilter.printNewLine();
-					if (cfgOpts.ambFixMode)
-						pppAR.printNewLine();
-					if (rxData.time == lastEpoch)	break;
-					continue;
-				}
-				// ppp Filter float solution
-				pppFilter.Process(gRin);
-				// ppp AR solution
+				if (cfgOpts.mode == Options::PPP_KIN)
+					isSPP = false;
+			}
+			traceT(&traceOutStream, "receiver pos: ", rcvPos);
+			traceT(&traceOutStream, "receiver refrence pos: ", refPos);
+			// set rcvPos
+			computeTrop.setAllParameters(gRin.header.epoch, rcvPos, 1);
+			computeDerivative.setCoordinates(rcvPos);
+			gravDelay.setNominalPosition(rcvPos);
+			satPCenter.setNominalPosition(rcvPos);
+			windUp.setNominalPosition(rcvPos);
+			staTides.setNominalPosition(rcvPos);
+			recBias.setNominalPosition(rcvPos);
+			pppFilter.setRcvPos(rcvPos);
+			pppAR.setRcvPos(rcvPos);
+			//code bias correction
+			if (cfgOpts.obsCorr > Options::NONE) 
+			{
+				if (!cfgOpts.sppDcbCorr)
+					codeBias.Process(gRin);
+				if (cfgOpts.obsCorr == Options::OSB)
+					phaseBias.Process(gRin);
+			}
+			// C1WG->C1G, L1WG->L1G
+			convertObs.Process(gRin);
+			if (cfgOpts.ifcbCorr)
+				cifcb.Process(gRin);
+			// required obs
+			reqObs.Process(gRin);
+			// if all satellites are removed, then continue
+			if (gRin.numSats() == 0)
+			{
+				std::cout << "The number of sat is 0!"
+					<< std::endl;
+				pppFilter.printNewLine();
 				if (cfgOpts.ambFixMode)
-				{
-					pppAR.setUPD(updReader);
-					pppAR.setCurrentEqus(pppFilter.getCurrentEqus());
-					pppAR.setPostResiduals(pppFilter.getPostResi());
-					pppAR.setSolutions(pppFilter.getSols());
-					pppAR.setPPPUnkSet(pppFilter.getUnkSet());
-					pppAR.setP(pppFilter.getP());
-					pppAR.Process(gRin);
-				}
-				// end of while
-				if (rxData.time == lastEpoch)	break;
+					pppAR.printNewLine();
+				continue;
 			}
-			catch (Exception& e)
+			// compute satellite position and velocity
+			computeSatPos.Process(gRin);
+			//// detect cs
+			computeMW.Process(gRin);
+			detectMWCS.Process(gRin);
+			computeGF.Process(gRin);
+			detectGFCS.Process(gRin);
+			markArc.Process(gRin);
+			// Compute and obtain multi-frequency combined observations
+			computeLC.Process(gRin);
+			// compute dops{GDOP, PDOP, HDOP, VDOP}
+			computeDerivative.Process(gRin);
+			// epoch-level values used by the models below
+			epochContext.Process(gRin);
+			//observation correction relative with satellite attitude
+			eclipsedSV.Process(gRin);
+			gravDelay.Process(gRin);
+			satPCenter.Process(gRin);
+			windUp.Process(gRin);
+			//observation correction of tropospheric delay
+			computeTrop.Process(gRin);
+			// Observation station tide correction
+			staTides.Process(gRin);
+			// Receiver Antenna Correction
+			recBias.Process(gRin);
+			// filter-related class
+			// Add weights based on satellite elevation weighting
+			// elevation-weight for solver
+			ComputeElevWeights elevWeights;
+			elevWeights.Process(gRin);
+			// Compute residuals for individual and combined observation equations
+			computePrefit.Process(gRin);
+			if (gRin.numSats() < 4)
 			{
-				std::cerr << e << endl;
-				break;
+				std::cout <<
+					static_cast<YDSTime>(gRin.header.epoch)
+					<< "sat number: "
+					<< gRin.numSats()
+					<< std::endl;
+				pppFilter.printNewLine();
+				if (cfgOpts.ambFixMode)
+					pppAR.printNewLine();
+				if (epoch.time == lastEpoch)	break;
+				continue;
+			}
+			// ppp Filter float solution
+			pppFilter.Process(gRin);
+			// ppp AR solution
+			if (cfgOpts.ambFixMode)
+			{
+				pppAR.setUPD(updReader);
+				pppAR.setCurrentEqus(pppFilter.getCurrentEqus());
+				pppAR.setPostResiduals(pppFilter.getPostResi());
+				pppAR.setSolutions(pppFilter.getSols());
+				pppAR.setPPPUnkSet(pppFilter.getUnkSet());
+				pppAR.setP(pppFilter.getP());
+				pppAR.Process(gRin);
 			}
+			// end of while
+			if (epoch.time == lastEpoch)	break;
+		}
+		catch (Exception& e)
+		{
+			std::cerr << e << endl;
+			break;
+		}
 
-		} // end of "while()" to get epoch data
-		rxStream.close();
-		clkEnd = Counter::now();
-		// close streams 
-		std::cout << "/*--------------------------------------------------------------------*/" << endl;
-		std::cout << "End of processing file:" << endl
-			<< "  " << obsFile << endl;
-		std::cout << "  Take: " << fixed
-			<< setprecision(3)
-			<< (clkEnd - clkStart) << "s" << endl;
-		std::cout << "/*--------------------------------------------------------------------*/" << endl;
-
-	} while (cfgOpts.isDir);
-}   // End of process()
+	} // end of "while()" to get epoch data
+	prefetcher.stop();
+	rxStream.close();
+	clkEnd = Counter::now();
+	// close streams 
+	std::cout << "/*--------------------------------------------------------------------*/" << endl;
+	std::cout << "End of processing file:" << endl
+		<< "  " << obsFile << endl;
+	std::cout << "  Take: " << fixed
+		<< setprecision(3)
+		<< (clkEnd - clkStart) << "s" << endl;
+	std::cout << "/*--------------------------------------------------------------------*/" << endl;
+
+	return true;
+}   // End of processStation()
 
 int main(int argc, char *argv[])
 {
@@ -4,6 +4,9 @@
 */
 #include <iostream>
 #include <direct.h>
+#include <thread>
+#include <mutex>
+#include <atomic>
 
 #include "Rinex3ObsData.hpp"
 #include "Rinex3ObsHeader.hpp"
@@ -29,6 +32,7 @@
 #include "BiasDataReader.hpp"
 #include "XYZStore.hpp"
 #include "UPDDataReader.hpp"
+#include "ProductStore.hpp"
 #include "ReferenceSystem.hpp"
 #include "DecimateData.hpp"
 #include "KeepSystems.hpp"
@@ -46,6 +50,7 @@
 #include "ComputeDerivative.hpp"
 #include "ComputeTropModel.hpp"
 #include "GravitationalDelay.hpp"
+#include "ComputeEpochContext.hpp"
 #include "ComputeSatAttitude.hpp"
 #include "EclipsedSatFilter.hpp"
 #include "ComputeSatPCenter.hpp"
@@ -70,6 +75,8 @@
 #include "SolverPPPAR.hpp"
 #include "ComputeResidual.hpp"
 #include "Trace.hpp"
+#include "EpochPrefetcher.hpp"
+#include "SolutionWriter.hpp"
 
 
 #ifdef __cplusplus
@@ -86,6 +93,23 @@ using namespace gpstk;
 using namespace fippp;
 
 
+// Objects owned by one station worker. The readers below cache data
+// lazily and keep file handles open, so they cannot be shared between
+// concurrently processed stations. The day products are read-only and
+// shared by all workers through the product cache.
+struct StationWorker
+{
+	StationWorker() : pProductCache(NULL) {};
+
+	LeapSecStore    leapSecStore;
+	SolarSystem     solarSys;
+	AntexReader     antexReader;
+	BLQDataReader   blqReader;
+	FindFile        ff;
+	Options         opts;	// in order to put string
+	ProductCache*   pProductCache;
+};
+
 // A new class is declared that will handle program behaviour
 // This class inherits from BasicFramework
 class positioning_algo : public BasicFramework
@@ -105,8 +129,20 @@ protected:
 
 private:
 
+	// Method that loads the tables shared by all stations of a worker,
+	// throws Exception if a table cannot be read
+	void loadTables(const Options::options_t& cfgOpts,
+		StationWorker& worker) noexcept(false);
+
+	// Method that processes one rinex observation file, throws
+	// Exception if an output file cannot be opened
+	bool processStation(const std::string& obsFile,
+		Options::options_t cfgOpts,
+		StationWorker& worker) noexcept(false);
+
 	// These field represent options at command line interface (CLI)
 	CommandOptionWithArg _configFile;
+	CommandOptionWithNumberArg _threads;
 
 	Options opts;	// in order to put string
 };
\ No newline at end of file
@@ -138,6 +138,31 @@ namespace fippp
 
 	}
 	/// <summary>
+	/// find all the obs files that have not been processed 
+	/// in the input dir path, sorted by name
+	/// </summary>
+	/// <param name="obsVec"> out obs files </param>
+	bool FindFile::findObsFiles(std::vector<std::string>& obsVec)
+	{
+		obsVec.clear();
+		auto it = fileMap.find(TypeID::OBSF);
+		if (it == fileMap.end())
+			return false;
+
+		for (auto it_obs = it->second.begin();
+			it_obs != it->second.end();
+			++it_obs)
+		{
+			if (pObsSet.find(*it_obs) == pObsSet.end())
+				obsVec.push_back(*it_obs);
+		}
+		if (debug)
+		{
+			std::cout << "obs files: " << obsVec.size() << std::endl;
+		}
+		return !obsVec.empty();
+	}
+	/// <summary>
 	/// Match the nav file according to the observation time of the obs file
 	/// </summary>
 	/// <param name="epoch"> obs first Epoch </param>
@@ -42,6 +42,7 @@ namespace fippp
 		virtual void traverseDir();
 		// find file
 		virtual bool findObsFile(std::string& obs);
+		virtual bool findObsFiles(std::vector<std::string>& obsVec);
 		virtual bool findEphFile(const CommonTime& epoch, std::string& p);
 		virtual bool findBiaFile(const CommonTime& epoch, std::string& bia);
 		virtual bool findDCBFile(const CommonTime& epoch, std::string& dcb);
@@ -156,6 +156,66 @@ namespace gpstk
 
 
 
+      // Get antenna eccentricity in UEN system, without allocating or
+      // throwing.
+   bool Antenna::getEccentricityUEN( frequencyType freq,
+                                     double uen[3] ) const
+   {
+
+      AntennaEccDataMap::const_iterator it( antennaEccMap.find(freq) );
+      if( it == antennaEccMap.end() )
+      {
+         return false;
+      }
+
+         // Stored as NEU
+      uen[0] = (*it).second[2];
+      uen[1] = (*it).second[1];
+      uen[2] = (*it).second[0];
+
+      return true;
+
+   }  // End of method 'Antenna::getEccentricityUEN()'
+
+
+
+      // Get the elevation-dependent phase center variation, without
+      // allocating or throwing.
+   bool Antenna::getPCVariationUp( frequencyType freq,
+                                   double elevation,
+                                   double& up ) const
+   {
+
+         // The angle should be measured respect to zenith
+      double angle( 90.0 - elevation );
+
+      if( ( angle < zen1 ) ||
+          ( angle > zen2 ) )
+      {
+         return false;
+      }
+
+      const PCVGrid* grid( findPCVGrid(freq) );
+      if( grid != NULL && !grid->noAzi.empty() )
+      {
+         up = gridInterpol( &grid->noAzi[0], (angle-zen1)/dzen );
+         return true;
+      }
+
+      NoAziDataMap::const_iterator it( noAziMap.find(freq) );
+      if( it == noAziMap.end() )
+      {
+         return false;
+      }
+
+      up = linearInterpol( (*it).second, (angle-zen1)/dzen );
+
+      return true;
+
+   }  // End of method 'Antenna::getPCVariationUp()'
+
+
+
       /* Get antenna phase center variation. Use this method when you
        * don't have azimuth dependent phase center patterns.
        *
@@ -190,6 +250,17 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
+         // Use the grid if there is one
+      const PCVGrid* grid( findPCVGrid(freq) );
+      if( grid != NULL && !grid->noAzi.empty() )
+      {
+         Triple result( gridInterpol( &grid->noAzi[0], (angle-zen1)/dzen ),
+                        0.0,
+                        0.0 );
+
+         return result;
+      }
+
          // Look for this frequency in noAziMap
          // Define iterator
       NoAziDataMap::const_iterator it( noAziMap.find(freq) );
@@ -253,6 +324,43 @@ namespace gpstk
          azimuth -= 360.0;
       }
 
+         // Use the grid if there is one. Its rows are exactly the
+         // azimuths of the map, so it fails where the map does
+      const PCVGrid* grid( findPCVGrid(freq) );
+      if( grid != NULL && grid->nAzi > 0 )
+      {
+         const double index( std::floor(azimuth/dazi) );
+         const double lowerAzimuth( index * dazi );
+         const double upperAzimuth( lowerAzimuth + dazi );
+         const double fractionalAzimuth( ( azimuth - lowerAzimuth ) /
+                                         ( upperAzimuth - lowerAzimuth ) );
+
+         const double nAzi( static_cast<double>(grid->nAzi) );
+         if( fractionalAzimuth == 0.0 && !( index < nAzi ) )
+         {
+            InvalidRequest e("No data was found for this azimuth.");
+            GPSTK_THROW(e);
+         }
+         if( fractionalAzimuth != 0.0 && !( index + 1.0 < nAzi ) )
+         {
+            InvalidRequest e("Not enough data was found for this azimuth.");
+            GPSTK_THROW(e);
+         }
+
+         const double normalizedAngle( (angle-zen1)/dzen );
+         const double* row( &grid->azi[ static_cast<size_t>(index) *
+                                        grid->rowSize ] );
+         double val1( gridInterpol( row, normalizedAngle ) );
+         double val2( gridInterpol( row + grid->rowSize, normalizedAngle ) );
+
+            // Return result. Only the "Up" component is important.
+         Triple result( ( val1 + (val2-val1) * fractionalAzimuth ),
+                        0.0,
+                        0.0 );
+
+         return result;
+      }
+
          // Look for this frequency in pcMap
          // Define iterator
       PCDataMap::const_iterator it( pcMap.find(freq) );
@@ -407,6 +515,203 @@ namespace gpstk
 
 
 
+      // Get the phase center variation of 'freq' for a set of directions
+      // at once.
+   void Antenna::getPCVariations( frequencyType freq,
+                                  const std::vector<double>& elevation,
+                                  const std::vector<double>& azimuth,
+                                  std::vector<double>& pcv,
+                                  std::vector<unsigned char>& valid ) const
+   {
+
+      const size_t n( elevation.size() );
+      const bool useAzimuth( !azimuth.empty() );
+
+      pcv.assign( n, 0.0 );
+      valid.assign( n, 0 );
+
+      const PCVGrid* grid( findPCVGrid(freq) );
+      const bool haveGrid( grid != NULL &&
+                           ( useAzimuth ? ( grid->nAzi > 0 )
+                                        : !grid->noAzi.empty() ) );
+
+      if( !haveGrid )
+      {
+            // No grid for this pattern: ask the maps one by one
+         for(size_t i = 0; i < n; i++)
+         {
+            try
+            {
+               pcv[i] = useAzimuth
+                      ? getAntennaPCVariation( freq, elevation[i], azimuth[i] )[0]
+                      : getAntennaPCVariation( freq, elevation[i] )[0];
+               valid[i] = 1;
+            }
+            catch(InvalidRequest& e)
+            {
+               pcv[i] = 0.0;
+            }
+         }
+
+         return;
+      }
+
+      const double* const grid0( useAzimuth ? &grid->azi[0]
+                                            : &grid->noAzi[0] );
+      const size_t rowSize( grid->rowSize );
+      const double nAzi( static_cast<double>(grid->nAzi) );
+
+         // Directions out of range are pointed at the first node and
+         // masked at the end, so the loop body has no early exits
+      for(size_t i = 0; i < n; i++)
+      {
+         const double angle( 90.0 - elevation[i] );
+         bool ok( angle >= zen1 && angle <= zen2 );
+
+         const double normalizedAngle( ok ? (angle-zen1)/dzen : 0.0 );
+
+         const double* row( grid0 );
+         double fractionalAzimuth( 0.0 );
+
+         if( useAzimuth )
+         {
+               // Fold into [0, 360] without data dependent loops; a
+               // rounded 360.0 is caught by the range check below
+            double azim( azimuth[i] );
+            azim -= 360.0 * std::floor( azim/360.0 );
+
+               // Same arithmetic as getAntennaPCVariation()
+            const double index( std::floor(azim/dazi) );
+            const double lowerAzimuth( index * dazi );
+            const double upperAzimuth( lowerAzimuth + dazi );
+            fractionalAzimuth = ( azim - lowerAzimuth ) /
+                                ( upperAzimuth - lowerAzimuth );
+
+            ok = ok && index >= 0.0 &&
+                 ( fractionalAzimuth == 0.0 ? ( index < nAzi )
+                                            : ( index + 1.0 < nAzi ) );
+
+            if( ok )
+            {
+               row += static_cast<size_t>(index) * rowSize;
+            }
+            else
+            {
+               fractionalAzimuth = 0.0;
+            }
+         }
+
+            // With no azimuth, the second row is the first one weighted
+            // by zero; the grids are padded so it can always be read
+         const double val1( gridInterpol( row, normalizedAngle ) );
+         const double val2( useAzimuth
+                            ? gridInterpol( row + rowSize, normalizedAngle )
+                            : val1 );
+
+         pcv[i] = ok ? ( val1 + (val2-val1) * fractionalAzimuth ) : 0.0;
+         valid[i] = ok ? 1 : 0;
+      }
+
+   }  // End of method 'Antenna::getPCVariations()'
+
+
+
+      // Compile the phase center patterns into dense grids.
+   void Antenna::buildPCVGrids()
+   {
+
+      pcvGrid.clear();
+
+      if( !( dzen > 0.0 ) || !( zen2 >= zen1 ) )
+      {
+         return;
+      }
+
+         // Values needed per row: the last zenith node may be used, and
+         // one more value is added as padding
+      const size_t nZen( static_cast<size_t>(
+                                    std::floor( (zen2 - zen1)/dzen ) ) + 1 );
+      const size_t rowSize( nZen + 1 );
+
+      std::vector<PCVGrid> grids( static_cast<size_t>(I09) + 1 );
+      bool any( false );
+
+      for( NoAziDataMap::const_iterator it = noAziMap.begin();
+           it != noAziMap.end();
+           ++it )
+      {
+         const std::vector<double>& values( (*it).second );
+         size_t i( static_cast<size_t>( (*it).first ) );
+         if( i >= grids.size() || values.size() < nZen )
+         {
+            continue;
+         }
+
+         PCVGrid& grid( grids[i] );
+         grid.rowSize = rowSize;
+         grid.noAzi.assign( values.begin(), values.begin() + nZen );
+         grid.noAzi.push_back( values[nZen-1] );
+         any = true;
+      }
+
+      for( PCDataMap::const_iterator it = pcMap.begin();
+           it != pcMap.end();
+           ++it )
+      {
+         const AzimuthDataMap& rows( (*it).second );
+         size_t i( static_cast<size_t>( (*it).first ) );
+         if( i >= grids.size() || rows.empty() || !( dazi > 0.0 ) )
+         {
+            continue;
+         }
+
+            // Row k must be at k*dazi, which is also where the previous
+            // row puts its upper neighbour
+         std::vector<double> azi;
+         azi.reserve( (rows.size() + 1) * rowSize );
+         bool regular( true );
+         double k( 0.0 );
+         for( AzimuthDataMap::const_iterator itRow = rows.begin();
+              itRow != rows.end();
+              ++itRow, k += 1.0 )
+         {
+            const std::vector<double>& values( (*itRow).second );
+            if( (*itRow).first != k * dazi ||
+                ( k > 0.0 && (*itRow).first != (k-1.0) * dazi + dazi ) ||
+                values.size() < nZen )
+            {
+               regular = false;
+               break;
+            }
+            azi.insert( azi.end(), values.begin(), values.begin() + nZen );
+            azi.push_back( values[nZen-1] );
+         }
+
+         if( !regular )
+         {
+            continue;
+         }
+
+            // Padding row
+         std::vector<double> lastRow( azi.end() - rowSize, azi.end() );
+         azi.insert( azi.end(), lastRow.begin(), lastRow.end() );
+
+         PCVGrid& grid( grids[i] );
+         grid.rowSize = rowSize;
+         grid.nAzi = rows.size();
+         grid.azi.swap( azi );
+         any = true;
+      }
+
+      if( any )
+      {
+         pcvGrid.swap( grids );
+      }
+
+   }  // End of method 'Antenna::buildPCVGrids()'
+
+
+
       /* Linear interpolation as function of normalized angle
        *
        * @param[in] dataVector         std::vector holding data.
@@ -256,6 +256,83 @@ namespace gpstk
          noexcept(false);
 
 
+         /** Get antenna eccentricity in UEN system, like
+          *  getAntennaEccentricity() but without allocating or throwing.
+          *
+          * @param[in] freq      Frequency
+          * @param[out] uen      Up, East and North eccentricity, left
+          *                      unchanged if there is none for 'freq'
+          *
+          * @return false if no eccentricities were found for 'freq'
+          */
+      bool getEccentricityUEN( frequencyType freq,
+                               double uen[3] ) const;
+
+
+         /** Get the elevation-dependent phase center variation ("Up"
+          *  component), like getAntennaPCVariation(freq, elevation) but
+          *  without allocating or throwing.
+          *
+          * @param[in] freq      Frequency
+          * @param[in] elevation Elevation (degrees)
+          * @param[out] up       Phase center variation, left unchanged
+          *                      on failure
+          *
+          * @return false if the elevation is out of range or there is
+          *         no pattern for 'freq'
+          */
+      bool getPCVariationUp( frequencyType freq,
+                             double elevation,
+                             double& up ) const;
+
+
+         /// Number of values in the non-azimuth dependent pattern of
+         /// 'freq', 0 if there is none.
+      size_t getNoAziSize( frequencyType freq ) const
+      {
+         NoAziDataMap::const_iterator it( noAziMap.find(freq) );
+         return ( it == noAziMap.end() ) ? 0 : (*it).second.size();
+      };
+
+
+         /** Get the phase center variation of 'freq' for a set of
+          *  directions at once, such as all the satellites of an epoch.
+          *
+          * The result of each direction is the one of
+          * getAntennaPCVariation(freq, elevation) when 'azimuth' is empty,
+          * or of getAntennaPCVariation(freq, elevation, azimuth) otherwise,
+          * but there are no exceptions: directions that can not be
+          * computed are flagged in 'valid'.
+          *
+          * @param[in] freq      Frequency
+          * @param[in] elevation Elevations (degrees)
+          * @param[in] azimuth   Azimuths (degrees), same size as
+          *                      'elevation', or empty
+          * @param[out] pcv      "Up" phase center variations, 0 where
+          *                      not valid
+          * @param[out] valid    1 where 'pcv' was computed, 0 otherwise
+          */
+      void getPCVariations( frequencyType freq,
+                            const std::vector<double>& elevation,
+                            const std::vector<double>& azimuth,
+                            std::vector<double>& pcv,
+                            std::vector<unsigned char>& valid ) const;
+
+
+         /** Compile the phase center patterns into dense grids, one per
+          *  frequency, with a zenith row per azimuth, so that the
+          *  variations are interpolated with plain index arithmetic
+          *  instead of map look-ups.
+          *
+          * It must be called once the patterns and the zenith/azimuth
+          * increments are set (AntexReader does it); changing any of them
+          * drops the grids, and the maps are used until it is called again.
+          * Patterns whose azimuths are not an exact multiple of the
+          * increment are left to the maps.
+          */
+      void buildPCVGrids();
+
+
          /** Get antenna data.
           *
           * @param[in] dataType     Antenna data type to be fetched
@@ -366,7 +443,7 @@ namespace gpstk
           * @param[in] daz      Increment of the azimuth
           */
       Antenna setDazi( double daz )
-      { dazi = daz; return (*this); };
+      { pcvGrid.clear(); dazi = daz; return (*this); };
 
 
          /// Get initial zenith grid value.
@@ -379,7 +456,7 @@ namespace gpstk
           * @param[in] z1      Initial zenith grid value
           */
       Antenna setZen1( double z1 )
-      { zen1 = z1; return (*this); };
+      { pcvGrid.clear(); zen1 = z1; return (*this); };
 
 
          /// Get final zenith grid value.
@@ -392,7 +469,7 @@ namespace gpstk
           * @param[in] z2      Final zenith grid value
           */
       Antenna setZen2( double z2 )
-      { zen2 = z2; return (*this); };
+      { pcvGrid.clear(); zen2 = z2; return (*this); };
 
 
          /// Get increment of the zenith.
@@ -405,7 +482,7 @@ namespace gpstk
           * @param[in] dz      Increment of the zenith
           */
       Antenna setDzen( double dz )
-      { dzen = dz; return (*this); };
+      { pcvGrid.clear(); dzen = dz; return (*this); };
 
 
          /// Get number of frequencies.
@@ -528,7 +605,7 @@ namespace gpstk
           * @param[in] naMap Antenna non-azimuth dependent patterns map, METERS.
           */
       Antenna setAntennaNoAziMap( const NoAziDataMap& naMap )
-      { noAziMap = naMap; return (*this); };
+      { pcvGrid.clear(); noAziMap = naMap; return (*this); };
 
 
          /** Add antenna non-azimuth dependent pattern, in METERS.
@@ -538,7 +615,7 @@ namespace gpstk
           */
       Antenna addAntennaNoAziPattern( frequencyType freq,
                                       const std::vector<double>& pcVec )
-      { noAziMap[freq] = pcVec; return (*this); };
+      { pcvGrid.clear(); noAziMap[freq] = pcVec; return (*this); };
 
 
          /// Get antenna azimuth dependent patterns map, in METERS.
@@ -551,7 +628,7 @@ namespace gpstk
           * @param[in] pMap Antenna azimuth dependent patterns map, METERS.
           */
       Antenna setAntennaPCMap( const PCDataMap& pMap )
-      { pcMap = pMap; return (*this); };
+      { pcvGrid.clear(); pcMap = pMap; return (*this); };
 
 
          /** Add antenna azimuth dependent pattern, in METERS.
@@ -563,7 +640,7 @@ namespace gpstk
       Antenna addAntennaPattern( frequencyType freq,
                                  double azi,
                                  const std::vector<double>& pcVec )
-      { pcMap[freq][azi] = pcVec; return (*this); };
+      { pcvGrid.clear(); pcMap[freq][azi] = pcVec; return (*this); };
 
 
          /// Get antenna non-azimuth dependent RMS map, in METERS.
@@ -688,6 +765,43 @@ namespace gpstk
       PCDataMap pcRMSMap;
 
 
+         /// Phase center patterns of a frequency on a dense grid. Rows
+         /// have a trailing copy of their last value, and the azimuth
+         /// grid a trailing copy of its last row, so that interpolation
+         /// never needs a bounds check.
+      struct PCVGrid
+      {
+         PCVGrid() : rowSize(0), nAzi(0) {};
+
+         size_t rowSize;               ///< Values per zenith row
+         size_t nAzi;                  ///< Azimuths (0 if no grid)
+         std::vector<double> noAzi;    ///< Non-azimuth dependent row
+         std::vector<double> azi;      ///< Rows at 0, dazi, 2*dazi...
+      };
+
+
+         /// Grids indexed by frequency, empty if not built
+      std::vector<PCVGrid> pcvGrid;
+
+
+         /// Grid of 'freq', or NULL
+      const PCVGrid* findPCVGrid( frequencyType freq ) const
+      {
+         size_t i( static_cast<size_t>(freq) );
+         return ( i < pcvGrid.size() ) ? &pcvGrid[i] : NULL;
+      };
+
+
+         /// Linear interpolation in a padded grid row
+      static double gridInterpol( const double* row,
+                                  double normalizedAngle )
+      {
+         double index( std::floor(normalizedAngle) );
+         const double* p( row + static_cast<size_t>(index) );
+         return ( p[0] + (p[1]-p[0]) * (normalizedAngle - index) );
+      };
+
+
          /** Linear interpolation as function of normalized angle
           *
           * @param[in] dataVector         std::vector holding data.
@@ -545,6 +545,9 @@ namespace gpstk
          antenna.setAntennaValidUntil( CommonTime::END_OF_TIME );
       }
 
+         // Patterns are complete, put them on grids
+      antenna.buildPCVGrids();
+
       return antenna;
 
    }  // End of method 'Antenna::fillAntennaData()'
@@ -1485,6 +1488,124 @@ namespace gpstk
 
 
 
+      /* Method to get the antenna of a satellite at a specific epoch,
+       * without copying it.
+       *
+       * @param serial     Antenna serial number, e.g. "G01".
+       * @param epoch      Validity epoch.
+       *
+       * @warning The antenna returned will be the first one in the Antex
+       * file that matches the conditions.
+       */
+   std::shared_ptr<const Antenna> AntexReader::getSatAntenna(
+                                                const string& serial,
+                                                const CommonTime& epoch )
+      noexcept(false)
+   {
+
+      if( !satIndexLoaded )
+      {
+         indexSatAntennas();
+      }
+
+         // Satellite codes usually come upper-cased and stripped already
+      SerialAntennaMap::const_iterator it( satAntennaIndex.find(serial) );
+      if( it == satAntennaIndex.end() )
+      {
+         it = satAntennaIndex.find( strip( upperCase( serial ) ) );
+      }
+
+      if( it != satAntennaIndex.end() )
+      {
+         for( size_t i = 0; i < (*it).second.size(); i++ )
+         {
+            const Antenna& antenna( *(*it).second[i] );
+
+               // We found the antenna if 'epoch' is between
+               // "Valid From" and "Valid Until" fields
+            if( epoch >= antenna.getAntennaValidFrom() &&
+                epoch <= antenna.getAntennaValidUntil() )
+            {
+               return (*it).second[i];
+            }
+         }
+      }
+
+      ObjectNotFound notFound("Antenna not found in Antex file.");
+      GPSTK_THROW(notFound);
+
+   }  // End of method 'AntexReader::getSatAntenna()'
+
+
+
+      // Read all the antennas with a serial number into 'satAntennaIndex'.
+   void AntexReader::indexSatAntennas(void)
+      noexcept(false)
+   {
+
+         // The index is built once, even if the file turns out to be bad
+      satIndexLoaded = true;
+      satAntennaIndex.clear();
+
+         // We need to read the data stream (file) from the beginning
+      antexStream.close();
+      antexStream.open( fileName.c_str(), std::ios::in );
+
+      try
+      {
+
+         std::string line;
+         while( getline(antexStream, line) )
+         {
+
+            if( line.size() < 61 ||
+                strip( line.substr(60,20) ) != typeSerial )
+            {
+               continue;
+            }
+
+               // Receiver antennas have no serial number
+            const string uSerial( strip( line.substr(20,20) ) );
+            if( uSerial.empty() )
+            {
+               continue;
+            }
+
+            try
+            {
+               std::shared_ptr<const Antenna> antenna(
+                                       new Antenna( fillAntennaData(line) ) );
+               satAntennaIndex[uSerial].push_back(antenna);
+            }
+            catch( InvalidAntex& ia )
+            {
+                  // Skip this antenna, 'fillAntennaData()' stopped inside
+                  // it and the scan goes on to the next one
+            }
+
+         }  // End of 'while( getline(antexStream, line) )'
+
+      }  // End of try block
+      catch( EndOfFile& e )
+      {
+            // Antenna cut by the end of the file
+      }
+      catch(...)
+      {
+            // We need to close this data stream
+         antexStream.close();
+
+         InvalidAntex ia("Unknown error when reading Antex file.");
+         GPSTK_THROW(ia);
+      }
+
+         // We need to close this data stream
+      antexStream.close();
+
+   }  // End of method 'AntexReader::indexSatAntennas()'
+
+
+
       // Method to open and load Antex file header data.
    void AntexReader::open(const char* fn)
    {
@@ -1507,6 +1628,8 @@ namespace gpstk
 
          // We must be sure that previous antenna data is cleared.
       antennaMap.clear();
+      satAntennaIndex.clear();
+      satIndexLoaded = false;
       version = 0.0;
       refAntena = "";
       refAntenaSerial = "";
@@ -1541,6 +1664,8 @@ namespace gpstk
 
          // We must be sure that previous antenna data is cleared.
       antennaMap.clear();
+      satAntennaIndex.clear();
+      satIndexLoaded = false;
       version = 0.0;
       refAntena = "";
       refAntenaSerial = "";
@@ -33,6 +33,8 @@
 
 #include <string>
 #include <map>
+#include <vector>
+#include <memory>
 
 #include "Exception.hpp"
 #include "StringUtils.hpp"
@@ -157,7 +159,7 @@ namespace gpstk
 
          /// Default constructor
       AntexReader()
-         : fileName(""), version(1.3), valid(false)
+         : fileName(""), satIndexLoaded(false), version(1.3), valid(false)
       {};
 
 
@@ -255,6 +257,28 @@ namespace gpstk
          noexcept(false);
 
 
+         /** Method to get the antenna of a satellite at a specific epoch,
+          *  as getAntenna(serial, epoch) does, without copying it.
+          *
+          * The first call reads all the antennas with a serial number
+          * (satellite code) in the Antex file into an index by serial
+          * and validity interval; the following calls only look them up
+          * in that index, and the file is not read again.
+          *
+          * @param serial     Antenna serial number, e.g. "G01".
+          * @param epoch      Validity epoch.
+          *
+          * @return Shared pointer to the immutable antenna.
+          *
+          * @warning The antenna returned will be the first one in the Antex
+          * file that matches the conditions.
+          */
+      virtual std::shared_ptr<const Antenna> getSatAntenna(
+                                              const std::string& serial,
+                                              const CommonTime& epoch )
+         noexcept(false);
+
+
          /// Returns if this object is valid.
       bool isValid() const
       { return valid; };
@@ -307,6 +331,18 @@ namespace gpstk
       AntennaDataMap antennaMap;
 
 
+         // Serial:Antennas, in file order
+      typedef std::map< std::string,
+                        std::vector< std::shared_ptr<const Antenna> > >
+                                                            SerialAntennaMap;
+
+         /// Index of the antennas with a serial number, for getSatAntenna()
+      SerialAntennaMap satAntennaIndex;
+
+         /// Whether 'satAntennaIndex' was read from the file
+      bool satIndexLoaded;
+
+
          /// Antex file version
       double version;
 
@@ -343,6 +379,12 @@ namespace gpstk
          noexcept(false);
 
 
+         /// Read all the antennas with a serial number into
+         /// 'satAntennaIndex'.
+      void indexSatAntennas(void)
+         noexcept(false);
+
+
    }; // End of class 'AntexReader'
 
 
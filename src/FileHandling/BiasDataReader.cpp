@@ -246,7 +246,7 @@ namespace gpstk
     double BiasDataReader::getSatBias( const RinexSatID/*SatID*/& sat,
                                        const std::string& type1,
                                        const std::string& type2,
-                                       const CommonTime& time )
+                                       const CommonTime& time ) const
     {
         double ret(0.0);
 
@@ -262,7 +262,7 @@ namespace gpstk
             index += type2;
             index += string(1,' ');
 
-            multimap<string,BiasData>::iterator it=satBiasData.find(index);
+            multimap<string,BiasData>::const_iterator it=satBiasData.find(index);
             if(it==satBiasData.end())
             {
                 /*Exception e("type not found in satBiasData!");*/
@@ -270,10 +270,10 @@ namespace gpstk
 				//GPS     C1C - C2W, C1C - C5Q, C1C - C5X, C1W - C2W
             }
 
-            multimap<string,BiasData>::iterator beg( satBiasData.lower_bound(index) );
-            multimap<string,BiasData>::iterator end( satBiasData.upper_bound(index) );
+            multimap<string,BiasData>::const_iterator beg( satBiasData.lower_bound(index) );
+            multimap<string,BiasData>::const_iterator end( satBiasData.upper_bound(index) );
 
-            for(multimap<string,BiasData>::iterator it = beg;
+            for(multimap<string,BiasData>::const_iterator it = beg;
                 it != end;
                 ++it)
             {
@@ -303,16 +303,16 @@ namespace gpstk
             index1 += string(3,' ');
             index1 += string(1,' ');
 
-            multimap<string,BiasData>::iterator it=satBiasData.find(index1);
+            multimap<string,BiasData>::const_iterator it=satBiasData.find(index1);
             if(it==satBiasData.end())
             {
                 Exception e("type not found in satBiasData!");
             }
 
-            multimap<string,BiasData>::iterator beg1( satBiasData.lower_bound(index1) );
-            multimap<string,BiasData>::iterator end1( satBiasData.upper_bound(index1) );
+            multimap<string,BiasData>::const_iterator beg1( satBiasData.lower_bound(index1) );
+            multimap<string,BiasData>::const_iterator end1( satBiasData.upper_bound(index1) );
 
-            for(multimap<string,BiasData>::iterator it = beg1;
+            for(multimap<string,BiasData>::const_iterator it = beg1;
                 it != end1;
                 ++it)
             {
@@ -350,7 +350,7 @@ namespace gpstk
 	/// <param name="time">current epoch</param>
 	/// <returns></returns>
 	std::map<std::string, double> BiasDataReader::getSatDCB(const RinexSatID sat,
-		const std::vector<std::string>& typeVec, const CommonTime& time, const bool bdsfopt)
+		const std::vector<std::string>& typeVec, const CommonTime& time, const bool bdsfopt) const
     {
         // dcbData
         std::map<std::string, double> dcbDataMap;
@@ -360,7 +360,7 @@ namespace gpstk
         SatelliteSystem sys(sat.system);
         std::string satStr = sat.toString();
 
-        multimap<string, BiasData>::iterator it;
+        multimap<string, BiasData>::const_iterator it;
         try
         {
 			if (sys == SatelliteSystem::GPS)
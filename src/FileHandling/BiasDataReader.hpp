@@ -71,10 +71,10 @@ namespace gpstk
         double getSatBias(const RinexSatID/*SatID*/& sat,
                            const std::string& type1,
                            const std::string& type2,
-                           const CommonTime& time );
+                           const CommonTime& time ) const;
 
         std::map<std::string, double> getSatDCB(const RinexSatID sat,
-            const std::vector<std::string>& typeVec, const CommonTime& time, const bool bdsfopt);
+            const std::vector<std::string>& typeVec, const CommonTime& time, const bool bdsfopt) const;
 
 
         /// Destructor
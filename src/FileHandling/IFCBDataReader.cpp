@@ -93,7 +93,7 @@ namespace fippp
 		}
 	}
 
-	double IFCBDataReader::getSatIFCB(const RinexSatID& sat, const CommonTime& ttag, const int nhalf)
+	double IFCBDataReader::getSatIFCB(const RinexSatID& sat, const CommonTime& ttag, const int nhalf) const
 	{
 		double ifcb;
 		try
@@ -42,7 +42,7 @@ namespace fippp
 		void open(const char* fn);
 		void open(const std::string& fn);
 
-		double getSatIFCB(const RinexSatID& sat, const CommonTime& ttag, const int nhalf);
+		double getSatIFCB(const RinexSatID& sat, const CommonTime& ttag, const int nhalf) const;
 
 		~IFCBDataReader() {};
 
@@ -0,0 +1,229 @@
+#pragma ident "$ID: ragn wang 2023-06 $"
+
+#include "ProductStore.hpp"
+#include "YDSTime.hpp"
+
+#define debug 1
+
+using namespace std;
+
+namespace fippp
+{
+	/// <summary>
+	/// key of the product set: the day and all the file names
+	/// </summary>
+	std::string ProductStore::ProductFiles::key() const
+	{
+		YDSTime ydt(epoch);
+		std::string k = std::to_string(ydt.year) + "-" +
+			std::to_string(ydt.doy) + ";" + ephFile + ";" + biasFile;
+
+		for (auto f : sp3Files)		k += ";" + f;
+		for (auto f : clkFiles)		k += ";" + f;
+		for (auto f : erpFiles)		k += ";" + f;
+		for (auto f : ifcbFiles)	k += ";" + f;
+		for (auto it = updFiles.begin(); it != updFiles.end(); ++it)
+			k += ";" + it->second;
+
+		return k;
+	}
+
+	ProductStore::ProductStore()
+	{
+		brdcEph.SearchNear();
+		sp3Store.rejectBadPositions(true);
+		sp3Store.rejectBadClocks(true);
+	}
+
+	/// <summary>
+	/// load the broadcast ephemeris, the bias file and, if not SPP,
+	/// the precise products of the day
+	/// </summary>
+	/// <param name="files"> product files </param>
+	/// <param name="opts"> config options </param>
+	void ProductStore::load(const ProductFiles& files,
+		const Options::options_t& opts)
+		noexcept(false)
+	{
+		// read ephFile
+		try
+		{
+			if (debug)
+			{
+				std::cout << "Broadcast ephemeris file: " << files.ephFile << endl;
+			}
+			brdcEph.loadFile(files.ephFile);
+		}
+		catch (Exception& e)
+		{
+			cerr << e.getLocation();
+			cerr << " cannot read: " << files.ephFile << endl;
+			GPSTK_THROW(e);
+		}
+		// read bias file
+		try
+		{
+			if (opts.obsCorr)
+				biasReader.open(files.biasFile);
+			if (debug)
+				std::cout << "biasReader:" << files.biasFile << endl;
+		}
+		catch (Exception e)
+		{
+			std::cerr << e << endl;
+			std::cerr << "unknown error in read erp file" << endl;
+			std::exit(-1);
+		}
+
+		// read precise files.
+		if (opts.mode == Options::SPP)
+			return;
+
+		// sp3/clk files loaded before are read from their binary copy
+		sp3Store.setCacheDirectory(opts.productCache);
+
+		try
+		{
+			// read sp3file
+			for (auto f : files.sp3Files)
+			{
+				if (debug)
+					std::cout << "sp3 file:" << f << endl;
+				try
+				{
+					sp3Store.loadSP3File(f);
+				}
+				catch (Exception& e)
+				{
+					std::cerr << e << endl;
+					std::cerr << "unknown error in read sp3 data" << endl;
+					std::exit(-1);
+				}
+			}
+			// read clk file
+			for (auto f : files.clkFiles)
+			{
+				if (debug)
+					std::cout << "clk file:" << f << endl;
+				try
+				{
+					sp3Store.loadRinexClockFile(f);
+					if (opts.ambFixMode &&
+						opts.ambProduct == Options::IRC)
+					{
+						updReader.loadIRCWL(f, files.epoch);
+					}
+				}
+				catch (Exception& e)
+				{
+					std::cerr << e << endl;
+					std::cerr << "unknown error in read clk file" << endl;
+					std::exit(-1);
+				}
+			}
+			// check IRC
+			if (opts.ambFixMode &&
+				opts.ambProduct == Options::IRC &&
+				(!updReader.checkWLData()))
+			{
+				std::cout << "unknown error in loading IRC Product WL data!" << std::endl;
+				exit(-1);
+			}
+
+			// read erp file
+			for (auto f : files.erpFiles)
+			{
+				try
+				{
+					if (debug)
+					{
+						std::cout << "erp file:" << f << endl;
+					}
+					erpStore.loadIGSFile(f);
+				}
+				catch (Exception e)
+				{
+					std::cerr << e << endl;
+					std::cerr << "unknown error in read erp file" << endl;
+					std::exit(-1);
+				}
+			}
+			// read ifcb file
+			if (opts.ifcbCorr)
+			{
+				try
+				{
+					for (auto f : files.ifcbFiles)
+					{
+						if (debug)
+							std::cout << "ifcb file:" << f << endl;
+						ifcbReader.open(f);
+					}
+				}
+				catch (Exception e)
+				{
+					std::cerr << e << endl;
+					std::cerr << "unknown error in read ifcb file" << endl;
+					std::exit(-1);
+				}
+			}
+			//read upd
+			if (opts.ambFixMode && opts.ambProduct == Options::UPD)
+			{
+				try
+				{
+					updReader.loadFile(files.updFiles);
+				}
+				catch (Exception& e)
+				{
+					cerr << e.what() << endl;
+					GPSTK_THROW(e);
+				}
+
+			}	// End of read upd files
+
+		}
+		catch (Exception e)
+		{
+			std::cerr << e << std::endl;
+		}
+		// end of load file data
+
+	}	// End of method 'ProductStore::load()'
+
+	/// <summary>
+	/// get the product store of the given files. Stores that are not
+	/// used by any station are dropped when a new day is loaded.
+	/// </summary>
+	std::shared_ptr<const ProductStore> ProductCache::get(
+		const ProductStore::ProductFiles& files,
+		const Options::options_t& opts)
+		noexcept(false)
+	{
+		std::string key(files.key());
+
+		// loading is done under the lock, stations of the same day
+		// wait for the first one to finish parsing the products.
+		std::lock_guard<std::mutex> lock(cacheMutex);
+
+		auto it = storeMap.find(key);
+		if (it != storeMap.end())
+			return it->second;
+
+		// release the days no station is processing any more
+		for (auto itStore = storeMap.begin(); itStore != storeMap.end();)
+		{
+			if (itStore->second.use_count() == 1)
+				itStore = storeMap.erase(itStore);
+			else
+				++itStore;
+		}
+
+		std::shared_ptr<ProductStore> store(new ProductStore());
+		store->load(files, opts);
+		storeMap[key] = store;
+
+		return store;
+
+	}	// End of method 'ProductCache::get()'
+}
@@ -0,0 +1,122 @@
+#pragma ident "$ID: ragn wang 2023-06 $"
+
+#ifndef FiPPP_ProductStore_HPP
+#define FiPPP_ProductStore_HPP
+
+// Product store holds the broadcast and precise products of one
+// processing day. It is loaded once and then only handed out as a
+// const object, so all the stations of the same day (and the worker
+// threads processing them) share it instead of parsing the product
+// files again for every station.
+//
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "Exception.hpp"
+#include "CommonTime.hpp"
+#include "TypeID.hpp"
+#include "Rinex3EphemerisStore.hpp"
+#include "SP3EphemerisStore.hpp"
+#include "EOPDataStore.hpp"
+#include "BiasDataReader.hpp"
+#include "IFCBDataReader.hpp"
+#include "UPDDataReader.hpp"
+#include "AboutOptions.hpp"
+
+using namespace gpstk;
+
+namespace fippp
+{
+	class ProductStore
+	{
+	public:
+
+		/// product files of one processing day
+		struct ProductFiles
+		{
+			// first observation epoch, selects the day
+			CommonTime epoch;
+
+			std::string ephFile;
+			std::string biasFile;
+			std::vector<std::string> sp3Files;
+			std::vector<std::string> clkFiles;
+			std::vector<std::string> erpFiles;
+			std::vector<std::string> ifcbFiles;
+			std::map<TypeID, std::string> updFiles;
+
+			/// key identifying the day and the product set
+			std::string key() const;
+		};
+
+		// default constructor
+		ProductStore();
+
+		/// load all the products required by the options
+		void load(const ProductFiles& files,
+			const Options::options_t& opts)
+			noexcept(false);
+
+		const Rinex3EphemerisStore& getBrdcEph() const
+		{ return brdcEph; }
+
+		const SP3EphemerisStore& getSP3Store() const
+		{ return sp3Store; }
+
+		const EOPDataStore& getERPStore() const
+		{ return erpStore; }
+
+		const BiasDataReader& getBiasReader() const
+		{ return biasReader; }
+
+		const IFCBDataReader& getIFCBReader() const
+		{ return ifcbReader; }
+
+		const UPDDataReader& getUPDReader() const
+		{ return updReader; }
+
+		~ProductStore() {};
+
+	private:
+
+		Rinex3EphemerisStore brdcEph;
+		SP3EphemerisStore sp3Store;
+		EOPDataStore erpStore;
+		BiasDataReader biasReader;
+		IFCBDataReader ifcbReader;
+		UPDDataReader updReader;
+
+		// the stores keep file streams, no copy
+		ProductStore(const ProductStore&);
+		ProductStore& operator=(const ProductStore&);
+	};
+
+	/// Keeps the product stores of the days being processed, so every
+	/// product set is parsed only once per run. A store is released
+	/// as soon as no station uses it any more and another day is loaded.
+	class ProductCache
+	{
+	public:
+
+		ProductCache() {};
+
+		/// get the store of the given product set, loading it if needed
+		std::shared_ptr<const ProductStore> get(
+			const ProductStore::ProductFiles& files,
+			const Options::options_t& opts)
+			noexcept(false);
+
+		~ProductCache() {};
+
+	private:
+
+		std::mutex cacheMutex;
+
+		std::map<std::string, std::shared_ptr<const ProductStore> > storeMap;
+	};
+}
+
+#endif // !FiPPP_ProductStore_HPP
@@ -379,7 +379,7 @@ namespace gpstk
    
    void reallyGetRecordVer2(Rinex3ObsStream& strm, Rinex3ObsData& rod)
    {
-      static CommonTime previousTime(CommonTime::BEGINNING_OF_TIME);
+      static thread_local CommonTime previousTime(CommonTime::BEGINNING_OF_TIME);
 
          // get the epoch line and check
       string line;
@@ -597,6 +597,13 @@ namespace gpstk
          // If the header hasn't been read, read it.
       if(!strm.headerRead) strm >> strm.header;
 
+         // the epoch is parsed in place from the memory copy
+      if(strm.getFastRead() && strm.header.version >= 3)
+      {
+         reallyGetRecordFast(strm);
+         return;
+      }
+
       Rinex3ObsData rod;
 
          // clear out this ObsData
@@ -727,6 +734,134 @@ namespace gpstk
    } // end of reallyGetRecord()
 
 
+   void Rinex3ObsData::reallyGetRecordFast(Rinex3ObsStream& strm)
+   {
+         // clear out this ObsData, the header part only if it was used
+      time = CommonTime::BEGINNING_OF_TIME;
+      epochFlag = -1;
+      numSVs = -1;
+      clockOffset = 0.0;
+      obs.clear();
+      if(!auxHeader.valid.empty() || !auxHeader.commentList.empty())
+         auxHeader.clear();
+
+         // a bad record is read again, like the stream position is
+         // reset by tryFFStreamGet()
+      const string::size_type startPos = strm.bufferPosition();
+      const unsigned long startLine = strm.lineNumber;
+
+      try
+      {
+         const char* buf;
+         string::size_type len;
+
+            // read the first (epoch) line, a few fields only so
+            // reuse the string parsers
+         strm.bufferedGetLine(buf, len, true);
+         while(len > 0 && buf[len-1] == ' ')
+            len--;
+         string line(buf, len);
+
+         if(line[0] != '>' || line[1] != ' ')
+         {
+            FFStreamError e("Bad epoch line: >" + line + "<");
+            GPSTK_THROW(e);
+         }
+
+         epochFlag = asInt(line.substr(31,1));
+         if(epochFlag < 0 || epochFlag > 6)
+         {
+            FFStreamError e("Invalid epoch flag: " + asString(epochFlag));
+            GPSTK_THROW(e);
+         }
+
+         time = parseTime(line, strm.header, strm.timesystem);
+
+         numSVs = asInt(line.substr(32,3));
+
+         if(line.size() > 41)
+            clockOffset = asDouble(line.substr(41,15));
+         else
+            clockOffset = 0.0;
+
+            // Read the observations: SV ID and data, parsed in place
+         if(epochFlag == 0 || epochFlag == 1 || epochFlag == 6)
+         {
+               // number of observations of each system
+            int numObs[128];
+            std::fill(numObs, numObs + 128, -1);
+
+            for(int isv = 0; isv < numSVs; isv++)
+            {
+               strm.bufferedGetLine(buf, len);
+
+               RinexSatID sat;
+               try
+               {
+                  sat = RinexSatID(string(buf, (len < 3) ? len : 3));
+               }
+               catch (Exception& e)
+               {
+                  FFStreamError ffse(e);
+                  GPSTK_THROW(ffse);
+               }
+
+               const unsigned char sys =
+                  static_cast<unsigned char>(sat.systemChar()) & 0x7f;
+               if(numObs[sys] < 0)
+               {
+                  numObs[sys] =
+                     strm.header.mapObsTypes[asString(sat.systemChar())].size();
+               }
+               const int size = numObs[sys];
+
+                  // missing trailing observations are read as blanks
+               vector<RinexDatum>& data = obs[sat];
+               data.resize(size);
+               for(int i = 0; i < size; i++)
+               {
+                  const string::size_type pos = 3 + 16*i;
+                  if(pos < len)
+                     data[i].fromChars(buf + pos, len - pos);
+                  else
+                     data[i].fromChars(buf, 0);
+               }
+            }
+         }
+
+            // ... or the auxiliary header information
+         else if(numSVs > 0)
+         {
+            auxHeader.clear();
+            for(int i = 0; i < numSVs; i++)
+            {
+               strm.bufferedGetLine(buf, len);
+               line.assign(buf, len);
+               StringUtils::stripTrailing(line);
+               auxHeader.parseHeaderRecord(line);
+            }
+         }
+      }
+      catch(EndOfFile& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+      catch(Exception& e)
+      {
+         strm.bufferSeek(startPos);
+         strm.lineNumber = startLine;
+         GPSTK_RETHROW(e);
+      }
+      catch(std::exception& e)
+      {
+         strm.bufferSeek(startPos);
+         strm.lineNumber = startLine;
+         throw;
+      }
+
+   }  // end of reallyGetRecordFast()
+
+
    CommonTime Rinex3ObsData::parseTime(const string& line,
                                        const Rinex3ObsHeader& hdr,
                                        const TimeSystem& ts) const
@@ -56,6 +56,7 @@
 
 namespace gpstk
 {
+   class Rinex3ObsStream;
 
       /// @ingroup FileHandling
       //@{
@@ -232,6 +233,16 @@ namespace gpstk
                             const TimeSystem& ts) const;
 
 
+         /** Read a RINEX 3 record from the memory copy of the stream,
+          * see Rinex3ObsStream::setFastRead().  Same results and errors
+          * as the line by line reading.
+          *
+          * @throw FFStreamError
+          * @throw EndOfFile
+          */
+      void reallyGetRecordFast(Rinex3ObsStream& strm);
+
+
    }; // End of class 'Rinex3ObsData'
 
       //@}
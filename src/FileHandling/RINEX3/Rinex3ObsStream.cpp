@@ -41,6 +41,9 @@
  * File stream for RINEX 3 observation file data.
  */
 
+#include <algorithm>
+#include <cctype>
+
 #include "Rinex3ObsStream.hpp"
 
 namespace gpstk
@@ -81,6 +84,9 @@ namespace gpstk
          std::ios::openmode mode )
    {
       FFTextStream::open(fn, mode);
+      bufferLoaded = false;
+      readBuffer.clear();
+      readPos = 0;
    }
 
 
@@ -90,6 +96,99 @@ namespace gpstk
       headerRead = false;
       header = Rinex3ObsHeader();
       timesystem = TimeSystem::GPS;
+      fastRead = false;
+      bufferLoaded = false;
+      readBuffer.clear();
+      readPos = 0;
+   }
+
+
+   void Rinex3ObsStream ::
+   loadBuffer()
+   {
+      bufferLoaded = true;
+      readBuffer.clear();
+      readPos = 0;
+
+         // one read for the whole body of the file
+      std::streampos start = tellg();
+      if (start < 0)
+      {
+         clear();
+         return;
+      }
+      seekg(0, std::ios::end);
+      std::streampos end = tellg();
+      seekg(start);
+      if (end > start)
+      {
+         readBuffer.resize(static_cast<size_t>(end - start));
+         read(&readBuffer[0], readBuffer.size());
+            // text mode may drop CR characters
+         readBuffer.resize(static_cast<size_t>(gcount()));
+      }
+
+         // leave the stream at the end, the records come from the buffer
+      clear();
+      seekg(0, std::ios::end);
+   }
+
+
+   void Rinex3ObsStream ::
+   bufferedGetLine( const char*& line,
+                    std::string::size_type& len,
+                    const bool expectEOF )
+   {
+      if (!bufferLoaded)
+         loadBuffer();
+
+      if (readPos >= readBuffer.size())
+      {
+         line = 0;
+         len = 0;
+         lineNumber++;
+            // same state as std::getline at the end of file
+         try
+         {
+            setstate(std::ios::eofbit | std::ios::failbit);
+         }
+         catch (std::exception&)
+         {
+         }
+         if (expectEOF)
+         {
+            EndOfFile err("EOF encountered");
+            GPSTK_THROW(err);
+         }
+         else
+         {
+            FFStreamError err("Unexpected EOF encountered");
+            GPSTK_THROW(err);
+         }
+      }
+
+      const char* begin = &readBuffer[0] + readPos;
+      const char* bufEnd = &readBuffer[0] + readBuffer.size();
+      const char* end = std::find(begin, bufEnd, '\n');
+
+      readPos = (end - &readBuffer[0]) + ((end == bufEnd) ? 0 : 1);
+
+         // Remove CR characters left over from windows files
+      while (end > begin && end[-1] == '\r')
+         end--;
+
+      for (const char* p = begin; p != end; p++)
+      {
+         if (!isprint(*p))
+         {
+            FFStreamError err("Non-text data in file.");
+            GPSTK_THROW(err);
+         }
+      }
+
+      lineNumber++;
+      line = begin;
+      len = end - begin;
    }
 
 
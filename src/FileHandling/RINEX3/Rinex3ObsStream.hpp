@@ -115,9 +115,61 @@ namespace gpstk
          /// Check if the input stream is the kind of Rinex3ObsStream
       static bool isRinex3ObsStream(std::istream& i);
 
+         /** Read the RINEX 3 observation records from a copy of the
+          * file in memory, parsing the fields in place, instead of line
+          * by line through the stream.  The records read are the same.
+          * Set it before reading the first observation record.
+          *
+          * @param fast  true to read from the memory copy.
+          */
+      void setFastRead(bool fast)
+      { fastRead = fast; }
+
+         /// Whether the records are read from the memory copy
+      bool getFastRead() const
+      { return fastRead; }
+
+         /** Get the next line of the memory copy, without the end of
+          * line characters.  The first call loads the rest of the file.
+          * Same checks, errors and line counting as formattedGetLine().
+          *
+          * @param[out] line  start of the line, valid until the stream
+          *   is closed or opened again.
+          * @param[out] len   number of characters of the line.
+          * @param[in] expectEOF  see formattedGetLine().
+          * @throw EndOfFile if \a expectEOF and the end of file is reached
+          * @throw FFStreamError for non-text data or unexpected EOF
+          */
+      void bufferedGetLine( const char*& line,
+                            std::string::size_type& len,
+                            const bool expectEOF = false );
+
+         /// Position of the next line in the memory copy
+      std::string::size_type bufferPosition() const
+      { return readPos; }
+
+         /// Go back to a position returned by bufferPosition()
+      void bufferSeek(std::string::size_type pos)
+      { readPos = pos; }
+
    private:
          /// Initialize internal data structures.
       void init();
+
+         /// Copy the rest of the file into 'readBuffer'
+      void loadBuffer();
+
+         /// Read the records from the memory copy
+      bool fastRead;
+
+         /// Whether 'readBuffer' holds the rest of the file
+      bool bufferLoaded;
+
+         /// Memory copy of the file after the header
+      std::vector<char> readBuffer;
+
+         /// Position of the next line in 'readBuffer'
+      std::string::size_type readPos;
    }; // class 'Rinex3ObsStream'
 
       //@}
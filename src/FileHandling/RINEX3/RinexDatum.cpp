@@ -103,6 +103,46 @@ namespace gpstk
    }
 
 
+   void RinexDatum ::
+   fromChars(const char* str, std::string::size_type len)
+   {
+      const std::string::size_type dataLen = (len < 14) ? len : 14;
+      std::string::size_type i = 0;
+      while (i < dataLen && str[i] == ' ')
+         i++;
+      if (i == dataLen)
+      {
+         data = 0.;
+         dataBlank = true;
+      }
+      else
+      {
+         data = StringUtils::asDouble(str, dataLen);
+         dataBlank = false;
+      }
+      if (len <= 14 || str[14] == ' ')
+      {
+         lli = 0.;
+         lliBlank = true;
+      }
+      else
+      {
+         lli = StringUtils::asInt(str + 14, 1);
+         lliBlank = false;
+      }
+      if (len <= 15 || str[15] == ' ')
+      {
+         ssi = 0.;
+         ssiBlank = true;
+      }
+      else
+      {
+         ssi = StringUtils::asInt(str + 15, 1);
+         ssiBlank = false;
+      }
+   }
+
+
    std::string RinexDatum ::
    asString() const
    {
@@ -70,6 +70,14 @@ namespace gpstk
           * @throw AssertionFailure if str.length() != 16 */
       void fromString(const std::string& str);
 
+         /** Parse a RINEX OBS datum directly from a line buffer, without
+          * building any string. Characters past \a len are taken as
+          * blanks, as RINEX 3 lets receivers drop trailing blank fields.
+          * @param[in] str start of the datum field.
+          * @param[in] len number of characters available, only the
+          *   first 16 are used. */
+      void fromChars(const char* str, std::string::size_type len);
+
          /// Turn this datum into a RINEX OBS formatted string
       std::string asString() const;
 
@@ -277,7 +277,7 @@ namespace fippp
 	}	// End of load NL
 
 	double UPDDataReader::getSatUPD(const SatID& sat,
-		const TypeID& type,	const CommonTime& epoch)
+		const TypeID& type,	const CommonTime& epoch) const
 		noexcept(false)
 	{
 		try
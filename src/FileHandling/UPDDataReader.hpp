@@ -120,7 +120,7 @@ namespace fippp
 
         double getSatUPD(const SatID& sat,
             const TypeID& type,
-            const CommonTime& time)
+            const CommonTime& time) const
             noexcept(false);
 
         double getValue(epochValueMap& epochValueData,
@@ -128,7 +128,7 @@ namespace fippp
             return 0.;
         };
 
-        bool checkWLData()
+        bool checkWLData() const
         {
             return updWLData.size();
         }
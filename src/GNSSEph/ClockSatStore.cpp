@@ -192,6 +192,55 @@ namespace gpstk
       catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
    }
 
+   // Return the clock bias and drift for the given satellite at the given
+   // time, keeping the interpolation segment of the satellite in seg.
+   // @throw InvalidRequest as getValue()
+   void ClockSatStore::getBiasDrift(const SatID& sat, const CommonTime& ttag,
+                                    TabularSegment& seg, double& bias,
+                                    double& drift) const
+   {
+      try {
+         checkTimeSystem(ttag.getTimeSystem());
+
+         if(!seg.contains(ttag)) {
+            DataTableIterator it1, it2, kt;
+
+            // exact matches keep the original path
+            if(getTableInterval(sat, ttag, Nhalf, it1, it2, true)) {
+               ClockRecord rec(getValue(sat, ttag));
+               bias = rec.bias;
+               drift = rec.drift;
+               return;
+            }
+
+            // store the 2*Nhalf points, drifts if present
+            const size_t nc(haveClockDrift ? 2 : 1);
+            seg.resize(2*Nhalf, nc);
+            seg.ttag0 = it1->first;
+            size_t n(0);
+            for(kt = it1; ; ++kt, ++n) {
+               if(n == Nhalf-1) seg.lo = kt->first;
+               if(n == Nhalf) seg.hi = kt->first;
+               seg.times[n] = kt->first - seg.ttag0;       // sec
+               seg.value(0,n) = kt->second.bias;
+               if(haveClockDrift) seg.value(1,n) = kt->second.drift;
+               if(kt == it2) break;
+            }
+            seg.computeWeights();
+         }
+
+         // Lagrange interpolation; with two points (interpType 1) it is
+         // the linear interpolation
+         seg.basis(ttag - seg.ttag0, !haveClockDrift);
+         bias = seg.interpolate(0);                            // sec
+         if(haveClockDrift)
+            drift = seg.interpolate(1);                        // sec/sec
+         else
+            drift = seg.derivative(0);                         // sec/sec
+      }
+      catch(InvalidRequest& e) { seg.clear(); GPSTK_RETHROW(e); }
+   }
+
    // Return the clock bias for the given satellite at the given time
    // @param[in] sat the SatID of the satellite of interest
    // @param[in] ttag the time (CommonTime) of interest
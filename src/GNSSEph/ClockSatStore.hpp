@@ -156,6 +156,20 @@ namespace gpstk
       virtual ClockRecord getValue(const SatID& sat, const CommonTime& ttag)
          const;
 
+         /** Return the clock bias and drift for the given satellite at
+          * the given time, same values as getValue().bias and drift.
+          * The interpolation segment of the satellite is kept in seg:
+          * the table is only searched when ttag leaves its interval.
+          * @param[in] sat the SatID of the satellite of interest
+          * @param[in] ttag the time (CommonTime) of interest
+          * @param[in,out] seg segment of this satellite, empty at first
+          * @param[out] bias the clock bias
+          * @param[out] drift the clock drift
+          * @throw InvalidRequest as getValue() */
+      void getBiasDrift(const SatID& sat, const CommonTime& ttag,
+                        TabularSegment& seg, double& bias, double& drift)
+         const;
+
          /** Return the clock bias for the given satellite at the given time
           * @param[in] sat the SatID of the satellite of interest
           * @param[in] ttag the time (CommonTime) of interest
@@ -0,0 +1,425 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//==============================================================================
+
+/** @file EpochTable.hpp
+ * Time-ordered table of records of one satellite, stored in a flat
+ * array indexed by epoch number. */
+
+#ifndef GPSTK_EPOCH_TABLE_INCLUDE
+#define GPSTK_EPOCH_TABLE_INCLUDE
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "CommonTime.hpp"
+
+namespace gpstk
+{
+      /// @ingroup GNSSEph
+      //@{
+
+      /** Table of DataRecord vs time, used by TabularSatStore in place of
+       * std::map<CommonTime, DataRecord>, with the part of the map
+       * interface that the stores use (find, lower_bound, upper_bound,
+       * operator[], range erase and bidirectional iteration, where
+       * it->first is the time and it->second the record).
+       *
+       * Tabular products come on a regular grid, so the records are kept
+       * in a vector with one slot per nominal epoch: slot n holds the
+       * record at origin + (base+n)*step, and a bitmap flags the slots
+       * that hold data. A time is located by dividing its distance to the
+       * origin by the step, with no search, and the times themselves are
+       * not stored. The step is taken from the first two epochs added.
+       *
+       * A record is put on the grid only when origin + (base+n)*step
+       * reproduces its time exactly, so the table finds exactly the keys
+       * a map would. When a time does not fall on the grid, or when a gap
+       * would waste too many slots, the table turns into a time-sorted
+       * vector of (time, record), located by binary search. */
+   template <class DataRecord>
+   class EpochTable
+   {
+   public:
+
+         /// Entry seen through an iterator, as the value_type of a map
+      struct Entry
+      {
+         Entry(const CommonTime& t, const DataRecord& r)
+            : first(t), second(r)
+         {}
+
+         const CommonTime first;
+         const DataRecord& second;
+      };
+
+         /// Iterator over the records in time order. Records are modified
+         /// only through operator[], so both iterator types are the same.
+      class const_iterator
+      {
+      public:
+
+            /// Holds the Entry for operator->()
+         struct Arrow
+         {
+            const Entry* operator->() const
+            { return &entry; }
+
+            Entry entry;
+         };
+
+         const_iterator()
+            : table(0), slot(0)
+         {}
+
+         Entry operator*() const
+         { return Entry(table->timeAt(slot), table->records[slot]); }
+
+         Arrow operator->() const
+         {
+            Arrow a = { Entry(table->timeAt(slot), table->records[slot]) };
+            return a;
+         }
+
+         const_iterator& operator++()
+         {
+            do { ++slot; }
+            while(slot < table->records.size() && !table->hasData(slot));
+            return *this;
+         }
+
+         const_iterator operator++(int)
+         { const_iterator tmp(*this); ++(*this); return tmp; }
+
+         const_iterator& operator--()
+         {
+            do { --slot; }
+            while(slot > 0 && !table->hasData(slot));
+            return *this;
+         }
+
+         const_iterator operator--(int)
+         { const_iterator tmp(*this); --(*this); return tmp; }
+
+         bool operator==(const const_iterator& right) const
+         { return (table == right.table && slot == right.slot); }
+
+         bool operator!=(const const_iterator& right) const
+         { return !(*this == right); }
+
+      private:
+
+         friend class EpochTable;
+
+         const_iterator(const EpochTable* t, size_t s)
+            : table(t), slot(s)
+         {}
+
+         const EpochTable* table;
+         size_t slot;
+      };
+
+      typedef const_iterator iterator;
+
+
+         /// Empty table
+      EpochTable()
+         : step(0.0), base(0), regular(true), count(0)
+      {}
+
+         /// Number of records
+      size_t size() const
+      { return count; }
+
+      bool empty() const
+      { return (count == 0); }
+
+         /// Remove all records and forget the grid
+      void clear()
+      {
+         step = 0.0;
+         base = 0;
+         regular = true;
+         count = 0;
+         records.clear();
+         present.clear();
+         times.clear();
+      }
+
+      const_iterator begin() const
+      {
+         size_t s(0);
+         while(s < records.size() && !hasData(s)) ++s;
+         return const_iterator(this, s);
+      }
+
+      const_iterator end() const
+      { return const_iterator(this, records.size()); }
+
+         /// Record at exactly time t, or end()
+      const_iterator find(const CommonTime& t) const
+      {
+         size_t s;
+         if(locate(t, s)) return const_iterator(this, s);
+         return end();
+      }
+
+         /// First record at or after time t
+      const_iterator lower_bound(const CommonTime& t) const
+      { return bound(t, false); }
+
+         /// First record after time t
+      const_iterator upper_bound(const CommonTime& t) const
+      { return bound(t, true); }
+
+         /// Record at time t, added (default constructed) if not there
+      DataRecord& operator[](const CommonTime& t)
+      {
+         size_t s;
+         if(locate(t, s)) return records[s];
+         return records[insert(t)];
+      }
+
+         /// Remove the records in [first,last)
+      void erase(const_iterator first, const_iterator last)
+      {
+         size_t s0(first.slot), s1(last.slot);
+         if(s0 >= s1) return;
+
+         if(regular)
+         {
+            for(size_t s = s0; s < s1; s++)
+            {
+               if(present[s]) { present[s] = false; --count; }
+            }
+         }
+         else
+         {
+            times.erase(times.begin()+s0, times.begin()+s1);
+            count -= s1 - s0;
+         }
+
+         if(count == 0) { clear(); return; }
+
+            // release the empty slots at both ends; the grid origin does
+            // not move, so the remaining times are unchanged
+         if(regular)
+         {
+            size_t hi(records.size());
+            while(!present[hi-1]) --hi;
+            records.erase(records.begin()+hi, records.end());
+            present.erase(present.begin()+hi, present.end());
+
+            size_t lo(0);
+            while(!present[lo]) ++lo;
+            records.erase(records.begin(), records.begin()+lo);
+            present.erase(present.begin(), present.begin()+lo);
+            base += static_cast<long>(lo);
+         }
+         else
+            records.erase(records.begin()+s0, records.begin()+s1);
+      }
+
+         /// Nominal time step of the grid, 0 until two epochs are known
+         /// or when the table is not regular
+      double gridStep() const
+      { return (regular ? step : 0.0); }
+
+   private:
+
+      friend class const_iterator;
+
+         /// Time of slot s
+      CommonTime timeAt(size_t s) const
+      {
+         if(!regular) return times[s];
+         if(step == 0.0) return origin;
+         return origin + static_cast<double>(base + static_cast<long>(s))*step;
+      }
+
+      bool hasData(size_t s) const
+      { return (!regular || present[s]); }
+
+         /// Time ordering of the map, with no tolerance
+      static bool sameTime(const CommonTime& a, const CommonTime& b)
+      { return (!(a < b) && !(b < a)); }
+
+         /// Grid index (base+n) nearest to time t
+      long nearestIndex(const CommonTime& t) const
+      { return static_cast<long>(std::floor((t - origin)/step + 0.5)); }
+
+         /// Find the slot holding time t
+      bool locate(const CommonTime& t, size_t& s) const
+      {
+         if(count == 0) return false;
+
+         if(!regular)
+         {
+            std::vector<CommonTime>::const_iterator it(
+                              std::lower_bound(times.begin(), times.end(), t));
+            if(it == times.end() || t < *it) return false;
+            s = it - times.begin();
+            return true;
+         }
+
+         long n(step == 0.0 ? 0 : nearestIndex(t) - base);
+         if(n < 0 || n >= static_cast<long>(records.size())) return false;
+         s = static_cast<size_t>(n);
+         return (present[s] && sameTime(timeAt(s), t));
+      }
+
+         /// First slot with data whose time is >= t (after == false) or
+         /// > t (after == true)
+      const_iterator bound(const CommonTime& t, bool after) const
+      {
+         size_t s(0);
+         if(!regular)
+         {
+            std::vector<CommonTime>::const_iterator it(after ?
+                           std::upper_bound(times.begin(), times.end(), t) :
+                           std::lower_bound(times.begin(), times.end(), t));
+            return const_iterator(this, it - times.begin());
+         }
+
+            // start one slot below the division, and walk up past the
+            // rounding of the division and the gaps
+         if(step > 0.0)
+         {
+            long n(static_cast<long>(std::floor((t - origin)/step)) - base - 1);
+            if(n >= static_cast<long>(records.size())) return end();
+            if(n > 0) s = static_cast<size_t>(n);
+         }
+         for( ; s < records.size(); s++)
+         {
+            if(!present[s]) continue;
+            CommonTime ts(timeAt(s));
+            if(after ? (t < ts) : !(ts < t)) break;
+         }
+         return const_iterator(this, s);
+      }
+
+         /// Add a default record at time t, which is not in the table, and
+         /// return its slot
+      size_t insert(const CommonTime& t)
+      {
+         if(count == 0)
+         {
+            clear();
+            origin = t;
+            records.resize(1);
+            present.assign(1, true);
+            count = 1;
+            return 0;
+         }
+
+         if(regular)
+         {
+            if(step == 0.0) step = std::fabs(t - origin);
+
+            long n(step > 0.0 ? nearestIndex(t) : 0);
+            long lo(std::min(n, base));
+            long hi(std::max(n, base + static_cast<long>(records.size()) - 1));
+            size_t span(static_cast<size_t>(hi - lo + 1));
+
+               // on the grid, and the gap does not waste too many slots
+            if(step > 0.0 &&
+               span <= 4*count + 1024 &&
+               sameTime(origin + static_cast<double>(n)*step, t))
+            {
+               if(n < base)
+               {
+                  size_t k(static_cast<size_t>(base - n));
+                  records.insert(records.begin(), k, DataRecord());
+                  present.insert(present.begin(), k, false);
+                  base = n;
+               }
+               size_t s(static_cast<size_t>(n - base));
+               if(s >= records.size())
+               {
+                  records.resize(s+1);
+                  present.resize(s+1, false);
+               }
+               present[s] = true;
+               ++count;
+               return s;
+            }
+
+            makeIrregular();
+         }
+
+         std::vector<CommonTime>::iterator it(
+                              std::lower_bound(times.begin(), times.end(), t));
+         size_t s(it - times.begin());
+         times.insert(it, t);
+         records.insert(records.begin()+s, DataRecord());
+         ++count;
+         return s;
+      }
+
+         /// Give up the grid: keep only the slots with data, with their
+         /// times
+      void makeIrregular()
+      {
+         std::vector<DataRecord> recs;
+         recs.reserve(count+1);
+         times.clear();
+         times.reserve(count+1);
+         for(size_t s = 0; s < records.size(); s++)
+         {
+            if(!present[s]) continue;
+            times.push_back(timeAt(s));
+            recs.push_back(records[s]);
+         }
+         records.swap(recs);
+         present.clear();
+         regular = false;
+      }
+
+         /// Time of grid index 0
+      CommonTime origin;
+
+         /// Grid step in seconds, 0 with a single epoch
+      double step;
+
+         /// Grid index of slot 0
+      long base;
+
+         /// Records are on the grid; if false 'times' holds their times
+      bool regular;
+
+         /// Number of records
+      size_t count;
+
+         /// Records, one per slot
+      std::vector<DataRecord> records;
+
+         /// Slots holding a record (regular table only)
+      std::vector<bool> present;
+
+         /// Time of each record (irregular table only)
+      std::vector<CommonTime> times;
+
+   };  // End of class 'EpochTable'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif // GPSTK_EPOCH_TABLE_INCLUDE
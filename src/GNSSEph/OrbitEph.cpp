@@ -110,49 +110,99 @@ namespace gpstk
       return drift;
    }
 
+   namespace
+   {
+         // Eccentric anomaly (rad) for the mean anomaly meana (rad),
+         // solving Kepler's equation by Newton iteration
+      double eccentricAnomaly(double meana, double ecc)
+      {
+         double F,G,delea;
+         double ea = meana + ecc * ::sin(meana);
+
+         int loop_cnt = 1;
+         do {
+            F     = meana - (ea - ecc * ::sin(ea));
+            G     = 1.0 - ecc * ::cos(ea);
+            delea = F/G;
+            ea    = ea + delea;
+            loop_cnt++;
+         } while ((fabs(delea) > 1.0e-11) && (loop_cnt <= 20));
+
+         return ea;
+      }
+   }
+
    // Compute satellite position at the given time.
    // throw Invalid Request if the required data has not been stored.
    Xvt OrbitEph::svXvt(const CommonTime& t) const
+   {
+      KeplerTerms k;
+      setKeplerTerms(k);
+      return svXvt(t, k);
+   }
+
+   // Set the time independent terms of svXvt(t, k).
+   // throw Invalid Request if the required data has not been stored.
+   void OrbitEph::setKeplerTerms(KeplerTerms& k) const
+   {
+      if(!dataLoadedFlag)
+         GPSTK_THROW(InvalidRequest("Data not loaded"));
+
+      GPSEllipsoid ell;
+      double sqrtgm = SQRT(ell.gm(satID));
+      double sqrtgmRel = SQRT(ell.gm());
+
+      k.Ahalf = SQRT(A);       // A is semi-major axis of orbit
+      k.amm0 = sqrtgm / (A*k.Ahalf);                // Eqn specifies A0
+      k.q = SQRT(1.0e0 - ecc*ecc);
+      k.ToeSOW = GPSWeekSecond(ctToe).sow;  // SOW is time-system-independent
+      k.OMEGAdotE = OMEGAdot - ell.angVelocity();
+      k.OMEGAToe = ell.angVelocity() * k.ToeSOW;
+      k.ammRel0 = sqrtgmRel / (A*k.Ahalf);
+
+         // svRelativity() uses the GPS GM and no dndot
+      k.relSame = (sqrtgm == sqrtgmRel && dndot == 0.0);
+   }
+
+   // Compute satellite position at the given time, with the time
+   // independent terms given.
+   // throw Invalid Request if the required data has not been stored.
+   Xvt OrbitEph::svXvt(const CommonTime& t, const KeplerTerms& k) const
    {
       if(!dataLoadedFlag)
          GPSTK_THROW(InvalidRequest("Data not loaded"));
 
       Xvt sv;
       double ea;              // eccentric anomaly
-      double delea;           // delta eccentric anomaly during iteration
       double elapte;          // elapsed time since Toe
-      //double elaptc;          // elapsed time since Toc
-      //double dtc,dtr;
-      double q,sinea,cosea;
+      double elaptc;          // elapsed time since Toc
+      double sinea,cosea;
       double GSTA,GCTA;
       double amm;
       double meana;           // mean anomaly
-      double F,G;             // temporary real variables
+      double G;               // temporary real variables
       double alat,talat,c2al,s2al,du,dr,di,U,R,truea,AINC;
       double ANLON,cosu,sinu,xip,yip,can,san,cinc,sinc;
       double xef,yef,zef,dek,dlk,div,domk,duv,drv;
       double dxp,dyp,vxef,vyef,vzef;
 
-      GPSEllipsoid ell;
-      double sqrtgm = SQRT(ell.gm(satID));
       double twoPI = 2.0e0 * PI;
       double lecc;            // eccentricity
       double tdrinc;          // dt inclination
-      double Ahalf = SQRT(A); // A is semi-major axis of orbit
-      double ToeSOW = GPSWeekSecond(ctToe).sow;    // SOW is time-system-independent
 
       lecc = ecc;
       tdrinc = idot;
 
       // Compute time since ephemeris & clock epochs
       elapte = t - ctToe;
+      elaptc = t - ctToc;
 
       // Compute A at time of interest (LNAV: Adot==0)
       double Ak = A + Adot * elapte;
 
       // Compute mean motion (LNAV: dndot==0)
       double dnA = dn + 0.5*dndot*elapte;
-      amm  = (sqrtgm / (A*Ahalf)) + dnA;     // Eqn specifies A0, not Ak
+      amm  = k.amm0 + dnA;                   // Eqn specifies A0, not Ak
 
       // In-plane angles
       //     meana - Mean anomaly
@@ -160,31 +210,32 @@ namespace gpstk
       //     truea - True anomaly
       meana = M0 + elapte * amm;
       meana = fmod(meana, twoPI);
-      ea = meana + lecc * ::sin(meana);
+      ea = eccentricAnomaly(meana, lecc);
 
-      int loop_cnt = 1;
-      do  {
-         F = meana - (ea - lecc * ::sin(ea));
-         G = 1.0 - lecc * ::cos(ea);
-         delea = F/G;
-         ea = ea + delea;
-         loop_cnt++;
-      } while ((fabs(delea) > 1.0e-11) && (loop_cnt <= 20));
+      sinea = ::sin(ea);
+      cosea = ::cos(ea);
 
       // Compute clock corrections
-      sv.relcorr = svRelativity(t);
-      sv.clkbias = svClockBias(t);
-      sv.clkdrift = svClockDrift(t);
+      if(k.relSame)
+      {
+         sv.relcorr = REL_CONST * lecc * SQRT(Ak) * sinea;
+      }
+      else
+      {
+         double meanr = M0 + elapte * (k.ammRel0 + dn);
+         meanr = fmod(meanr, twoPI);
+         sv.relcorr = REL_CONST * lecc * SQRT(Ak) *
+                      ::sin(eccentricAnomaly(meanr, lecc));
+      }
+      sv.clkbias = af0 + elaptc * (af1 + elaptc * af2);
+      sv.clkdrift = af1 + elaptc * af2;
       sv.frame = ReferenceFrame::WGS84;
 
       // Compute true anomaly
-      q     = SQRT(1.0e0 - lecc*lecc);
-      sinea = ::sin(ea);
-      cosea = ::cos(ea);
       G     = 1.0e0 - lecc * cosea;
 
       //  G*SIN(TA) AND G*COS(TA)
-      GSTA  = q * sinea;
+      GSTA  = k.q * sinea;
       GCTA  = cosea - lecc;
 
       //  True anomaly
@@ -206,8 +257,7 @@ namespace gpstk
       AINC = i0 + tdrinc * elapte  +  di;
 
       //  Longitude of ascending node (ANLON)
-      ANLON = OMEGA0 + (OMEGAdot - ell.angVelocity()) *
-              elapte - ell.angVelocity() * ToeSOW;
+      ANLON = OMEGA0 + k.OMEGAdotE * elapte - k.OMEGAToe;
 
       // In plane location
       cosu = ::cos(U);
@@ -231,9 +281,9 @@ namespace gpstk
 
       // Compute velocity of rotation coordinates
       dek = amm / G;
-      dlk = amm * q / (G*G);
+      dlk = amm * k.q / (G*G);
       div = tdrinc - 2.0e0 * dlk * (Cic  * s2al - Cis * c2al);
-      domk = OMEGAdot - ell.angVelocity();
+      domk = k.OMEGAdotE;
       duv = dlk*(1.e0+ 2.e0 * (Cus*c2al - Cuc*s2al));
       drv = Ak * lecc * dek * sinea - 2.e0 * dlk * (Crc * s2al - Crs * c2al) +
          Adot * G;
@@ -272,20 +322,11 @@ namespace gpstk
       double Ak = A + Adot*elapte;                 // LNAV: Adot==0
       double Ahalf = SQRT(A);
       double amm = (sqrtgm / (A*Ahalf)) + dn;      // Eqn specifies A0 not Ak
-      double meana,F,G,delea;
+      double meana;
 
       meana = M0 + elapte * amm;
       meana = fmod(meana, twoPI);
-      double ea = meana + ecc * ::sin(meana);
-
-      int loop_cnt = 1;
-      do {
-         F     = meana - (ea - ecc * ::sin(ea));
-         G     = 1.0 - ecc * ::cos(ea);
-         delea = F/G;
-         ea    = ea + delea;
-         loop_cnt++;
-      } while ((ABS(delea) > 1.0e-11) && (loop_cnt <= 20));
+      double ea = eccentricAnomaly(meana, ecc);
 
       return (REL_CONST * ecc * SQRT(Ak) * ::sin(ea));
    }
@@ -132,6 +132,33 @@ namespace gpstk
           * @throw Invalid Request if the required data has not been stored. */
       double svRelativity(const CommonTime& t) const;
 
+         /** Terms of svXvt() that do not depend on time. They are set
+          * by setKeplerTerms() from the current orbit elements, and
+          * must be set again if the elements change. */
+      struct KeplerTerms
+      {
+         double Ahalf;        ///< sqrt(A)
+         double amm0;         ///< Mean motion without dn (rad/sec)
+         double q;            ///< sqrt(1-ecc^2)
+         double ToeSOW;       ///< Seconds of week of Toe
+         double OMEGAdotE;    ///< OMEGAdot less the Earth rotation rate
+         double OMEGAToe;     ///< Earth rotation angle at ToeSOW (rad)
+         double ammRel0;      ///< svRelativity() mean motion without dn
+         bool relSame;        ///< svRelativity() has the same anomaly
+      };
+
+         /** Set the time independent terms of svXvt(t, k).
+          * @throw Invalid Request if the required data has not been stored. */
+      void setKeplerTerms(KeplerTerms& k) const;
+
+         /** Same as svXvt(t), with the time independent terms given,
+          * e.g. kept by the caller for the ephemeris it is using.
+          * The relativity correction reuses the eccentric anomaly of
+          * the orbit when svRelativity() would solve the same Kepler
+          * equation (k.relSame).
+          * @throw Invalid Request if the required data has not been stored. */
+      Xvt svXvt(const CommonTime& t, const KeplerTerms& k) const;
+
          /** adjustBeginningValidity determines the beginValid and
           * endValid times.  In OrbitEph it simply assumes a 4-hour
           * fit interval; however the derived class should override
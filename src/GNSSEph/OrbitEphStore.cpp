@@ -92,6 +92,47 @@ namespace gpstk
    }
 
 
+   Xvt OrbitEphStore::getXvt(const SatID& sat, const CommonTime& t,
+                             EphCache& cache) const
+   {
+      try
+      {
+            // entries of another store are useless
+         if(cache.owner != this)
+         {
+            cache.clear();
+            cache.owner = this;
+         }
+
+         EphCache::Entry& entry(cache.sats[sat]);
+
+            // get the appropriate OrbitEph
+         const OrbitEph *eph = findOrbitEph(sat,t,entry);
+         if (!eph)
+         {
+            InvalidRequest exc("No OrbitEph for satellite " + asString(sat));
+            GPSTK_THROW(exc);
+         }
+
+         if (onlyHealthy && !eph->isHealthy())
+            GPSTK_THROW(InvalidRequest("Not healthy"));
+
+         if (entry.eph != eph)
+         {
+            eph->setKeplerTerms(entry.terms);
+            entry.eph = eph;
+         }
+
+            // compute the position, velocity and time
+         return eph->svXvt(t, entry.terms);
+      }
+      catch(InvalidRequest& ir)
+      {
+         GPSTK_RETHROW(ir);
+      }
+   }
+
+
    Xvt OrbitEphStore::computeXvt(const SatID& sat, const CommonTime& t) const
       throw()
    {
@@ -573,6 +614,70 @@ namespace gpstk
       return itNext->second;
    }
 
+   //---------------------------------------------------------------------------------
+   // Same as findOrbitEph(sat, t), with the result of the last search in
+   // entry. The interval is the one the table search of
+   // findUserOrbitEph() or findNearOrbitEph() gives the same candidates
+   // for; the choice between them is then made as in those routines.
+   const OrbitEph* OrbitEphStore::findOrbitEph(const SatID& sat,
+                                               const CommonTime& t,
+                                               EphCache::Entry& entry) const
+   {
+      if(entry.strict != strictMethod || !entry.contains(t)) {
+         entry.isSet = true;
+         entry.hasLo = entry.hasHi = false;
+         entry.hiClosed = strictMethod;
+         entry.strict = strictMethod;
+         entry.prior = entry.next = NULL;
+
+         SatTableMap::const_iterator its = satTables.find(sat);
+         if(its != satTables.end() && !its->second.empty()) {
+            const TimeOrbitEphTable& table = its->second;
+            TimeOrbitEphTable::const_iterator it = table.lower_bound(t);
+
+            if(!strictMethod && it != table.end() && !(t < it->first)) {
+               // exact match: findNearOrbitEph() returns it, for this
+               // time only
+               entry.isSet = false;
+               entry.prior = entry.next = it->second;
+            }
+            else {
+               // strict: the element before the first key >= t, for
+               // prior key < t <= next key; near: the elements around
+               // t, for prior key < t < next key
+               if(it != table.end()) {
+                  entry.hasHi = true;
+                  entry.hi = it->first;
+                  entry.next = it->second;
+               }
+               if(it != table.begin()) {
+                  --it;
+                  entry.hasLo = true;
+                  entry.lo = it->first;
+                  entry.prior = it->second;
+               }
+            }
+         }
+      }
+
+      if(strictMethod) {
+         if(entry.prior == NULL || !entry.prior->isValid(t))
+            return NULL;
+         return entry.prior;
+      }
+
+      if(entry.prior == NULL) return entry.next;
+      if(entry.next == NULL) return entry.prior;
+
+      double diffToNext = entry.next->ctToe - t;
+      double diffFromLast = t - entry.prior->ctToe;
+      if (diffToNext>diffFromLast)
+      {
+         return entry.prior;
+      }
+      return entry.next;
+   }
+
    //---------------------------------------------------------------------------------
    // Add all ephemerides to an existing list<OrbitEph>.
    // If SatID sat is given, limit selections to sat's satellite system, plus if
@@ -105,6 +105,80 @@ namespace gpstk
           *   there are no orbit elements at time t. */
       virtual Xvt getXvt(const SatID& id, const CommonTime& t) const;
 
+         /** Ephemeris in use for each satellite, for the getXvt()
+          * version that keeps it between calls. For every satellite
+          * the cache keeps the interval of times the table search
+          * selects the same candidates for, and the time independent
+          * terms of the last ephemeris used. The cache belongs to the
+          * user of the store, e.g. one per processing thread, so a
+          * store shared by several threads is not modified.
+          * @note clear() the cache if the store is changed. */
+      struct EphCache
+      {
+            /// Search result of one satellite
+         struct Entry
+         {
+               /// Default constructor, no interval
+            Entry()
+               : isSet(false), hasLo(false), hasHi(false), hiClosed(false),
+                 strict(true), prior(NULL), next(NULL), eph(NULL)
+            {}
+
+               /// Return true if the search at t gives prior and next
+            bool contains(const CommonTime& t) const
+            {
+               if(!isSet) return false;
+               if(hasLo && !(lo < t)) return false;
+               if(!hasHi) return true;
+               return (t < hi || (hiClosed && !(hi < t)));
+            }
+
+               /// interval: lo < t < hi, or t <= hi if hiClosed;
+               /// an unset limit is open
+            bool isSet;
+            CommonTime lo, hi;
+            bool hasLo, hasHi, hiClosed;
+
+               /// search method the interval was found for
+            bool strict;
+
+               /// ephemerides keyed at lo and hi (either may be NULL);
+               /// the strict method uses prior, the near method the
+               /// one with the closer Toe
+            const OrbitEph* prior;
+            const OrbitEph* next;
+
+               /// last ephemeris used and its time independent terms
+            const OrbitEph* eph;
+            OrbitEph::KeplerTerms terms;
+         };
+
+            /// Default constructor
+         EphCache() : owner(NULL) {}
+
+            /// Forget all the satellites
+         void clear()
+         { sats.clear(); }
+
+            /// store the entries were found in
+         const OrbitEphStore* owner;
+
+            /// entry of each satellite
+         std::map<SatID, Entry> sats;
+      };
+
+         /** Same as getXvt(id, t), keeping the ephemeris of the
+          * satellite in cache: while t stays between the same table
+          * keys the table is not searched, and while the ephemeris
+          * is the same its time independent terms are not computed
+          * again. The results are the same as getXvt(id, t).
+          * @param[in] id satellite SatID
+          * @param[in] t the time to look up
+          * @param[in,out] cache ephemerides of the satellites
+          * @return the Xvt of the satellite at the indicated time
+          * @throw InvalidRequest as getXvt(id, t) */
+      Xvt getXvt(const SatID& id, const CommonTime& t, EphCache& cache) const;
+
          /** Compute the position, velocity and clock offset of the
           * indicated object in ECEF coordinates (meters) at the
           * indicated time.
@@ -331,6 +405,16 @@ namespace gpstk
          return (strictMethod ? findUserOrbitEph(sat,t) : findNearOrbitEph(sat, t));
       }
 
+         /** Same as findOrbitEph(sat, t), searching the table only
+          * when t is out of the interval kept in entry.
+          * @param sat the satellite of interest
+          * @param t the time of interest
+          * @param entry search result of the satellite, updated
+          * @return a pointer to the desired OrbitEph, or NULL if no
+          *   OrbitEph found. */
+      const OrbitEph* findOrbitEph(const SatID& sat, const CommonTime& t,
+                                   EphCache::Entry& entry) const;
+
          /** Add all ephemerides to an existing list<OrbitEph>.  If
           * SatID sat is given, limit selections to sat's satellite
           * system, plus if sat's id is not -1, limit to sat's id as
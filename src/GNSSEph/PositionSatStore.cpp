@@ -180,6 +180,56 @@ namespace gpstk
       catch(InvalidRequest& e) { GPSTK_RETHROW(e); }
    }
 
+   // Return the position and velocity for the given satellite at the given
+   // time, keeping the interpolation segment of the satellite in seg.
+   // @throw InvalidRequest as getValue()
+   void PositionSatStore::getPosVel(const SatID& sat, const CommonTime& ttag,
+                                    TabularSegment& seg, Triple& pos,
+                                    Triple& vel) const
+   {
+      try {
+         if(!seg.contains(ttag)) {
+            DataTableIterator it1, it2, kt;
+
+            // exact matches keep the original path
+            if(getTableInterval(sat, ttag, Nhalf, it1, it2, true)) {
+               PositionRecord rec(getValue(sat, ttag));
+               pos = rec.Pos;
+               vel = rec.Vel;
+               return;
+            }
+
+            // store the 2*Nhalf points, velocities if present
+            const size_t nc(haveVelocity ? 6 : 3);
+            seg.resize(2*Nhalf, nc);
+            seg.ttag0 = it1->first;
+            size_t n(0);
+            for(kt = it1; ; ++kt, ++n) {
+               if(n == Nhalf-1) seg.lo = kt->first;
+               if(n == Nhalf) seg.hi = kt->first;
+               seg.times[n] = kt->first - seg.ttag0;       // sec
+               for(int i=0; i<3; i++) {
+                  seg.value(i,n) = kt->second.Pos[i];
+                  if(haveVelocity) seg.value(3+i,n) = kt->second.Vel[i];
+               }
+               if(kt == it2) break;
+            }
+            seg.computeWeights();
+         }
+
+         // Lagrange interpolation
+         seg.basis(ttag - seg.ttag0, !haveVelocity);
+         for(int i=0; i<3; i++) {
+            pos[i] = seg.interpolate(i);
+            if(haveVelocity)
+               vel[i] = seg.interpolate(3+i);
+            else
+               vel[i] = seg.derivative(i) * 10000.;      // km/sec -> dm/sec
+         }
+      }
+      catch(InvalidRequest& e) { seg.clear(); GPSTK_RETHROW(e); }
+   }
+
    // Return the position for the given satellite at the given time
    // @param[in] sat the SatID of the satellite of interest
    // @param[in] ttag the time (CommonTime) of interest
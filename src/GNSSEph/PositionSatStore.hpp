@@ -154,6 +154,19 @@ namespace gpstk
           *     maxInterval */
       PositionRecord getValue(const SatID& sat, const CommonTime& ttag) const;
 
+         /** Return the position and velocity for the given satellite
+          * at the given time, same values as getValue().Pos and Vel.
+          * The interpolation segment of the satellite is kept in seg:
+          * the table is only searched when ttag leaves its interval.
+          * @param[in] sat the SatID of the satellite of interest
+          * @param[in] ttag the time (CommonTime) of interest
+          * @param[in,out] seg segment of this satellite, empty at first
+          * @param[out] pos the position, in the units of the table
+          * @param[out] vel the velocity, in the units of the table
+          * @throw InvalidRequest as getValue() */
+      void getPosVel(const SatID& sat, const CommonTime& ttag,
+                     TabularSegment& seg, Triple& pos, Triple& vel) const;
+
          /** Return the position for the given satellite at the given time
           * @param[in] sat the SatID of the satellite of interest
           * @param[in] ttag the time (CommonTime) of interest
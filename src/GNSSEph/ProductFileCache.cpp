@@ -0,0 +1,359 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//==============================================================================
+
+/** @file ProductFileCache.cpp
+ * Binary copy of the records parsed from one SP3 or RINEX clock file. */
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <functional>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <sys/stat.h>
+
+#include "ProductFileCache.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+   namespace
+   {
+         // Layout of the cache file, all in native byte order:
+         //  header  magic[8] version byteOrder flags pathLength (uint32)
+         //          sourceSize sourceTime nPositions nClocks checksum
+         //          (64 bit), then the source path
+         //  records key (sat system, id, day, sod, fsod, time system)
+         //          followed by 18 doubles for a position (Pos, sigPos,
+         //          Vel, sigVel, Acc, sigAcc) or 6 for a clock (bias,
+         //          sig_bias, drift, sig_drift, accel, sig_accel)
+      const char cacheMagic[8] = { 'G','P','S','T','K','P','F','C' };
+      const uint32_t cacheVersion = 1;
+      const uint32_t byteOrderMark = 0x01020304;
+
+      const size_t headerSize = 8 + 4*4 + 5*8;
+      const size_t keySize = 4*4 + 8 + 2*4;
+      const size_t positionSize = keySize + 18*8;
+      const size_t clockSize = keySize + 6*8;
+
+      template <class T>
+      void put(std::vector<char>& buf, const T& value)
+      {
+         const char *p(reinterpret_cast<const char*>(&value));
+         buf.insert(buf.end(), p, p + sizeof(T));
+      }
+
+      template <class T>
+      T get(const char*& p)
+      {
+         T value;
+         std::memcpy(&value, p, sizeof(T));
+         p += sizeof(T);
+         return value;
+      }
+
+      void putKey(std::vector<char>& buf, const SatID& sat,
+                  const CommonTime& t)
+      {
+         long day, sod;
+         double fsod;
+         TimeSystem ts;
+         t.get(day, sod, fsod, ts);
+
+         put(buf, static_cast<int32_t>(sat.system));
+         put(buf, static_cast<int32_t>(sat.id));
+         put(buf, static_cast<int32_t>(day));
+         put(buf, static_cast<int32_t>(sod));
+         put(buf, fsod);
+         put(buf, static_cast<int32_t>(ts));
+         put(buf, static_cast<int32_t>(0));
+      }
+
+      void getKey(const char*& p, SatID& sat, CommonTime& t)
+      {
+         sat.system = static_cast<SatelliteSystem>(get<int32_t>(p));
+         sat.id = get<int32_t>(p);
+         long day(get<int32_t>(p));
+         long sod(get<int32_t>(p));
+         double fsod(get<double>(p));
+         TimeSystem ts(static_cast<TimeSystem>(get<int32_t>(p)));
+         get<int32_t>(p);
+         t.set(day, sod, fsod, ts);
+      }
+
+         // The key keeps the time only if it is rebuilt exactly
+      bool keyIsExact(const CommonTime& t)
+      {
+         long day, sod;
+         double fsod;
+         TimeSystem ts;
+         t.get(day, sod, fsod, ts);
+         CommonTime back;
+         back.set(day, sod, fsod, ts);
+         return (!(back < t) && !(t < back));
+      }
+
+      void putTriple(std::vector<char>& buf, const Triple& v)
+      {
+         for(int i = 0; i < 3; i++)
+            put(buf, v[i]);
+      }
+
+      void getTriple(const char*& p, Triple& v)
+      {
+         for(int i = 0; i < 3; i++)
+            v[i] = get<double>(p);
+      }
+
+         // FNV-1a over 64-bit words; the record block is a whole number
+         // of words
+      uint64_t checksum(const char* p, size_t n)
+      {
+         uint64_t h(14695981039346656037ULL);
+         for(size_t i = 0; i + 8 <= n; i += 8)
+         {
+            uint64_t w;
+            std::memcpy(&w, p + i, 8);
+            h = (h ^ w) * 1099511628211ULL;
+         }
+         return h;
+      }
+
+   }  // End of anonymous namespace
+
+
+      // Cache of a source file
+   ProductFileCache::ProductFileCache(const std::string& dir,
+                                      const std::string& source,
+                                      unsigned int f)
+      : isEnabled(false), sourceFile(source), flags(f),
+        sourceSize(0), sourceTime(0)
+   {
+      if(dir.empty())
+         return;
+
+      struct stat st;
+      if(stat(source.c_str(), &st) != 0)
+         return;
+
+      sourceSize = static_cast<unsigned long long>(st.st_size);
+      sourceTime = static_cast<long long>(st.st_mtime);
+
+         // the base name, made unique by a hash of the full path
+      std::string::size_type pos(source.find_last_of("/\\"));
+      std::string base(pos == std::string::npos ?
+                       source : source.substr(pos + 1));
+      std::ostringstream oss;
+      oss << dir;
+      if(dir[dir.size()-1] != '/' && dir[dir.size()-1] != '\\')
+         oss << '/';
+      oss << base << '.' << std::hex << std::setw(16) << std::setfill('0')
+          << static_cast<unsigned long long>(std::hash<std::string>()(source))
+          << ".bin";
+      cacheFile = oss.str();
+
+      isEnabled = true;
+   }
+
+
+      // Read the cache file into 'positions' and 'clocks'
+   bool ProductFileCache::read()
+   {
+      positions.clear();
+      clocks.clear();
+
+      if(!isEnabled)
+         return false;
+
+      std::ifstream ifs(cacheFile.c_str(), std::ios::in | std::ios::binary);
+      if(!ifs)
+         return false;
+
+      ifs.seekg(0, std::ios::end);
+      std::streamoff length(ifs.tellg());
+      if(length < static_cast<std::streamoff>(headerSize))
+         return false;
+
+      std::vector<char> buf(static_cast<size_t>(length));
+      ifs.seekg(0, std::ios::beg);
+      if(!ifs.read(&buf[0], length))
+         return false;
+      ifs.close();
+
+      const char *p(&buf[0]);
+      if(std::memcmp(p, cacheMagic, 8) != 0)
+         return false;
+      p += 8;
+
+      if(get<uint32_t>(p) != cacheVersion ||
+         get<uint32_t>(p) != byteOrderMark ||
+         get<uint32_t>(p) != flags)
+         return false;
+
+      uint32_t pathLength(get<uint32_t>(p));
+      if(get<uint64_t>(p) != sourceSize ||
+         get<int64_t>(p) != sourceTime)
+         return false;
+
+      uint64_t nPos(get<uint64_t>(p));
+      uint64_t nClk(get<uint64_t>(p));
+      uint64_t sum(get<uint64_t>(p));
+
+      size_t dataSize(static_cast<size_t>(nPos*positionSize +
+                                          nClk*clockSize));
+      if(static_cast<size_t>(length) != headerSize + pathLength + dataSize)
+         return false;
+
+      if(std::string(p, pathLength) != sourceFile)
+         return false;
+      p += pathLength;
+
+      if(checksum(p, dataSize) != sum)
+         return false;
+
+      try
+      {
+         positions.resize(static_cast<size_t>(nPos));
+         for(size_t i = 0; i < positions.size(); i++)
+         {
+            PositionEntry& e(positions[i]);
+            getKey(p, e.sat, e.time);
+            getTriple(p, e.rec.Pos);
+            getTriple(p, e.rec.sigPos);
+            getTriple(p, e.rec.Vel);
+            getTriple(p, e.rec.sigVel);
+            getTriple(p, e.rec.Acc);
+            getTriple(p, e.rec.sigAcc);
+         }
+
+         clocks.resize(static_cast<size_t>(nClk));
+         for(size_t i = 0; i < clocks.size(); i++)
+         {
+            ClockEntry& e(clocks[i]);
+            getKey(p, e.sat, e.time);
+            e.rec.bias = get<double>(p);
+            e.rec.sig_bias = get<double>(p);
+            e.rec.drift = get<double>(p);
+            e.rec.sig_drift = get<double>(p);
+            e.rec.accel = get<double>(p);
+            e.rec.sig_accel = get<double>(p);
+         }
+      }
+      catch(Exception&)
+      {
+            // a time out of range
+         positions.clear();
+         clocks.clear();
+         return false;
+      }
+
+      return true;
+
+   }  // End of method 'ProductFileCache::read()'
+
+
+      // Write 'positions' and 'clocks' to the cache file
+   bool ProductFileCache::write() const
+   {
+      if(!isEnabled)
+         return false;
+
+      std::vector<char> data;
+      data.reserve(positions.size()*positionSize + clocks.size()*clockSize);
+
+      for(size_t i = 0; i < positions.size(); i++)
+      {
+         const PositionEntry& e(positions[i]);
+         if(!keyIsExact(e.time))
+            return false;
+         putKey(data, e.sat, e.time);
+         putTriple(data, e.rec.Pos);
+         putTriple(data, e.rec.sigPos);
+         putTriple(data, e.rec.Vel);
+         putTriple(data, e.rec.sigVel);
+         putTriple(data, e.rec.Acc);
+         putTriple(data, e.rec.sigAcc);
+      }
+
+      for(size_t i = 0; i < clocks.size(); i++)
+      {
+         const ClockEntry& e(clocks[i]);
+         if(!keyIsExact(e.time))
+            return false;
+         putKey(data, e.sat, e.time);
+         put(data, e.rec.bias);
+         put(data, e.rec.sig_bias);
+         put(data, e.rec.drift);
+         put(data, e.rec.sig_drift);
+         put(data, e.rec.accel);
+         put(data, e.rec.sig_accel);
+      }
+
+      std::vector<char> head;
+      head.reserve(headerSize + sourceFile.size());
+      head.insert(head.end(), cacheMagic, cacheMagic + 8);
+      put(head, cacheVersion);
+      put(head, byteOrderMark);
+      put(head, static_cast<uint32_t>(flags));
+      put(head, static_cast<uint32_t>(sourceFile.size()));
+      put(head, static_cast<uint64_t>(sourceSize));
+      put(head, static_cast<int64_t>(sourceTime));
+      put(head, static_cast<uint64_t>(positions.size()));
+      put(head, static_cast<uint64_t>(clocks.size()));
+      put(head, checksum(data.empty() ? NULL : &data[0], data.size()));
+      head.insert(head.end(), sourceFile.begin(), sourceFile.end());
+
+         // write a temporary file and rename it, so a reader never sees
+         // a partial cache
+      std::ostringstream tmp;
+      tmp << cacheFile << ".tmp"
+          << std::chrono::steady_clock::now().time_since_epoch().count();
+      std::string tmpFile(tmp.str());
+      {
+         std::ofstream ofs(tmpFile.c_str(),
+                           std::ios::out | std::ios::binary | std::ios::trunc);
+         if(!ofs)
+            return false;
+         ofs.write(&head[0], head.size());
+         if(!data.empty())
+            ofs.write(&data[0], data.size());
+         if(!ofs)
+         {
+            ofs.close();
+            std::remove(tmpFile.c_str());
+            return false;
+         }
+      }
+
+      std::remove(cacheFile.c_str());
+      if(std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0)
+      {
+         std::remove(tmpFile.c_str());
+         return false;
+      }
+
+      return true;
+
+   }  // End of method 'ProductFileCache::write()'
+
+}  // End of namespace gpstk
@@ -0,0 +1,139 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//==============================================================================
+
+/** @file ProductFileCache.hpp
+ * Binary copy of the records parsed from one SP3 or RINEX clock file. */
+
+#ifndef GPSTK_PRODUCT_FILE_CACHE_INCLUDE
+#define GPSTK_PRODUCT_FILE_CACHE_INCLUDE
+
+#include <string>
+#include <vector>
+
+#include "SatID.hpp"
+#include "CommonTime.hpp"
+#include "PositionSatStore.hpp"
+#include "ClockSatStore.hpp"
+
+namespace gpstk
+{
+      /// @ingroup GNSSEph
+      //@{
+
+      /** Binary cache of the records that the parsing of one product
+       * file added to the position and clock stores. The first load of a
+       * file records the records and writes them to the cache directory;
+       * the next loads read them back in one block instead of parsing the
+       * text again.
+       *
+       * The cache file holds a versioned header with the path, size and
+       * modification time of the source file, the load options ('flags')
+       * and a checksum of the records. A cache that does not match the
+       * source file or the options, or that is damaged, is ignored and
+       * written again.
+       *
+       * The records are written in the native byte order (checked when
+       * reading), so a cache is only valid on the kind of machine that
+       * wrote it. */
+   class ProductFileCache
+   {
+   public:
+
+         /// Position record added for a satellite at a time
+      struct PositionEntry
+      {
+         SatID sat;
+         CommonTime time;
+         PositionRecord rec;
+      };
+
+         /// Clock record added for a satellite at a time
+      struct ClockEntry
+      {
+         SatID sat;
+         CommonTime time;
+         ClockRecord rec;
+      };
+
+         /** Cache of a source file.
+          * @param dir cache directory, empty to disable the cache
+          * @param source product file
+          * @param flags load options the records depend on */
+      ProductFileCache(const std::string& dir,
+                       const std::string& source,
+                       unsigned int flags);
+
+         /// The cache directory is set and the source file exists
+      bool enabled() const
+      { return isEnabled; }
+
+         /** Read the cache file into 'positions' and 'clocks'.
+          * @return false if there is no valid cache of the source file */
+      bool read();
+
+         /** Write 'positions' and 'clocks' to the cache file. Failures
+          * are not errors, the file is just not cached.
+          * @return true if the cache file was written */
+      bool write() const;
+
+         /// Record a position added to the store
+      void addPosition(const SatID& sat, const CommonTime& t,
+                       const PositionRecord& rec)
+      {
+         PositionEntry e = { sat, t, rec };
+         positions.push_back(e);
+      }
+
+         /// Record a clock added to the store
+      void addClock(const SatID& sat, const CommonTime& t,
+                    const ClockRecord& rec)
+      {
+         ClockEntry e = { sat, t, rec };
+         clocks.push_back(e);
+      }
+
+         /// Name of the cache file
+      const std::string& getCacheFile() const
+      { return cacheFile; }
+
+         /// Records, in the order they were added to the stores
+      std::vector<PositionEntry> positions;
+      std::vector<ClockEntry> clocks;
+
+   private:
+
+      bool isEnabled;
+
+      std::string sourceFile;
+      std::string cacheFile;
+
+      unsigned int flags;
+
+         /// size and modification time of the source file
+      unsigned long long sourceSize;
+      long long sourceTime;
+
+   };  // End of class 'ProductFileCache'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif // GPSTK_PRODUCT_FILE_CACHE_INCLUDE
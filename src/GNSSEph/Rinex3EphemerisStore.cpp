@@ -307,6 +307,49 @@ namespace gpstk
    }
 
 
+   // Same as getXvt(sat, ttag), keeping the ephemeris of the satellite
+   // in cache.
+   // @throw InvalidRequest as getXvt(sat, ttag)
+   Xvt Rinex3EphemerisStore::getXvt(const SatID& sat, const CommonTime& inttag,
+                                    EphCache& cache) const
+   {
+      try {
+         Xvt xvt;
+         CommonTime ttag;
+
+         switch(sat.system) {
+            case SatelliteSystem::GPS:
+                ttag = correctTimeSystem(inttag, TimeSystem::GPS);
+                xvt = gpsStore.getXvt(sat, ttag, cache.gps);
+                break;
+            case SatelliteSystem::Galileo:
+                ttag = correctTimeSystem(inttag, TimeSystem::GAL);
+                xvt = galStore.getXvt(sat, ttag, cache.gal);
+                break;
+            case SatelliteSystem::BeiDou:
+                ttag = correctTimeSystem(inttag, TimeSystem::BDT);
+                xvt = bdsStore.getXvt(sat, ttag, cache.bds);
+                break;
+            case SatelliteSystem::QZSS:
+               ttag = correctTimeSystem(inttag, TimeSystem::QZS);
+               xvt = ORBstore.getXvt(sat, ttag, cache.orb);
+               break;
+            case SatelliteSystem::Glonass:
+               ttag = correctTimeSystem(inttag, TimeSystem::GLO);
+               xvt = GLOstore.getXvt(sat,ttag);
+               break;
+            default:
+               InvalidRequest e("Unsupported satellite system");
+               GPSTK_THROW(e);
+               break;
+         }
+
+         return xvt;
+      }
+      catch(InvalidRequest& ir) { GPSTK_RETHROW(ir); }
+   }
+
+
    Xvt Rinex3EphemerisStore ::
    computeXvt(const SatID& sat, const CommonTime& inttag) const throw()
    {
@@ -149,6 +149,33 @@ namespace gpstk
           *    information as to why the request failed. */
       virtual Xvt getXvt(const SatID& sat, const CommonTime& ttag) const;
 
+         /** Ephemerides in use for the satellites, for the getXvt()
+          * version that keeps them between calls: one
+          * OrbitEphStore::EphCache for each orbit store. The cache
+          * belongs to the user of the store, e.g. one per processing
+          * thread, so a store shared by several threads is not modified.
+          * @note clear() the cache if more data is loaded. */
+      struct EphCache
+      {
+            /// Forget all the satellites
+         void clear()
+         { gps.clear(); gal.clear(); bds.clear(); orb.clear(); }
+
+         OrbitEphStore::EphCache gps, gal, bds, orb;
+      };
+
+         /** Same as getXvt(sat, ttag), keeping the ephemeris of the
+          * satellite and its time independent terms in cache, see
+          * OrbitEphStore::getXvt(). Glonass satellites are computed by
+          * getXvt(sat, ttag).
+          * @param[in] sat the satellite of interest
+          * @param[in] ttag the time to look up
+          * @param[in,out] cache ephemerides of the satellites
+          * @return the Xvt of the object at the indicated time
+          * @throw InvalidRequest as getXvt(sat, ttag) */
+      Xvt getXvt(const SatID& sat, const CommonTime& ttag,
+                 EphCache& cache) const;
+
          /** Compute the position, velocity and clock offset of the
           * indicated object in ECEF coordinates (meters) at the
           * indicated time.
@@ -64,6 +64,7 @@
 #include "PositionSatStore.hpp"
 
 #include "SP3EphemerisStore.hpp"
+#include "ProductFileCache.hpp"
 
 using namespace std;
 
@@ -115,6 +116,61 @@ namespace gpstk
     }
 
 
+    Xvt SP3EphemerisStore::getXvt(const SatID& sat, const CommonTime& ttag,
+                                  SegmentCache& cache) const
+    {
+        // segments of another store are useless
+        if (cache.owner != this) {
+            cache.clear();
+            cache.owner = this;
+        }
+
+        Triple pos, vel;
+        double bias, drift;
+        try { posStore.getPosVel(sat, ttag, cache.posSeg[sat], pos, vel); }
+        catch (InvalidRequest& e) { GPSTK_RETHROW(e); }
+        try { clkStore.getBiasDrift(sat, ttag, cache.clkSeg[sat], bias, drift); }
+        catch (InvalidRequest& e) { GPSTK_RETHROW(e); }
+
+        Xvt retXvt;
+        for (int i = 0; i < 3; i++) {
+            retXvt.x[i] = pos[i] * 1000.0;    // km -> m
+            retXvt.v[i] = vel[i] * 0.1;       // dm/s -> m/s
+        }
+        if (useSP3clock) {                    // SP3
+            retXvt.clkbias = bias * 1.e-6;    // microsec -> sec
+            retXvt.clkdrift = drift * 1.e-6;  // microsec/sec -> sec/sec
+        }
+        else {                                // RINEX clock
+            retXvt.clkbias = bias;            // sec
+            retXvt.clkdrift = drift;          // sec/sec
+        }
+
+        // compute relativity correction, in seconds
+        retXvt.computeRelativityCorrection();
+        retXvt.health = Xvt::HealthStatus::Unused;
+        return retXvt;
+    }
+
+
+    void SP3EphemerisStore::getXvt(const std::vector<SatID>& sats,
+                                   const std::vector<CommonTime>& ttags,
+                                   SegmentCache& cache,
+                                   std::vector<Xvt>& xvts) const
+    {
+        xvts.resize(sats.size());
+        for (size_t i = 0; i < sats.size(); i++) {
+            try {
+                xvts[i] = getXvt(sats[i], ttags[i], cache);
+            }
+            catch (Exception&) {
+                xvts[i] = Xvt();
+                xvts[i].health = Xvt::HealthStatus::Unavailable;
+            }
+        }
+    }
+
+
     Xvt SP3EphemerisStore::computeXvt(const SatID& sat, const CommonTime& ttag)
         const throw()
     {
@@ -354,6 +410,30 @@ namespace gpstk
                // save in FileStore
             SP3Files.addFile(filename, head);
 
+               // the records depend on the file and on the reject flags
+            unsigned int cacheFlags(0x01
+                | (fillClockStore ? 0x02 : 0) | (rejectBadPosFlag ? 0x04 : 0)
+                | (rejectBadClockFlag ? 0x08 : 0) | (rejectPredPosFlag ? 0x10 : 0)
+                | (rejectPredClockFlag ? 0x20 : 0));
+            ProductFileCache cache(cacheDir, filename, cacheFlags);
+
+               // add the records of an earlier load of the same file
+            if (cache.read())
+            {
+                for (size_t k = 0; k < cache.positions.size(); k++)
+                {
+                    const ProductFileCache::PositionEntry& e(cache.positions[k]);
+                    posStore.addPositionRecord(e.sat, e.time, e.rec);
+                }
+                for (size_t k = 0; k < cache.clocks.size(); k++)
+                {
+                    const ProductFileCache::ClockEntry& e(cache.clocks[k]);
+                    clkStore.addClockRecord(e.sat, e.time, e.rec);
+                }
+                strm.close();
+                return;
+            }
+
             // read data
             bool isC(head.version == SP3Header::SP3c);
             bool goNext, haveP, haveV, haveEP, haveEV, predP, predC;
@@ -523,9 +603,15 @@ namespace gpstk
                         else
                         {
                             if (!rejectPredPosFlag || !predP)
+                            {
                                 posStore.addPositionRecord(sat, ttag, prec);
+                                if (cache.enabled()) cache.addPosition(sat, ttag, prec);
+                            }
                             if (fillClockStore && (!rejectPredClockFlag || !predC))
+                            {
                                 clkStore.addClockRecord(sat, ttag, crec);
+                                if (cache.enabled()) cache.addClock(sat, ttag, crec);
+                            }
 
                             // prepare for next
                             haveP = haveV = haveEP = haveEV = predP = predC = false;
@@ -556,9 +642,15 @@ namespace gpstk
                     else
                     {
                         if (!rejectPredPosFlag || !predP)
+                        {
                             posStore.addPositionRecord(sat, ttag, prec);
+                            if (cache.enabled()) cache.addPosition(sat, ttag, prec);
+                        }
                         if (fillClockStore && (!rejectPredClockFlag || !predC))
+                        {
                             clkStore.addClockRecord(sat, ttag, crec);
+                            if (cache.enabled()) cache.addClock(sat, ttag, crec);
+                        }
                     }
                 }
             }
@@ -571,6 +663,10 @@ namespace gpstk
             // close
             strm.close();
 
+            // keep the records for the next load
+            if (cache.enabled())
+                cache.write();
+
         }
         catch (Exception& e)
         {
@@ -720,6 +816,19 @@ namespace gpstk
             // save in FileStore
             clkFiles.addFile(filename, head);
 
+            // add the records of an earlier load of the same file
+            ProductFileCache cache(cacheDir, filename, 0x100);
+            if (cache.read())
+            {
+                for (size_t k = 0; k < cache.clocks.size(); k++)
+                {
+                    const ProductFileCache::ClockEntry& e(cache.clocks[k]);
+                    clkStore.addClockRecord(e.sat, e.time, e.rec);
+                }
+                strm.close();
+                return;
+            }
+
             // read data
             try
             {
@@ -739,6 +848,8 @@ namespace gpstk
                         rec.accel = data.accel;
                         rec.sig_accel = data.sig_accel;
                         clkStore.addClockRecord(data.sat, data.time, rec);
+                        if (cache.enabled())
+                            cache.addClock(data.sat, data.time, rec);
                     }
                 }
             }
@@ -750,6 +861,10 @@ namespace gpstk
 
             strm.close();
 
+            // keep the records for the next load
+            if (cache.enabled())
+                cache.write();
+
         }
         catch (Exception& e)
         {
@@ -123,6 +123,10 @@ namespace gpstk
           * from RINEX clock files. */
       bool rejectPredClockFlag;
 
+         /** Directory of the binary copies of the loaded files (see
+          * ProductFileCache), empty (the default) for none. */
+      std::string cacheDir;
+
          // member functions
 
          /** Private utility routine used by the loadFile and
@@ -137,13 +141,38 @@ namespace gpstk
 
    public:
 
+         /** Interpolation segments of the satellites, for the getXvt()
+          * versions that keep them between calls.  The cache belongs
+          * to the user of the store, e.g. one per processing thread,
+          * so a store shared by several threads is not modified.
+          * @note clear() the cache if more data is loaded. */
+      struct SegmentCache
+      {
+            /// Default constructor
+         SegmentCache() : owner(NULL) {}
+
+            /// Forget all the segments
+         void clear()
+         { posSeg.clear(); clkSeg.clear(); }
+
+            /// store the segments were built from
+         const SP3EphemerisStore* owner;
+
+            /// position segment of each satellite
+         std::map<SatID, TabularSegment> posSeg;
+
+            /// clock segment of each satellite
+         std::map<SatID, TabularSegment> clkSeg;
+      };
+
          /// Default constructor
       SP3EphemerisStore() throw() : storeTimeSystem(TimeSystem::Any),
          useSP3clock(true),
          rejectBadPosFlag(true),
          rejectBadClockFlag(true),
          rejectPredPosFlag(false),
-         rejectPredClockFlag(false)
+         rejectPredClockFlag(false),
+         cacheDir()
       { }
 
          /// Destructor
@@ -162,6 +191,32 @@ namespace gpstk
           *    information as to why the request failed. */
       virtual Xvt getXvt(const SatID& sat, const CommonTime& ttag) const;
 
+         /** Same as getXvt(sat, ttag), keeping the interpolation
+          * segments of the satellite in cache: requests in the same
+          * table interval as the previous one skip the table search
+          * and the interpolation setup.
+          * @param[in] sat the satellite of interest
+          * @param[in] ttag the time to look up
+          * @param[in,out] cache segments of the satellites
+          * @return the Xvt of the object at the indicated time
+          * @throw InvalidRequest as getXvt(sat, ttag) */
+      Xvt getXvt(const SatID& sat, const CommonTime& ttag,
+                 SegmentCache& cache) const;
+
+         /** Compute the Xvt of a set of satellites, e.g. all the
+          * satellites of an epoch, each one at its own time, keeping
+          * the interpolation segments in cache.  Like computeXvt(),
+          * no exception is thrown: the health of the Xvt of a
+          * satellite that cannot be computed is "Unavailable".
+          * @param[in] sats the satellites of interest
+          * @param[in] ttags the time of each satellite
+          * @param[in,out] cache segments of the satellites
+          * @param[out] xvts the Xvt of each satellite */
+      void getXvt(const std::vector<SatID>& sats,
+                  const std::vector<CommonTime>& ttags,
+                  SegmentCache& cache,
+                  std::vector<Xvt>& xvts) const;
+
          /** Compute the position, velocity and clock offset of the
           * indicated object in ECEF coordinates (meters) at the
           * indicated time.
@@ -727,6 +782,18 @@ namespace gpstk
       void rejectPredClocks(const bool flag)
       { rejectPredClockFlag = flag; }
 
+         /** Set the directory where the records of the SP3 and RINEX
+          * clock files are cached in binary form. A file loaded again
+          * with the same size, modification time and reject flags is
+          * read from its cache instead of being parsed. The directory
+          * must exist; empty disables the cache. */
+      void setCacheDirectory(const std::string& dir)
+      { cacheDir = dir; }
+
+         /// Get the cache directory, empty if not caching
+      const std::string& getCacheDirectory() const
+      { return cacheDir; }
+
 
          /// Is gap checking for position on?
       bool isPosDataGapCheck(void) throw()
@@ -45,6 +45,7 @@
 #define GPSTK_TABULAR_SAT_STORE_INCLUDE
 
 #include <map>
+#include <vector>
 #include <iostream>
 #include <cmath>
 
@@ -53,6 +54,7 @@
 #include "CommonTime.hpp"
 #include "TimeString.hpp"
 #include "Xvt.hpp"
+#include "EpochTable.hpp"
 #include "CivilTime.hpp"
 //#include "logstream.hpp"      // TEMP
 
@@ -62,6 +64,144 @@ namespace gpstk
       /// @ingroup GNSSEph
       //@{
 
+      /** The table points of one satellite used for the Lagrange
+       * interpolation at any time strictly inside one interval of its
+       * data table, together with the Lagrange denominators.  Derived
+       * stores fill it and the user keeps it (one per satellite, see
+       * SP3EphemerisStore::SegmentCache), so the following requests in
+       * the same interval skip the table search and the interpolation
+       * setup: the result is the dot product of the node values with
+       * the Lagrange basis at the requested time.
+       * @note a segment is no longer valid once the table is edited or
+       *   more data is loaded; call clear(). */
+   struct TabularSegment
+   {
+         /// Default constructor, an empty segment
+      TabularSegment() : valid(false), ncomp(0) {}
+
+         /// Return true if ttag lies strictly inside the interval
+      bool contains(const CommonTime& ttag) const
+      { return valid && lo < ttag && ttag < hi; }
+
+         /// Forget the segment
+      void clear()
+      { valid = false; times.clear(); values.clear(); }
+
+         /** Start a new segment of n nodes with nc components; the
+          * caller then sets times and values, and calls
+          * computeWeights(). */
+      void resize(size_t n, size_t nc)
+      {
+         ncomp = nc;
+         times.resize(n);
+         invDen.resize(n);
+         values.resize(n*nc);
+         L.resize(n);
+         Lp.resize(n);
+      }
+
+         /// Value of node i for component c
+      double& value(size_t c, size_t i)
+      { return values[c*times.size()+i]; }
+
+         /// Compute the Lagrange denominators 1/PROD(j!=i)[Xi-Xj]
+      void computeWeights()
+      {
+         const size_t n(times.size());
+         for(size_t i=0; i<n; i++)
+         {
+            double d(1.0);
+            for(size_t j=0; j<n; j++)
+               if(i != j) d *= times[i]-times[j];
+            invDen[i] = 1.0/d;
+         }
+         valid = true;
+      }
+
+         /** Compute the Lagrange basis L and, if deriv, its derivative
+          * Lp at x seconds after ttag0.
+          * Li(x) = PROD(j!=i)[x-Xj]/Di and Lpi(x) is the derivative of
+          * the product, cf. LagrangeInterpolation() in MiscMath.hpp */
+      void basis(double x, bool deriv) const
+      {
+         const size_t n(times.size());
+            // L holds the products of the nodes before i, then after
+         double prod(1.0);
+         for(size_t i=0; i<n; i++)
+         {
+            L[i] = prod;
+            prod *= x-times[i];
+         }
+         prod = 1.0;
+         for(size_t i=n; i-- > 0; )
+         {
+            L[i] *= prod*invDen[i];
+            prod *= x-times[i];
+         }
+         if(deriv)
+         {
+               // product rule, no division: x may be close to a node
+            for(size_t i=0; i<n; i++)
+            {
+               double p(1.0), dp(0.0);
+               for(size_t j=0; j<n; j++)
+               {
+                  if(j == i) continue;
+                  const double a(x-times[j]);
+                  dp = dp*a + p;
+                  p *= a;
+               }
+               Lp[i] = dp*invDen[i];
+            }
+         }
+      }
+
+         /// Interpolated component c, using L from basis()
+      double interpolate(size_t c) const
+      {
+         const size_t n(times.size());
+         const double *v(&values[c*n]);
+         double y(0.0);
+         for(size_t i=0; i<n; i++) y += L[i]*v[i];
+         return y;
+      }
+
+         /// Derivative of component c, using Lp from basis(x,true)
+      double derivative(size_t c) const
+      {
+         const size_t n(times.size());
+         const double *v(&values[c*n]);
+         double y(0.0);
+         for(size_t i=0; i<n; i++) y += Lp[i]*v[i];
+         return y;
+      }
+
+         /// true when the segment holds an interval
+      bool valid;
+
+         /// time of the first node
+      CommonTime ttag0;
+
+         /// the table interval: lo < ttag < hi
+      CommonTime lo, hi;
+
+         /// node times, seconds after ttag0
+      std::vector<double> times;
+
+         /// number of components
+      size_t ncomp;
+
+         /// Lagrange denominators 1/PROD(j!=i)[Xi-Xj]
+      std::vector<double> invDen;
+
+         /// node values, component after component
+      std::vector<double> values;
+
+         /// basis at the last time, scratch for basis()
+      mutable std::vector<double> L, Lp;
+
+   };  // End of struct 'TabularSegment'
+
       /** Store a table of data vs time for each of several
        * satellites.  The data are stored as DataRecords, one for each
        * satellite,time.  The getValue(sat, t) routine interpolates
@@ -79,8 +219,9 @@ namespace gpstk
          // compile these were originally in the protected block.
    public:
          // the data tables
+         /// time-ordered records of one satellite, used like a
          /// std::map with key=CommonTime, value=DataRecord
-      typedef std::map<CommonTime, DataRecord> DataTable;
+      typedef EpochTable<DataRecord> DataTable;
 
          /// std::map with key=SatID, value=DataTable
       typedef std::map<SatID, DataTable> SatTable;
@@ -89,7 +230,7 @@ namespace gpstk
    protected:
 
          /** the data tables:
-          * std::map<SatID, std::map<CommonTime, DataRecord> > */
+          * std::map<SatID, EpochTable<DataRecord> > */
       SatTable tables;
 
          /** Time system of tables; default and initial value is
@@ -184,7 +325,7 @@ namespace gpstk
           * parameter exactReturn is true) or (it1+nhalf-1) or
           * (it1+nhalf) (if exactReturn is false).  This routine is
           * used to select data from the table for interpolation; note
-          * that DataTable is a map<CommonTime,DataRecord>.
+          * that DataTable is ordered like a map<CommonTime,DataRecord>.
           * @param[in] sat satellite of interest
           * @param[in] ttag time of interest, e.g. where interpolation
           *   will be conducted
@@ -18,7 +18,7 @@ namespace gpstk
     }
 
 
-    void iauRz(double psi, Matrix<double>& r)
+    void iauRz(double psi, Mat3& r)
     {
        double s, c, a00, a01, a02, a10, a11, a12;
 
@@ -43,7 +43,7 @@ namespace gpstk
     }
 
 
-    void iauRy(double theta, Matrix<double>& r)
+    void iauRy(double theta, Mat3& r)
     {
        double s, c, a00, a01, a02, a20, a21, a22;
 
@@ -68,7 +68,7 @@ namespace gpstk
     }
 
 
-    void iauRx(double phi, Matrix<double>& r)
+    void iauRx(double phi, Mat3& r)
     {
        double s, c, a10, a11, a12, a20, a21, a22;
 
@@ -93,6 +93,30 @@ namespace gpstk
     }
 
 
+    void iauRz(double psi, Matrix<double>& r)
+    {
+       Mat3 m(r);
+       iauRz(psi, m);
+       m.copyTo(r);
+    }
+
+
+    void iauRy(double theta, Matrix<double>& r)
+    {
+       Mat3 m(r);
+       iauRy(theta, m);
+       m.copyTo(r);
+    }
+
+
+    void iauRx(double phi, Matrix<double>& r)
+    {
+       Mat3 m(r);
+       iauRx(phi, m);
+       m.copyTo(r);
+    }
+
+
     double iauAnp(double a)
     {
        double w;
@@ -2923,7 +2947,7 @@ namespace gpstk
 
 
 
-    void iauC2ixys(double x, double y, double s, Matrix<double>& rc2i)
+    void iauC2ixys(double x, double y, double s, Mat3& rc2i)
     {
        double r2, e, d;
 
@@ -2934,8 +2958,7 @@ namespace gpstk
        d = std::atan(std::sqrt(r2 / (1.0 - r2)));
 
     /* Form the matrix. */
-       rc2i.resize(3,3,0.0);
-       rc2i(0,0) = 1.0; rc2i(1,1) = 1.0; rc2i(2,2) = 1.0;
+       rc2i = Mat3::identity();
        iauRz(e, rc2i);
        iauRy(d, rc2i);
        iauRz(-(e+s), rc2i);
@@ -2944,6 +2967,14 @@ namespace gpstk
     }
 
 
+    void iauC2ixys(double x, double y, double s, Matrix<double>& rc2i)
+    {
+       Mat3 m;
+       iauC2ixys(x, y, s, m);
+       m.copyTo(rc2i);
+    }
+
+
 
     void iauNut00a(double date1, double date2, double *dpsi, double *deps)
     {
@@ -4873,11 +4904,10 @@ namespace gpstk
 
 
     void iauFw2m(double gamb, double phib, double psi, double eps,
-                 Matrix<double>& r)
+                 Mat3& r)
     {
     /* Construct the matrix. */
-        r.resize(3,3,0.0);
-        r(0,0) = 1.0; r(1,1) = 1.0; r(2,2) = 1.0;
+        r = Mat3::identity();
 
         iauRz(gamb, r);
         iauRx(phib, r);
@@ -4888,14 +4918,22 @@ namespace gpstk
     }
 
 
+    void iauFw2m(double gamb, double phib, double psi, double eps,
+                 Matrix<double>& r)
+    {
+        Mat3 m;
+        iauFw2m(gamb, phib, psi, eps, m);
+        m.copyTo(r);
+    }
+
+
 
     void iauPn06(double date1, double date2, double dpsi, double deps,
                  double *epsa,
-                 Matrix<double>& rb, Matrix<double>& rp, Matrix<double>& rbp,
-                 Matrix<double>& rn, Matrix<double>& rbpn)
+                 Mat3& rb, Mat3& rp, Mat3& rbp, Mat3& rn, Mat3& rbpn)
     {
        double gamb, phib, psib, eps;
-       Matrix<double> r1(3,3,0.0), r2(3,3,0.0), rt(3,3,0.0);
+       Mat3 r1, r2, rt;
 
 
     /* Bias-precession Fukushima-Williams angles of J2000.0 = frame bias. */
@@ -4931,6 +4969,21 @@ namespace gpstk
     }
 
 
+    void iauPn06(double date1, double date2, double dpsi, double deps,
+                 double *epsa,
+                 Matrix<double>& rb, Matrix<double>& rp, Matrix<double>& rbp,
+                 Matrix<double>& rn, Matrix<double>& rbpn)
+    {
+       Mat3 b, p, bp, n, bpn;
+       iauPn06(date1, date2, dpsi, deps, epsa, b, p, bp, n, bpn);
+       b.copyTo(rb);
+       p.copyTo(rp);
+       bp.copyTo(rbp);
+       n.copyTo(rn);
+       bpn.copyTo(rbpn);
+    }
+
+
     void iauPn06a(double date1, double date2,
                   double *dpsi, double *deps, double *epsa,
                   Matrix<double>& rb, Matrix<double>& rp, Matrix<double>& rbp,
@@ -5552,12 +5605,11 @@ namespace gpstk
     }
 
 
-    void iauPom00(double xp, double yp, double sp, Matrix<double>& rpom)
+    void iauPom00(double xp, double yp, double sp, Mat3& rpom)
     {
 
     /* Construct the matrix. */
-       rpom.resize(3,3,0.0);
-       rpom(0,0) = 1.0; rpom(1,1) = 1.0; rpom(2,2) = 1.0;
+       rpom = Mat3::identity();
 
        iauRz(sp, rpom);
        iauRy(-xp, rpom);
@@ -5567,6 +5619,14 @@ namespace gpstk
     }
 
 
+    void iauPom00(double xp, double yp, double sp, Matrix<double>& rpom)
+    {
+       Mat3 m;
+       iauPom00(xp, yp, sp, m);
+       m.copyTo(rpom);
+    }
+
+
     void DoodsonArguments(const CommonTime& UT1,
                           const CommonTime& TT,
                           double BETA[6], double FNUT[5])
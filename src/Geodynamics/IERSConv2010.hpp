@@ -3,6 +3,7 @@
 
 #include "Vector.hpp"
 #include "Matrix.hpp"
+#include "Mat3.hpp"
 #include "CommonTime.hpp"
 
 namespace gpstk
@@ -18,6 +19,7 @@ namespace gpstk
      * @return  r       r_matrix, rotated
      *
      */
+    void iauRz(double psi, Mat3& r);
     void iauRz(double psi, Matrix<double>& r);
 
 
@@ -27,6 +29,7 @@ namespace gpstk
      * @return  r       r_matrix, rotated
      *
      */
+    void iauRy(double theta, Mat3& r);
     void iauRy(double theta, Matrix<double>& r);
 
 
@@ -36,6 +39,7 @@ namespace gpstk
      * @return  r       r_matrix, rotated
      *
      */
+    void iauRx(double phi, Mat3& r);
     void iauRx(double phi, Matrix<double>& r);
 
 
@@ -217,6 +221,7 @@ namespace gpstk
      * @return  rc2i            celestial-to-intermediate matrix
      *
      */
+    void iauC2ixys(double x, double y, double s, Mat3& rc2i);
     void iauC2ixys(double x, double y, double s, Matrix<double>& rc2i);
 
 
@@ -271,6 +276,8 @@ namespace gpstk
      * @return  r               rotation matrix
      *
      */
+    void iauFw2m(double gamb, double phib, double psi, double eps,
+                 Mat3& r);
     void iauFw2m(double gamb, double phib, double psi, double eps,
                  Matrix<double>& r);
 
@@ -289,6 +296,9 @@ namespace gpstk
      *          rbpn            GCRS-to-true matrix
      *
      */
+    void iauPn06(double date1, double date2, double dpsi, double deps,
+                 double *epsa,
+                 Mat3& rb, Mat3& rp, Mat3& rbp, Mat3& rn, Mat3& rbpn);
     void iauPn06(double date1, double date2, double dpsi, double deps,
                  double *epsa,
                  Matrix<double>& rb, Matrix<double>& rp, Matrix<double>& rbp,
@@ -483,6 +493,7 @@ namespace gpstk
      * @return  rpom            polar-motion matrix
      *
      */
+    void iauPom00(double xp, double yp, double sp, Mat3& rpom);
     void iauPom00(double xp, double yp, double sp, Matrix<double>& rpom);
 
 
@@ -8,6 +8,8 @@
 #include <fstream>
 #include <cmath>
 #include <iomanip>
+#include <algorithm>
+#include <chrono>
 
 #include "Epoch.hpp"
 
@@ -487,8 +489,219 @@ namespace gpstk
 
 
 
-    /// Transformation matrix from ICRS to ITRS.
-    Matrix<double> ReferenceSystem::C2TMatrix(const CommonTime& UTC)
+    /// Interpolate the precession-nutation on a grid of TT.
+    ReferenceSystem& ReferenceSystem::setCIPInterpolation(double step,
+                                                          int points)
+        noexcept(false)
+    {
+        if( step < 0.0 || points < 2 )
+        {
+            InvalidRequest e("Invalid grid of the interpolated CIP.");
+            GPSTK_THROW(e);
+        }
+
+        cipStep = step/DAY_TO_SEC;
+        cipPoints = points;
+
+        // Lagrange denominators PROD(j!=i)(i-j) of the nodes 0..points-1
+        cipDenom.assign(points, 1.0);
+        for(int i=0; i<points; i++)
+        {
+            for(int j=0; j<points; j++)
+            {
+                if(j != i) cipDenom[i] *= double(i-j);
+            }
+        }
+
+        cipBase = 0;
+        cipNodes.clear();
+        cipReady.clear();
+
+        return (*this);
+
+    }  // End of method 'ReferenceSystem::setCIPInterpolation()'
+
+
+    /// Evaluate the full series at the given TT.
+    void ReferenceSystem::fullCIP(const CommonTime& TT, CIPNode& node)
+    {
+        MJD mjd_tt(TT);
+
+        // Raw CIP X,Y coordinates
+        iauXy06(JD_TO_MJD, mjd_tt.mjd, &node.X, &node.Y);
+
+        // The CIO locator s
+        node.s = iauS06(JD_TO_MJD, mjd_tt.mjd, node.X, node.Y);
+
+        // Ocean Tide Corrections, in uas and us
+        Vector<double> ocean( ortho_eop(TT) );
+        node.ocean[0] = ocean(0);
+        node.ocean[1] = ocean(1);
+        node.ocean[2] = ocean(2);
+
+    }  // End of method 'ReferenceSystem::fullCIP()'
+
+
+    /// Grid node k, computed if needed.
+    const ReferenceSystem::CIPNode& ReferenceSystem::getCIPNode(long k)
+    {
+        const long maxGap(10000);
+        long size( static_cast<long>(cipNodes.size()) );
+
+        if( size == 0 || k < cipBase - maxGap || k >= cipBase + size + maxGap )
+        {
+            // start a new table
+            cipBase = k;
+            cipNodes.assign(1, CIPNode());
+            cipReady.assign(1, false);
+        }
+        else if( k < cipBase )
+        {
+            cipNodes.insert(cipNodes.begin(), cipBase-k, CIPNode());
+            cipReady.insert(cipReady.begin(), cipBase-k, false);
+            cipBase = k;
+        }
+        else if( k >= cipBase + size )
+        {
+            cipNodes.resize(k-cipBase+1);
+            cipReady.resize(k-cipBase+1, false);
+        }
+
+        size_t i( static_cast<size_t>(k-cipBase) );
+        if( !cipReady[i] )
+        {
+            MJD mjd(static_cast<long double>(k)*cipStep, TimeSystem::TT);
+            fullCIP(mjd.convertToCommonTime(), cipNodes[i]);
+            cipReady[i] = true;
+        }
+
+        return cipNodes[i];
+
+    }  // End of method 'ReferenceSystem::getCIPNode()'
+
+
+    /// Get X, Y, s and the ocean tide corrections at the given TT.
+    void ReferenceSystem::getCIP(const CommonTime& TT,
+                                 double& X, double& Y, double& s,
+                                 Vec3& ocean)
+    {
+        CIPNode node;
+
+        if( cipStep <= 0.0 )
+        {
+            fullCIP(TT, node);
+        }
+        else
+        {
+            // grid nodes k0, ..., k0+cipPoints-1 around the time
+            double u( static_cast<double>(MJD(TT).mjd)/cipStep );
+            long k0( static_cast<long>(std::floor(u)) - (cipPoints-1)/2 );
+
+            node.X = node.Y = node.s = 0.0;
+            node.ocean[0] = node.ocean[1] = node.ocean[2] = 0.0;
+
+            for(int i=0; i<cipPoints; i++)
+            {
+                // Lagrange basis of node i
+                double L(1.0);
+                for(int j=0; j<cipPoints; j++)
+                {
+                    if(j != i) L *= u - double(k0+j);
+                }
+                L /= cipDenom[i];
+
+                const CIPNode& n( getCIPNode(k0+i) );
+                node.X += L*n.X;
+                node.Y += L*n.Y;
+                node.s += L*n.s;
+                node.ocean[0] += L*n.ocean[0];
+                node.ocean[1] += L*n.ocean[1];
+                node.ocean[2] += L*n.ocean[2];
+            }
+        }
+
+        X = node.X;
+        Y = node.Y;
+        s = node.s;
+
+        ocean[0] = node.ocean[0]*1e-6;
+        ocean[1] = node.ocean[1]*1e-6;
+        ocean[2] = node.ocean[2]*1e-6;
+
+    }  // End of method 'ReferenceSystem::getCIP()'
+
+
+    /// Compare the interpolated series with the full series.
+    ReferenceSystem::CIPAccuracy ReferenceSystem::checkCIPInterpolation(
+                                                const CommonTime& startUTC,
+                                                const CommonTime& endUTC,
+                                                int samples)
+        noexcept(false)
+    {
+        if( cipStep <= 0.0 || samples < 1 )
+        {
+            InvalidRequest e("The CIP interpolation is not enabled.");
+            GPSTK_THROW(e);
+        }
+
+        // sample times, offset from the grid nodes
+        std::vector<CommonTime> times;
+        double span( endUTC - startUTC );
+        for(int i=0; i<samples; i++)
+        {
+            times.push_back( UTC2TT(startUTC + (i+0.37)*span/samples) );
+        }
+
+        std::vector<CIPNode> full(samples);
+        std::vector<CIPNode> interp(samples);
+        Vec3 ocean;
+
+        // the first pass computes the grid nodes
+        for(int i=0; i<samples; i++)
+        {
+            getCIP(times[i], interp[i].X, interp[i].Y, interp[i].s, ocean);
+        }
+
+        std::chrono::steady_clock::time_point t0( std::chrono::steady_clock::now() );
+        for(int i=0; i<samples; i++)
+        {
+            getCIP(times[i], interp[i].X, interp[i].Y, interp[i].s, ocean);
+            for(int k=0; k<3; k++) interp[i].ocean[k] = ocean[k];
+        }
+
+        std::chrono::steady_clock::time_point t1( std::chrono::steady_clock::now() );
+        for(int i=0; i<samples; i++)
+        {
+            fullCIP(times[i], full[i]);
+            for(int k=0; k<3; k++) full[i].ocean[k] *= 1e-6;
+        }
+        std::chrono::steady_clock::time_point t2( std::chrono::steady_clock::now() );
+
+        CIPAccuracy acc = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+        const double RAD_TO_UAS( 1e6/AS_TO_RAD );
+        for(int i=0; i<samples; i++)
+        {
+            acc.X = std::max(acc.X, std::fabs(interp[i].X-full[i].X)*RAD_TO_UAS);
+            acc.Y = std::max(acc.Y, std::fabs(interp[i].Y-full[i].Y)*RAD_TO_UAS);
+            acc.s = std::max(acc.s, std::fabs(interp[i].s-full[i].s)*RAD_TO_UAS);
+            acc.xp = std::max(acc.xp,
+                        std::fabs(interp[i].ocean[0]-full[i].ocean[0])*1e6);
+            acc.yp = std::max(acc.yp,
+                        std::fabs(interp[i].ocean[1]-full[i].ocean[1])*1e6);
+            acc.UT1mUTC = std::max(acc.UT1mUTC,
+                        std::fabs(interp[i].ocean[2]-full[i].ocean[2])*1e6);
+        }
+
+        acc.interpTime = std::chrono::duration<double>(t1-t0).count()/samples;
+        acc.fullTime = std::chrono::duration<double>(t2-t1).count()/samples;
+
+        return acc;
+
+    }  // End of method 'ReferenceSystem::checkCIPInterpolation()'
+
+
+    /// Rotation from ICRS to ITRS.
+    Mat3 ReferenceSystem::C2TRotation(const CommonTime& UTC)
     {
 
         // EOP Data
@@ -521,25 +734,22 @@ namespace gpstk
         CommonTime TT( UTC2TT(UTC) );
         MJD mjd_tt(TT);
 
-        // Ocean Tide Corrections
-        Vector<double> cor_ocean = ortho_eop(TT)*1e-6;
-        xp += cor_ocean(0);
-        yp += cor_ocean(1);
-        UT1mUTC += cor_ocean(2);
+        // Raw CIP X,Y coordinates, the CIO locator s and
+        // the Ocean Tide Corrections
+        double X(0.0), Y(0.0), s(0.0);
+        Vec3 cor_ocean;
+        getCIP(TT, X, Y, s, cor_ocean);
 
-        // Raw CIP X,Y coordinates
-        double X(0.0), Y(0.0);
-        iauXy06(JD_TO_MJD, mjd_tt.mjd, &X, &Y);
-
-        // The CIO locator s
-        double s = iauS06(JD_TO_MJD, mjd_tt.mjd, X, Y);
+        xp += cor_ocean[0];
+        yp += cor_ocean[1];
+        UT1mUTC += cor_ocean[2];
 
         // Corrected CIP X,Y coordinates
         X += dX * AS_TO_RAD;
         Y += dY * AS_TO_RAD;
 
         // GCRS-to-CIRS matrix
-        Matrix<double> Q(3,3,0.0);
+        Mat3 Q;
         iauC2ixys(X, Y, s, Q);
 
         // UT1
@@ -550,8 +760,7 @@ namespace gpstk
         double ERA = iauEra00(JD_TO_MJD, mjd_ut1.mjd);
 
         // CIRS-to-TIRS matrix
-        Matrix<double> R(3,3,0.0);
-        R(0,0) = 1.0; R(1,1) = 1.0; R(2,2) = 1.0;
+        Mat3 R( Mat3::identity() );
         iauRz(ERA, R);
 
         // The TIO locator s'
@@ -561,11 +770,20 @@ namespace gpstk
         yp *= AS_TO_RAD;
 
         // TIRS-to-ITRS matrix
-        Matrix<double> W(3,3,0.0);
+        Mat3 W;
         iauPom00(xp, yp, sp, W);
 
         return W * R * Q;
 
+    }  // End of method 'ReferenceSystem::C2TRotation()'
+
+
+    /// Transformation matrix from ICRS to ITRS.
+    Matrix<double> ReferenceSystem::C2TMatrix(const CommonTime& UTC)
+    {
+
+        return C2TRotation(UTC).toMatrix();
+
     }  // End of method 'ReferenceSystem::C2TMatrix()'
 
 
@@ -573,15 +791,15 @@ namespace gpstk
     Matrix<double> ReferenceSystem::T2CMatrix(const CommonTime& UTC)
     {
 
-        return transpose( C2TMatrix(UTC) );
+        return C2TRotation(UTC).transpose().toMatrix();
 
     }  // End of method 'ReferenceSystem::T2CMatrix()'
 
 
 
-    /// Time derivative of transformation matrix from CRS to TRS coordinates
+    /// Time derivative of rotation from CRS to TRS coordinates
     /// for a given date
-    Matrix<double> ReferenceSystem::dC2TMatrix(const CommonTime& UTC)
+    Mat3 ReferenceSystem::dC2TRotation(const CommonTime& UTC)
     {
         // EOP Data
         EOPDataStore::EOPData eop( getEOPData(UTC) );
@@ -595,25 +813,22 @@ namespace gpstk
         CommonTime TT( UTC2TT(UTC) );
         MJD mjd_tt(TT);
 
-        // Ocean Tide Corrections
-        Vector<double> cor_ocean = ortho_eop(TT)*1e-6;
-        xp += cor_ocean(0);
-        yp += cor_ocean(1);
-        UT1mUTC += cor_ocean(2);
+        // Raw CIP X,Y coordinates, the CIO locator s and
+        // the Ocean Tide Corrections
+        double X(0.0), Y(0.0), s(0.0);
+        Vec3 cor_ocean;
+        getCIP(TT, X, Y, s, cor_ocean);
 
-        // Raw CIP X,Y coordinates
-        double X(0.0), Y(0.0);
-        iauXy06(JD_TO_MJD, mjd_tt.mjd, &X, &Y);
-
-        // The CIO locator s
-        double s = iauS06(JD_TO_MJD, mjd_tt.mjd, X, Y);
+        xp += cor_ocean[0];
+        yp += cor_ocean[1];
+        UT1mUTC += cor_ocean[2];
 
         // Corrected CIP X,Y coordinates
         X += dX * AS_TO_RAD;
         Y += dY * AS_TO_RAD;
 
         // GCRS-to-CTRS matrix
-        Matrix<double> Q(3,3,0.0);
+        Mat3 Q;
         iauC2ixys(X, Y, s, Q);
 
         // UT1
@@ -625,7 +840,7 @@ namespace gpstk
         double dERA = TWO_PI*1.00273781191135448/DAY_TO_SEC;
 
         // CIRS-to-TIRS matrix time dot
-        Matrix<double> dR(3,3,0.0);
+        Mat3 dR;
         dR(0,0) = -std::sin(ERA);
         dR(0,1) =  std::cos(ERA);
         dR(1,0) = -std::cos(ERA);
@@ -637,11 +852,21 @@ namespace gpstk
 
         // TIRS-to-ITRS matrix
         double sp = iauSp00(JD_TO_MJD, mjd_tt.mjd);
-        Matrix<double> W(3,3,0.0);
+        Mat3 W;
         iauPom00(xp, yp, sp, W);
 
         return W * dR * Q;
 
+    }  // End of method 'ReferenceSystem::dC2TRotation()'
+
+
+    /// Time derivative of transformation matrix from CRS to TRS coordinates
+    /// for a given date
+    Matrix<double> ReferenceSystem::dC2TMatrix(const CommonTime& UTC)
+    {
+
+        return dC2TRotation(UTC).toMatrix();
+
     }  // End of method 'ReferenceSystem::dC2TMatrix()'
 
 
@@ -650,7 +875,7 @@ namespace gpstk
     Matrix<double> ReferenceSystem::dT2CMatrix(const CommonTime& UTC)
     {
 
-        return transpose( dC2TMatrix(UTC) );
+        return dC2TRotation(UTC).transpose().toMatrix();
 
     }  // End of method 'ReferenceSystem::dT2CMatrix()'
 
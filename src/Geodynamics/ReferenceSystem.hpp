@@ -8,9 +8,11 @@
 
 
 #include <string>
+#include <vector>
 #include "GNSSconstants.hpp"
 #include "Vector.hpp"
 #include "Matrix.hpp"
+#include "Mat3.hpp"
 #include "CommonTime.hpp"
 #include "EOPDataStore.hpp"
 #include "LeapSecStore.hpp"
@@ -59,15 +61,16 @@ namespace gpstk
 
         /// Default constructor.
         ReferenceSystem()
-            : pEopStore(NULL), pLeapSecStore(NULL), isPrepared(false)
+            : pEopStore(NULL), pLeapSecStore(NULL), isPrepared(false),
+              cipStep(0.0), cipPoints(0), cipBase(0)
         {}
 
 
         /** Constructor.
          */
-        ReferenceSystem(EOPDataStore& eopStore,
+        ReferenceSystem(const EOPDataStore& eopStore,
                         LeapSecStore& leapSecStore)
-            : isPrepared(false)
+            : isPrepared(false), cipStep(0.0), cipPoints(0), cipBase(0)
         {
             pEopStore = &eopStore;
             pLeapSecStore = &leapSecStore;
@@ -75,12 +78,12 @@ namespace gpstk
 
 
         /// Set the EOP data store.
-        ReferenceSystem& setEOPDataStore(EOPDataStore& eopStore)
+        ReferenceSystem& setEOPDataStore(const EOPDataStore& eopStore)
         { pEopStore = &eopStore; return (*this); };
 
 
         /// Get the EOP data store.
-        EOPDataStore* getEOPDataStore() const
+        const EOPDataStore* getEOPDataStore() const
         { return pEopStore; };
 
 
@@ -222,6 +225,15 @@ namespace gpstk
 
         ///------ Methods to do reference system transformation ------///
 
+        /// Rotation from CRS to TRS coordinates for a given date
+        Mat3 C2TRotation(const CommonTime& UTC);
+
+
+        /// Time derivative of the rotation from CRS to TRS coordinates
+        /// for a given date
+        Mat3 dC2TRotation(const CommonTime& UTC);
+
+
         /// Transformation matrix from CRS to TRS coordinates for a given date
         Matrix<double> C2TMatrix(const CommonTime& UTC);
 
@@ -252,6 +264,55 @@ namespace gpstk
                                const Vector<double>& v);
 
 
+        ///------ Interpolated precession-nutation ------///
+
+        /// Largest differences between the interpolated and the full
+        /// series, and the mean cost of one evaluation of each
+        struct CIPAccuracy
+        {
+            double X, Y, s;        ///< CIP X, Y and CIO locator s, in uas
+            double xp, yp;         ///< ocean tide pole corrections, in uas
+            double UT1mUTC;        ///< ocean tide UT1 correction, in us
+            double fullTime;       ///< seconds per full evaluation
+            double interpTime;     ///< seconds per interpolated evaluation
+        };
+
+
+        /** Serve the CIP coordinates X, Y, the CIO locator s and the
+         *  ocean tide corrections of the EOP by Lagrange interpolation
+         *  of values tabulated on a regular grid of TT, instead of
+         *  evaluating the full series (iauXy06, iauS06, ortho_eop) at
+         *  every call of C2TMatrix() and dC2TMatrix().
+         *
+         *  The grid nodes are computed the first time they are needed,
+         *  so the table grows to cover the processing span.
+         *
+         * @param step      grid step in seconds, 0 to evaluate the full
+         *                  series at every call
+         * @param points    number of grid nodes used by the interpolation
+         */
+        ReferenceSystem& setCIPInterpolation(double step = 3600.0,
+                                             int points = 10)
+            noexcept(false);
+
+
+        /// Grid step of the interpolated series, in seconds (0: off)
+        double getCIPStep() const
+        { return cipStep*DAY_TO_SEC; };
+
+
+        /** Compare the interpolated series with the full series at
+         *  'samples' times spread over [startUTC, endUTC], placed
+         *  between the grid nodes, and time both evaluations.
+         *
+         *  Interpolation must be enabled with setCIPInterpolation().
+         */
+        CIPAccuracy checkCIPInterpolation(const CommonTime& startUTC,
+                                          const CommonTime& endUTC,
+                                          int samples = 1000)
+            noexcept(false);
+
+
         /// Deconstrutor
         virtual ~ReferenceSystem() {};
 
@@ -259,7 +320,7 @@ namespace gpstk
     private:
 
         /// Pointer to the EOPDataStore
-        EOPDataStore* pEopStore;
+        const EOPDataStore* pEopStore;
 
         /// Pointer to the leap second store
         LeapSecStore* pLeapSecStore;
@@ -267,6 +328,40 @@ namespace gpstk
         /// whether the transformation matrix is prepared
         bool isPrepared;
 
+        /// Values of the series at one time
+        struct CIPNode
+        {
+            double X, Y, s;
+            double ocean[3];
+        };
+
+        /// Evaluate the full series at the given TT
+        static void fullCIP(const CommonTime& TT, CIPNode& node);
+
+        /** Get X, Y, s (radians) and the ocean tide corrections of xp,
+         *  yp (arcseconds) and UT1mUTC (seconds) at the given TT.
+         */
+        void getCIP(const CommonTime& TT,
+                    double& X, double& Y, double& s,
+                    Vec3& ocean);
+
+        /// Grid node k, computed if needed
+        const CIPNode& getCIPNode(long k);
+
+        /// Grid step in days, 0 when interpolation is off
+        double cipStep;
+
+        /// Grid nodes used by the interpolation
+        int cipPoints;
+
+        /// Lagrange denominators of the uniform grid
+        std::vector<double> cipDenom;
+
+        /// Grid nodes cipBase, cipBase+1, ...
+        long cipBase;
+        std::vector<CIPNode> cipNodes;
+        std::vector<bool> cipReady;
+
     }; // End of class 'ReferenceSystem'
 
     // @}
@@ -0,0 +1,293 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//==============================================================================
+
+/**
+ * @file Mat3.hpp
+ * Fixed-size 3-vectors and 3x3 matrices, for rotations.
+ */
+
+#ifndef GPSTK_MAT3_HPP
+#define GPSTK_MAT3_HPP
+
+#include <cmath>
+#include <cstddef>
+#include "Triple.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "GNSSconstants.hpp"
+
+namespace gpstk
+{
+
+      /**
+       * Three-dimensional vector held in place, with no heap storage.
+       * It does the arithmetic of Triple in the same order, so it can
+       * stand for a Triple in per-epoch computations without changing
+       * the results.
+       */
+   class Vec3
+   {
+   public:
+
+         /// Zero vector
+      constexpr Vec3()
+         : v{0.0, 0.0, 0.0}
+      {}
+
+      constexpr Vec3(double a, double b, double c)
+         : v{a, b, c}
+      {}
+
+         /// From a Triple
+      explicit Vec3(const Triple& t)
+         : v{t[0], t[1], t[2]}
+      {}
+
+         /** From a Vector of 3 elements.
+          * @throw GeometryException if x.size() != 3.
+          */
+      explicit Vec3(const Vector<double>& x)
+         : v{0.0, 0.0, 0.0}
+      {
+         if(x.size() != 3)
+         {
+            GeometryException e("Vec3 needs a Vector of 3 elements");
+            GPSTK_THROW(e);
+         }
+         v[0] = x[0]; v[1] = x[1]; v[2] = x[2];
+      }
+
+         /// As a Triple
+      Triple toTriple() const
+      { return Triple(v[0], v[1], v[2]); }
+
+         /// As a Vector of 3 elements
+      Vector<double> toVector() const
+      {
+         Vector<double> x(3);
+         x[0] = v[0]; x[1] = v[1]; x[2] = v[2];
+         return x;
+      }
+
+      constexpr double operator[](size_t i) const
+      { return v[i]; }
+
+      double& operator[](size_t i)
+      { return v[i]; }
+
+      constexpr size_t size() const
+      { return 3; }
+
+         /// Dot product
+      constexpr double dot(const Vec3& r) const
+      { return v[0]*r.v[0] + v[1]*r.v[1] + v[2]*r.v[2]; }
+
+         /// Cross product
+      constexpr Vec3 cross(const Vec3& r) const
+      {
+         return Vec3( v[1]*r.v[2] - v[2]*r.v[1],
+                      v[2]*r.v[0] - v[0]*r.v[2],
+                      v[0]*r.v[1] - v[1]*r.v[0] );
+      }
+
+         /// Magnitude
+      double mag() const
+      { return std::sqrt(dot(*this)); }
+
+         /** Unit vector along this vector.
+          * @throw GeometryException if the vector is zero.
+          */
+      Vec3 unitVector() const
+      {
+         double m( mag() );
+         if(m <= 1e-14)
+         {
+            GeometryException e("Divide by Zero Error");
+            GPSTK_THROW(e);
+         }
+         return Vec3(v[0]/m, v[1]/m, v[2]/m);
+      }
+
+         /** Rotations about the X, Y and Z axes, as Triple::R1(),
+          *  Triple::R2() and Triple::R3().
+          * @param angle    Angle to rotate, in degrees
+          */
+      Vec3 R1(double angle) const
+      {
+         double s( std::sin(angle*DEG_TO_RAD) ), c( std::cos(angle*DEG_TO_RAD) );
+         return Vec3(v[0], c*v[1] + s*v[2], -s*v[1] + c*v[2]);
+      }
+
+      Vec3 R2(double angle) const
+      {
+         double s( std::sin(angle*DEG_TO_RAD) ), c( std::cos(angle*DEG_TO_RAD) );
+         return Vec3(c*v[0] - s*v[2], v[1], s*v[0] + c*v[2]);
+      }
+
+      Vec3 R3(double angle) const
+      {
+         double s( std::sin(angle*DEG_TO_RAD) ), c( std::cos(angle*DEG_TO_RAD) );
+         return Vec3(c*v[0] + s*v[1], -s*v[0] + c*v[1], v[2]);
+      }
+
+      Vec3& operator+=(const Vec3& r)
+      { v[0] += r.v[0]; v[1] += r.v[1]; v[2] += r.v[2]; return *this; }
+
+      Vec3& operator-=(const Vec3& r)
+      { v[0] -= r.v[0]; v[1] -= r.v[1]; v[2] -= r.v[2]; return *this; }
+
+      Vec3& operator*=(double s)
+      { v[0] *= s; v[1] *= s; v[2] *= s; return *this; }
+
+      double v[3];
+
+   }; // End of class 'Vec3'
+
+
+   inline constexpr Vec3 operator+(const Vec3& l, const Vec3& r)
+   { return Vec3(l[0]+r[0], l[1]+r[1], l[2]+r[2]); }
+
+   inline constexpr Vec3 operator-(const Vec3& l, const Vec3& r)
+   { return Vec3(l[0]-r[0], l[1]-r[1], l[2]-r[2]); }
+
+   inline constexpr Vec3 operator-(const Vec3& r)
+   { return Vec3(-r[0], -r[1], -r[2]); }
+
+   inline constexpr Vec3 operator*(double s, const Vec3& r)
+   { return Vec3(r[0]*s, r[1]*s, r[2]*s); }
+
+   inline constexpr Vec3 operator*(const Vec3& r, double s)
+   { return Vec3(r[0]*s, r[1]*s, r[2]*s); }
+
+   inline constexpr Vec3 operator/(const Vec3& r, double s)
+   { return Vec3(r[0]/s, r[1]/s, r[2]/s); }
+
+
+      /**
+       * 3x3 matrix held in place, with no heap storage. Products are
+       * summed in the same order as the Matrix operators, so a rotation
+       * built with it equals the one built with Matrix<double>.
+       */
+   class Mat3
+   {
+   public:
+
+         /// Zero matrix
+      constexpr Mat3()
+         : m{ {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0} }
+      {}
+
+         /// Matrix given by rows
+      constexpr Mat3(double a00, double a01, double a02,
+                     double a10, double a11, double a12,
+                     double a20, double a21, double a22)
+         : m{ {a00, a01, a02}, {a10, a11, a12}, {a20, a21, a22} }
+      {}
+
+         /** From a 3x3 Matrix.
+          * @throw MatrixException if x is not 3x3.
+          */
+      explicit Mat3(const Matrix<double>& x)
+         : m{ {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0} }
+      {
+         if(x.rows() != 3 || x.cols() != 3)
+         {
+            MatrixException e("Mat3 needs a 3x3 Matrix");
+            GPSTK_THROW(e);
+         }
+         for(size_t i = 0; i < 3; i++)
+            for(size_t j = 0; j < 3; j++)
+               m[i][j] = x(i,j);
+      }
+
+         /// Identity matrix
+      static constexpr Mat3 identity()
+      { return Mat3(1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0); }
+
+         /// Copy into a Matrix, which is resized to 3x3 if needed
+      void copyTo(Matrix<double>& x) const
+      {
+         if(x.rows() != 3 || x.cols() != 3) x.resize(3, 3);
+         for(size_t i = 0; i < 3; i++)
+            for(size_t j = 0; j < 3; j++)
+               x(i,j) = m[i][j];
+      }
+
+         /// As a Matrix
+      Matrix<double> toMatrix() const
+      {
+         Matrix<double> x(3, 3);
+         copyTo(x);
+         return x;
+      }
+
+      constexpr double operator()(size_t i, size_t j) const
+      { return m[i][j]; }
+
+      double& operator()(size_t i, size_t j)
+      { return m[i][j]; }
+
+      constexpr Vec3 row(size_t i) const
+      { return Vec3(m[i][0], m[i][1], m[i][2]); }
+
+      constexpr Vec3 col(size_t j) const
+      { return Vec3(m[0][j], m[1][j], m[2][j]); }
+
+      constexpr Mat3 transpose() const
+      {
+         return Mat3( m[0][0], m[1][0], m[2][0],
+                      m[0][1], m[1][1], m[2][1],
+                      m[0][2], m[1][2], m[2][2] );
+      }
+
+      double m[3][3];
+
+   }; // End of class 'Mat3'
+
+
+   inline constexpr Mat3 transpose(const Mat3& a)
+   { return a.transpose(); }
+
+   inline constexpr Mat3 operator*(const Mat3& l, const Mat3& r)
+   {
+      return Mat3( l.row(0).dot(r.col(0)), l.row(0).dot(r.col(1)),
+                   l.row(0).dot(r.col(2)),
+                   l.row(1).dot(r.col(0)), l.row(1).dot(r.col(1)),
+                   l.row(1).dot(r.col(2)),
+                   l.row(2).dot(r.col(0)), l.row(2).dot(r.col(1)),
+                   l.row(2).dot(r.col(2)) );
+   }
+
+   inline constexpr Vec3 operator*(const Mat3& l, const Vec3& r)
+   { return Vec3(l.row(0).dot(r), l.row(1).dot(r), l.row(2).dot(r)); }
+
+   inline constexpr Mat3 operator*(double s, const Mat3& a)
+   {
+      return Mat3( a(0,0)*s, a(0,1)*s, a(0,2)*s,
+                   a(1,0)*s, a(1,1)*s, a(1,2)*s,
+                   a(2,0)*s, a(2,1)*s, a(2,2)*s );
+   }
+
+   inline constexpr Mat3 operator*(const Mat3& a, double s)
+   { return s*a; }
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_MAT3_HPP
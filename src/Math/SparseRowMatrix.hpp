@@ -0,0 +1,170 @@
+//==============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//==============================================================================
+
+/**
+ * @file SparseRowMatrix.hpp
+ * Matrix stored by rows, keeping only the elements that were set.
+ */
+
+#ifndef GPSTK_SPARSE_ROW_MATRIX_HPP
+#define GPSTK_SPARSE_ROW_MATRIX_HPP
+
+#include <cstddef>
+#include <vector>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+namespace gpstk
+{
+
+      /**
+       * Matrix in compressed sparse row form: the elements of each row
+       * are held with their column, in the order they were added. It is
+       * filled row by row with add() and endRow().
+       *
+       * The products sum the elements of a row in increasing column
+       * order, as the Matrix operators do, so when the columns of every
+       * row are added in increasing order they give the same values as
+       * the dense matrix.
+       */
+   class SparseRowMatrix
+   {
+   public:
+
+         /// Empty matrix
+      SparseRowMatrix()
+         : numCols(0), rowStart(1, 0)
+      {}
+
+         /// Empty matrix of 'cols' columns
+      explicit SparseRowMatrix(size_t cols)
+         : numCols(cols), rowStart(1, 0)
+      {}
+
+         /// Remove all rows, and set the number of columns
+      void clear(size_t cols)
+      {
+         numCols = cols;
+         rowStart.assign(1, 0);
+         colIndex.clear();
+         value.clear();
+      }
+
+         /// Reserve room for 'rows' rows and 'elements' elements
+      void reserve(size_t rows, size_t elements)
+      {
+         rowStart.reserve(rows + 1);
+         colIndex.reserve(elements);
+         value.reserve(elements);
+      }
+
+         /** Add an element to the row being filled.
+          * @throw MatrixException if col is not a column of the matrix.
+          */
+      void add(size_t col, double v)
+      {
+         if(col >= numCols)
+         {
+            MatrixException e("SparseRowMatrix column out of range");
+            GPSTK_THROW(e);
+         }
+         colIndex.push_back(col);
+         value.push_back(v);
+      }
+
+         /// Close the row being filled
+      void endRow()
+      { rowStart.push_back(colIndex.size()); }
+
+      size_t rows() const
+      { return rowStart.size() - 1; }
+
+      size_t cols() const
+      { return numCols; }
+
+         /// Number of elements held
+      size_t size() const
+      { return colIndex.size(); }
+
+         /// Elements of row i are k = begin(i) .. end(i)-1
+      size_t begin(size_t i) const
+      { return rowStart[i]; }
+
+      size_t end(size_t i) const
+      { return rowStart[i+1]; }
+
+         /// Column and value of element k
+      size_t col(size_t k) const
+      { return colIndex[k]; }
+
+      double val(size_t k) const
+      { return value[k]; }
+
+         /// Product of row i by x
+      double rowDot(size_t i, const Vector<double>& x) const
+      {
+         double sum(0.0);
+         for(size_t k = rowStart[i]; k < rowStart[i+1]; k++)
+            sum += value[k] * x[colIndex[k]];
+         return sum;
+      }
+
+         /** Product of the matrix by x.
+          * @throw MatrixException if x.size() != cols().
+          */
+      Vector<double> operator*(const Vector<double>& x) const
+      {
+         if(x.size() != numCols)
+         {
+            MatrixException e("Incompatible dimensions for "
+                              "SparseRowMatrix * Vector");
+            GPSTK_THROW(e);
+         }
+         Vector<double> toReturn(rows());
+         for(size_t i = 0; i < rows(); i++)
+            toReturn[i] = rowDot(i, x);
+         return toReturn;
+      }
+
+         /// As a dense Matrix
+      Matrix<double> toMatrix() const
+      {
+         Matrix<double> m(rows(), numCols, 0.0);
+         for(size_t i = 0; i < rows(); i++)
+            for(size_t k = rowStart[i]; k < rowStart[i+1]; k++)
+               m(i, colIndex[k]) = value[k];
+         return m;
+      }
+
+   private:
+
+      size_t numCols;
+
+         /// Index of the first element of each row, and the total at the end
+      std::vector<size_t> rowStart;
+
+      std::vector<size_t> colIndex;
+      std::vector<double> value;
+
+   }; // End of class 'SparseRowMatrix'
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_SPARSE_ROW_MATRIX_HPP
@@ -26,6 +26,8 @@
 //
 //============================================================================
 
+#include <algorithm>
+#include <chrono>
 #include "ARLambda.hpp"
 
 using namespace std;
@@ -108,81 +110,100 @@ namespace gpstk
 
       const int n = static_cast<int>(Q.rows());
 
-      Matrix<double> QC(Q);
-      L.resize(n, n, 0.0);
+      wQ.resize(n*n);
+      wL.assign(n*n, 0.0);
+      for(int i=0; i<n; i++)
+      {
+         for(int j=0; j<=i; j++) wQ[i*n+j] = Q(i,j);
+      }
       D.resize(n, 0.0);
 
+      int info(0);
       for(int i = n-1; i >= 0; i--) 
       {
-         D(i) = QC(i,i);
-         if( D(i) <= 0.0 ) return -1;
+         double* Qi = &wQ[i*n];
+         double* Li = &wL[i*n];
+         D(i) = Qi[i];
+         if( D(i) <= 0.0 ) { info = -1; break; }
          double temp = std::sqrt(D(i));
-         for(int j=0; j<=i; j++) L(i,j) = QC(i,j)/temp;
+         for(int j=0; j<=i; j++) Li[j] = Qi[j]/temp;
          for(int j=0; j<=i-1; j++) 
          {
-            for(int k=0; k<=j; k++) QC(j,k) -= L(i,k) * L(i,j);
+            double* Qj = &wQ[j*n];
+            for(int k=0; k<=j; k++) Qj[k] -= Li[k] * Li[j];
          }
-         for(int j=0; j<=i; j++) L(i,j) /= L(i,i);
+         for(int j=0; j<=i; j++) Li[j] /= Li[i];
       }
 
-      return 0;
+         // the rows done before a non positive pivot are kept
+      L.resize(n, n, 0.0);
+      for(int i=0; i<n; i++)
+      {
+         for(int j=0; j<=i; j++) L(i,j) = wL[i*n+j];
+      }
+
+      return info;
 
    }  // End of method 'ARLambda::factorize()'
 
 
-   void ARLambda::gauss(Matrix<double>& L, Matrix<double>& Z, int i, int j)
+   void ARLambda::gauss(int n, int i, int j)
    {
-      //TODO: CHECK UNEXPECTED INPUT
-      // L:nxn Z:nxn 0<=(i,j)<n
+      // L(i:n,j) -= mu*L(i:n,i), Z(:,j) -= mu*Z(:,i), and the inverse
+      // of Z gets row i += mu*row j
 
-      const int n = L.rows();
-      const int mu = (int)round(L(i,j));
+      double* L = &wL[0];
+      const int mu = (int)round(L[i*n+j]);
       if(mu != 0) 
       {
-         for(int k=i; k<n; k++) L(k,j) -= (double)mu*L(k,i);
-         for(int k=0; k<n; k++) Z(k,j) -= (double)mu*Z(k,i);
+         for(int k=i; k<n; k++) L[k*n+j] -= (double)mu*L[k*n+i];
+
+         double* Zj = &wZt[j*n];
+         const double* Zi = &wZt[i*n];
+         for(int k=0; k<n; k++) Zj[k] -= (double)mu*Zi[k];
+
+         double* Ii = &wZi[i*n];
+         const double* Ij = &wZi[j*n];
+         for(int k=0; k<n; k++) Ii[k] += (double)mu*Ij[k];
+
+         lastStats.gaussOps++;
       }
    }  // End of method 'ARLambda::gauss()'
 
    
-   void ARLambda::permute( Matrix<double>& L, 
-                           Vector<double>& D, 
-                           int j, 
-                           double del, 
-                           Matrix<double>& Z )
+   void ARLambda::permute( int n, int j, double del )
    {  
-      //TODO: CHECK UNEXPECTED INPUT
-      // L:nxn D:nx1 Z:nxn 0<=j<n
-
-      const int n = L.rows();
+      double* L = &wL[0];
+      double* D = &wD[0];
 
-      double eta=D(j)/del;
-      double lam=D(j+1)*L(j+1,j)/del;
+      double eta=D[j]/del;
+      double lam=D[j+1]*L[(j+1)*n+j]/del;
 
-      D[j]=eta*D(j+1); 
-      D(j+1)=del;
+      D[j]=eta*D[j+1]; 
+      D[j+1]=del;
       for(int k=0;k<=j-1;k++) 
       {
-         double a0=L(j,k); 
-         double a1=L(j+1,k);
-         L(j,k) =-L(j+1,j)*a0 + a1;
-         L(j+1,k) = eta*a0 + lam*a1;
+         double a0=L[j*n+k]; 
+         double a1=L[(j+1)*n+k];
+         L[j*n+k] =-L[(j+1)*n+j]*a0 + a1;
+         L[(j+1)*n+k] = eta*a0 + lam*a1;
       }
-      L(j+1,j)=lam;
-      for(int k=j+2; k<n; k++) swap(L(k,j),L(k,j+1));
-      for(int k=0; k<n; k++) swap(Z(k,j),Z(k,j+1));
+      L[(j+1)*n+j]=lam;
+      for(int k=j+2; k<n; k++) swap(L[k*n+j],L[k*n+j+1]);
+
+         // columns j, j+1 of Z, rows j, j+1 of its inverse
+      std::swap_ranges(&wZt[j*n], &wZt[j*n]+n, &wZt[(j+1)*n]);
+      std::swap_ranges(&wZi[j*n], &wZi[j*n]+n, &wZi[(j+1)*n]);
+
+      lastStats.permutations++;
 
    }  // End of method 'ARLambda::permute()'
 
    
-   void ARLambda::reduction( Matrix<double>& L, 
-                             Vector<double>& D,
-                             Matrix<double>& Z)
+   void ARLambda::reduction( int n )
    {
-      //TODO: CHECK UNEXPECTED INPUT
-      // L:nxn D:nx1 Z:nxn 0<=j<n
-
-      const int n = L.rows();
+      const double* L = &wL[0];
+      const double* D = &wD[0];
 
       int j(n-2), k(n-2);
       while(j>=0) 
@@ -191,15 +212,15 @@ namespace gpstk
          {
             for (int i=j+1; i<n; i++) 
             {
-               gauss(L,Z,i,j);
+               gauss(n,i,j);
             }
          } 
 
-         double del=D(j)+L(j+1,j)*L(j+1,j)*D(j+1);
+         double del=D[j]+L[(j+1)*n+j]*L[(j+1)*n+j]*D[j+1];
 
-         if(del+1E-6<D(j+1)) 
+         if(del+1E-6<D[j+1]) 
          { 
-            permute(L,D,j,del,Z);
+            permute(n,j,del);
             k=j; j=n-2;
          }
          else
@@ -212,72 +233,82 @@ namespace gpstk
    }  // End of method 'ARLambda::reduction()'
 
 
-   int ARLambda::search( const Matrix<double>& L, 
-                         const Vector<double>& D, 
-                         const Vector<double>& zs, 
-                         Matrix<double>& zn, 
-                         Vector<double>& s, 
-                          const int& m )
+   int ARLambda::search( int n, const double* zs, double* s, int m )
    {
-      // TODO: CHECK UNEXPECTED INPUT
       // n - number of float parameters
       // m - number of fixed solutions
-      // L - nxn
-      // D - nx1
-      // zs - nxn
-      // zn - nxm
+      // zs - n, the decorrelated float parameters
       // s  - m
-      const int LOOPMAX = 10000;
-      const int n = L.rows();
-
-      zn.resize(n,m,0.0);
-      s.resize(m,0.0);
-
-      Matrix<double> S(n,n,0.0);
-      Vector<double> dist(n,0.0),zb(n,0.0),z(n,0.0),step(n,0.0);
+      // the m solutions of smallest residual are kept in wCand in
+      // increasing order of s, so the last one bounds the search
+
+      const double* L = &wL[0];
+
+      wInvD.resize(n);
+      for(int i=0; i<n; i++) wInvD[i] = 1.0/wD[i];
+      const double* invD = &wInvD[0];
+
+         // a row of S is set before it is read, except the last
+      wS.resize(n*n);
+      std::fill(&wS[(n-1)*n], &wS[0]+n*n, 0.0);
+      wDist.assign(n, 0.0);
+      wZb.assign(n, 0.0);
+      wZc.assign(n, 0.0);
+      wStep.assign(n, 0.0);
+      wCand.assign(m*n, 0.0);
+      double* S = &wS[0];
+      double* dist = &wDist[0];
+      double* zb = &wZb[0];
+      double* z = &wZc[0];
+      double* step = &wStep[0];
+      double* cand = &wCand[0];
+      for(int i=0; i<m; i++) s[i] = 0.0;
 
       int k=n-1; dist[k]=0.0;
-      zb(k)=zs(k);
-      z(k)=round(zb(k)); 
-      double y=zb(k)-z(k); 
-      step(k)=sign(y);
+      zb[k]=zs[k];
+      z[k]=round(zb[k]); 
+      double y=zb[k]-z[k]; 
+      step[k]=sign(y);
 
-      int c(0),nn(0),imax(0);
+      int c(0),nn(0);
       double maxdist=1E99;
-      for(int c=0;c<LOOPMAX;c++)
+      for(c=0;c<loopMax;c++)
       {
-         double newdist=dist(k)+y*y/D(k);
+         double newdist=dist[k]+y*y*invD[k];
          if(newdist<maxdist) 
          {
             if(k!=0) 
             {
-               dist(--k)=newdist;
+               dist[--k]=newdist;
+               const double dz = z[k+1]-zb[k+1];
+               const double* S1 = &S[(k+1)*n];
+               const double* L1 = &L[(k+1)*n];
+               double* Sk = &S[k*n];
                for(int i=0;i<=k;i++)
                {
-                  S(k,i)=S(k+1,i)+(z(k+1)-zb(k+1))*L(k+1,i);
+                  Sk[i]=S1[i]+dz*L1[i];
                }
-               zb(k)=zs(k)+S(k,k);
-               z(k)=round(zb(k)); y=zb(k)-z(k); step(k)=sign(y);
+               zb[k]=zs[k]+Sk[k];
+               z[k]=round(zb[k]); y=zb[k]-z[k]; step[k]=sign(y);
             }
             else 
             {
-               if(nn<m) 
+                  // insert in order, the last one is dropped when full
+               int pos = (nn<m) ? nn++ : m-1;
+               for( ; pos>0 && s[pos-1]>newdist; pos--)
                {
-                  if(nn==0||newdist>s(imax)) imax=nn;
-                  for(int i=0;i<n;i++) zn(i,nn)=z(i);
-                  s(nn++)=newdist;
+                  s[pos]=s[pos-1];
+                  std::copy(&cand[(pos-1)*n], &cand[pos*n], &cand[pos*n]);
                }
-               else 
+               s[pos]=newdist;
+               std::copy(z, z+n, &cand[pos*n]);
+               if(nn==m)
                {
-                  if(newdist<s(imax)) 
-                  {
-                     for(int i=0;i<n;i++) zn(i,imax)=z(i);
-                     s(imax)=newdist;
-                     for(int i=imax=0;i<m;i++) if (s(imax)<s(i)) imax=i;
-                  }
-                  maxdist=s(imax);
+                  maxdist=s[m-1];
+                  lastStats.shrinks++;
                }
-               z(0)+=step(0); y=zb(0)-z(0); step(0)=-step(0)-sign(step(0));
+
+               z[0]+=step[0]; y=zb[0]-z[0]; step[0]=-step[0]-sign(step[0]);
             }
          }
          else 
@@ -286,22 +317,16 @@ namespace gpstk
             else 
             {
                k++;
-               z(k)+=step(k); y=zb(k)-z(k); step(k)=-step(k)-sign(step(k));
+               z[k]+=step[k]; y=zb[k]-z[k]; step[k]=-step[k]-sign(step[k]);
             }
          }
       }
-      for(int i=0;i<m-1;i++) 
-      { 
-         for(int j=i+1;j<m;j++) 
-         {
-            if(s(i)<s(j)) continue;
-            swap(s(i),s(j));
-            for(k=0;k<n;k++) swap(zn(k,i),zn(k,j));
-         }
-      }
 
-      if (c>=LOOPMAX) 
+      lastStats.nodes += c;
+
+      if (c>=loopMax) 
       {
+         lastStats.failures++;
          return -1;
       }
 
@@ -319,33 +344,92 @@ namespace gpstk
       if( (a.size()!=Q.rows()) || (Q.rows()!=Q.cols()) ) return -1;
       if( m < 1) return -1;
 
-      const int n = static_cast<int>(a.size());
       int info;
-      Matrix<double> L(n,n,0.0),E(n,m,0.0);
-      Vector<double> D(n,0.0),z(n,0.0);
-      Matrix<double> Z = ident<double>(n);
+      Matrix<double> L;
+      Vector<double> D;
 
       if (!(info=factorize(Q,L,D))) 
       {      
-         reduction(L,D,Z);
-         z = transpose(Z)*a;
+         info = lambdaFactored(a,L,D,F,s,m);
+      }
+      return info;
+      
+
+   }  // End of method 'ARLambda::lambda()'
+
+
+   int ARLambda::lambdaFactored( const Vector<double>& a, 
+                                 const Matrix<double>& L, 
+                                 const Vector<double>& D, 
+                                 Matrix<double>& F,
+                                 Vector<double>& s,
+                                 const int& m )
+   {
+      if( (a.size()!=L.rows()) || (L.rows()!=L.cols()) ||
+          (a.size()!=D.size()) ) return -1;
+      if( m < 1) return -1;
+
+      std::chrono::steady_clock::time_point t0 =
+         std::chrono::steady_clock::now();
+      lastStats.reset();
+      lastStats.calls = 1;
+
+      const int n = static_cast<int>(a.size());
+
+      wL.assign(n*n, 0.0);
+      wD.resize(n);
+      wZt.assign(n*n, 0.0);
+      wZi.assign(n*n, 0.0);
+      for(int i=0; i<n; i++)
+      {
+         for(int j=0; j<=i; j++) wL[i*n+j] = L(i,j);
+         wD[i] = D(i);
+         wZt[i*n+i] = wZi[i*n+i] = 1.0;
+      }
+
+      reduction(n);
 
-         if (!(info = search(L,D,z,E,s,m)))
+         // z=Z'*a
+      wZ.resize(n);
+      for(int i=0; i<n; i++)
+      {
+         const double* Zi = &wZt[i*n];
+         wZ[i] = 0.0;
+         for(int k=0; k<n; k++) wZ[i] += Zi[k]*a(k);
+      }
+
+      s.resize(m, 0.0);
+      int info = search(n, &wZ[0], &s[0], m);
+      if (!info)
+      {
+            // F=Z'\E, with the inverse of Z kept by the reduction
+         F.resize(n, m, 0.0);
+         for(int c=0; c<m; c++)
          {
-            try
-            {  // F=Z'\E - Z nxn  E nxm F nxm
-               F = transpose( inverse(Z) ) * E; // changed by ragnwang
-               //F = transpose( inverseLUD(Z) ) * E;  // raw
+            const double* E = &wCand[c*n];
+            for(int i=0; i<n; i++)
+            {
+               double sum(0.0);
+               for(int k=0; k<n; k++) sum += wZi[k*n+i]*E[k];
+               F(i,c) = sum;
             }
-            catch(...) 
-            { return -1; }
          }
       }
+
+      lastStats.seconds = std::chrono::duration<double>(
+         std::chrono::steady_clock::now() - t0).count();
+
+      totalStats.calls += lastStats.calls;
+      totalStats.nodes += lastStats.nodes;
+      totalStats.shrinks += lastStats.shrinks;
+      totalStats.gaussOps += lastStats.gaussOps;
+      totalStats.permutations += lastStats.permutations;
+      totalStats.failures += lastStats.failures;
+      totalStats.seconds += lastStats.seconds;
+
       return info;
-      
 
-   }  // End of method 'ARLambda::lambda()'
+   }  // End of method 'ARLambda::lambdaFactored()'
 
 
 }   // End of namespace gpstk
-
@@ -29,6 +29,7 @@
 //
 //============================================================================
 
+#include <vector>
 #include "ARBase.hpp"
 
 namespace gpstk
@@ -44,9 +45,31 @@ namespace gpstk
    class ARLambda : public ARBase
    {
    public:
+
+         /// Counters of the reduction and search
+      struct LambdaStats
+      {
+         LambdaStats()
+         { reset(); }
+
+         void reset()
+         {
+            calls = nodes = shrinks = gaussOps = permutations = failures = 0;
+            seconds = 0.0;
+         }
+
+         long calls;          ///< Calls of lambda()/lambdaFactored()
+         long nodes;          ///< Nodes of the search tree visited
+         long shrinks;        ///< Reductions of the search ellipsoid
+         long gaussOps;       ///< Integer Gauss transformations applied
+         long permutations;   ///< Permutations of the reduction
+         long failures;       ///< Searches stopped by the node limit
+         double seconds;      ///< Time spent in the reduction and search
+      };
       
          /// Default constructor
       ARLambda() 
+         : loopMax(10000)
       {}      
       
 
@@ -66,6 +89,28 @@ namespace gpstk
       { return squaredRatio; }
 
 
+         /// Counters of the last call of lambda()/lambdaFactored()
+      const LambdaStats& getLastStats() const
+      { return lastStats; }
+
+
+         /// Counters summed over the calls since the last resetStats()
+      const LambdaStats& getTotalStats() const
+      { return totalStats; }
+
+
+         /// Reset the summed counters
+      void resetStats()
+      { totalStats.reset(); }
+
+
+         /** Set the largest number of nodes visited by one search; a
+          *  search that reaches it fails.
+          */
+      ARLambda& setSearchLimit(int maxNodes)
+      { loopMax = maxNodes; return (*this); }
+
+
          /// Destractor
       virtual ~ARLambda(){}
 
@@ -106,31 +151,30 @@ namespace gpstk
                      Vector<double>& D );
 
 
+         // The reduction and search work on the row major arrays of
+         // the workspace below, of the size n given:
+         //  wL     L (n x n), reduced in place
+         //  wD     D (n)
+         //  wZt    Z' (n x n), the rows are the columns of Z
+         //  wZi    inverse of Z (n x n)
+         //  wCand  the m fixed solutions (m x n), sorted by residual
+
+
          /// integer gauss transformation
-      void gauss(Matrix<double>& L, Matrix<double>& Z, int i, int j );
+      void gauss( int n, int i, int j );
 
 
          /// permutations
-      void permute( Matrix<double>& L, 
-                    Vector<double>& D, 
-                    int j, 
-                    double del, 
-                    Matrix<double>& Z);
+      void permute( int n, int j, double del );
 
 
          /// lambda reduction (z=Z'*a, Qz=Z'*Q*Z=L'*diag(D)*L)
-      void reduction( Matrix<double>& L, 
-                      Vector<double>& D, 
-                      Matrix<double>& Z );
+      void reduction( int n );
 
 
-         // modified lambda (mlambda) search
-      virtual int search( const Matrix<double>& L, 
-                          const Vector<double>& D, 
-                          const Vector<double>& zs, 
-                          Matrix<double>& zn, 
-                          Vector<double>& s, 
-                          const int& m = 2 );
+         // modified lambda (mlambda) search of the m solutions of
+         // smallest residual s around zs, into wCand
+      int search( int n, const double* zs, double* s, int m );
 
          // lambda/mlambda integer least-square estimation
          // a     Float parameters (n x 1)
@@ -145,6 +189,18 @@ namespace gpstk
                   Vector<double>& s, 
                   const int& m = 2 );
 
+         // lambda/mlambda estimation from the factorization of Q given
+         // by factorize(), Q = L'*diag(D)*L. The factor of a trailing
+         // block Q(k:n,k:n) is L(k:n,k:n) and D(k:n), so one
+         // factorization serves all the trailing subsets of the
+         // ambiguities.
+      int lambdaFactored( const Vector<double>& a, 
+                          const Matrix<double>& L, 
+                          const Vector<double>& D, 
+                          Matrix<double>& F, 
+                          Vector<double>& s, 
+                          const int& m = 2 );
+
 
    private:
 
@@ -152,6 +208,20 @@ namespace gpstk
          /// Some internal variables
 
 
+         /// largest number of nodes visited by one search
+      int loopMax;
+
+
+         /// counters of the last call, and summed
+      LambdaStats lastStats;
+      LambdaStats totalStats;
+
+
+         /// workspace of the reduction and search, kept between calls
+      std::vector<double> wQ, wL, wD, wZt, wZi, wZ;
+      std::vector<double> wInvD, wS, wDist, wZb, wZc, wStep, wCand;
+
+
          /// squared ratio
       double squaredRatio;
       
@@ -93,7 +93,7 @@ namespace gpstk
    //
    // @param gData     Data object holding the data.
    //
-   satTypeValueMap& ChooseOptimalObs::Process( SysTypesMap& mapObsTypes,
+   satTypeValueMap& ChooseOptimalObs::Process( const SysTypesMap& mapObsTypes,
                                                std::map<RinexSatID/*SatID*/, TypeIDVec>& satTypes,
                                                satTypeValueMap& gData )
       noexcept(false)
@@ -113,7 +113,10 @@ namespace gpstk
                std::vector<TypeID> prioriTypes{};
 
                // get observed types for current system
-               std::vector<TypeID> obsTypes = mapObsTypes[string(1, sysChar)];
+               static const std::vector<TypeID> noTypes;
+               SysTypesMap::const_iterator sysTypes = mapObsTypes.find(string(1, sysChar));
+               const std::vector<TypeID>& obsTypes =
+                   (sysTypes != mapObsTypes.end()) ? sysTypes->second : noTypes;
 
                // map of <carrier-band, types> 
                std::map<char, std::string> bandCodes = priorityCodes[sysChar];
@@ -145,7 +148,7 @@ namespace gpstk
 
                            // whether is stored in Rinex header
                            // vector/list don't have find method.
-                           std::vector<TypeID>::iterator 
+                           std::vector<TypeID>::const_iterator 
                                it = find(obsTypes.begin(), obsTypes.end(), type);
                            if( it != obsTypes.end())
                            {
@@ -27,7 +27,7 @@ namespace gpstk
        *
        * @param gData    Data object holding the data.
        */
-      virtual satTypeValueMap& Process( SysTypesMap& mapObsTypes,
+      virtual satTypeValueMap& Process( const SysTypesMap& mapObsTypes,
                                         std::map<RinexSatID/*SatID*/, TypeIDVec>& satTypes,
                                         satTypeValueMap& gData) 
           noexcept(false);
@@ -36,7 +36,7 @@ namespace gpstk
       virtual gnssRinex& Process(gnssRinex& gRin) 
           noexcept(false)
       {
-          Process(gRin.header.mapObsTypes, gRin.header.satTypes,  gRin.body);
+          Process(gRin.header.obsTypes(), gRin.header.satTypes,  gRin.body);
           return gRin;
       };
 
@@ -4,6 +4,9 @@
  * This class computes linear combinations of GDS data.
  */
 
+#include <algorithm>
+#include <set>
+
 #include "ComputeCombination.hpp"
 
 using namespace std;
@@ -19,6 +22,157 @@ namespace gpstk
 
 
 
+      // Build 'combTables' from 'systemCombs'
+    void ComputeCombination::compile()
+    {
+        combTables.clear();
+
+        for(std::map<SatelliteSystem, LinearCombList>::const_iterator
+                itSys = systemCombs.begin();
+            itSys != systemCombs.end();
+            ++itSys)
+        {
+            const LinearCombList& linearList( itSys->second );
+            if( linearList.empty() )
+            {
+                continue;
+            }
+
+            CombTable& table( combTables[itSys->first] );
+
+            // The inputs in ascending order, as the terms of the bodies
+            std::set<TypeID> typeSet;
+            for(auto pos = linearList.begin(); pos != linearList.end(); ++pos)
+            {
+                for(typeValueMap::const_iterator iter = pos->body.begin();
+                    iter != pos->body.end();
+                    ++iter)
+                {
+                    typeSet.insert(iter->first);
+                }
+            }
+            table.inputs.assign(typeSet.begin(), typeSet.end());
+
+            const size_t nIn( table.inputs.size() );
+            const size_t nComb( linearList.size() );
+
+            table.coef.assign(nComb*nIn, 0.0);
+            table.terms.assign(nComb*nIn, 0);
+            table.outputs.clear();
+            table.feedback.clear();
+
+            size_t c(0);
+            for(auto pos = linearList.begin();
+                pos != linearList.end();
+                ++pos, ++c)
+            {
+                for(typeValueMap::const_iterator iter = pos->body.begin();
+                    iter != pos->body.end();
+                    ++iter)
+                {
+                    size_t j( std::lower_bound( table.inputs.begin(),
+                                                table.inputs.end(),
+                                                iter->first )
+                              - table.inputs.begin() );
+
+                    table.coef[c*nIn + j] = iter->second;
+                    table.terms[c*nIn + j] =
+                        ( pos->optionalTypes.find(iter->first)
+                          != pos->optionalTypes.end() ) ? 1 : 2;
+                }
+
+                table.outputs.push_back(pos->header);
+
+                // A later combination may read this result
+                TypeIDVec::const_iterator itIn(
+                    std::lower_bound( table.inputs.begin(),
+                                      table.inputs.end(),
+                                      pos->header ) );
+                if( itIn != table.inputs.end() && *itIn == pos->header )
+                {
+                    table.feedback.push_back(
+                        static_cast<int>(itIn - table.inputs.begin()) );
+                }
+                else
+                {
+                    table.feedback.push_back(-1);
+                }
+            }
+        }
+
+        isCompiled = true;
+
+    }  // End of method 'ComputeCombination::compile()'
+
+
+
+      /* Evaluate the combinations of 'table' over the first 'nRows' rows
+       * of 'block'/'blockFlags'.
+       *
+       * Combination 'c' of row 'r' goes to result[c*nRows + r], with
+       * valid[c*nRows + r] set to 1 if no required input is missing. The
+       * terms are summed in the order of the combination body, so the
+       * results are those of the term by term evaluation.
+       */
+    void ComputeCombination::evaluate(const CombTable& table, size_t nRows)
+    {
+        const size_t nIn( table.inputs.size() );
+        const size_t nComb( table.outputs.size() );
+
+        result.resize(nComb*nRows);
+        valid.resize(nComb*nRows);
+
+        for(size_t c = 0; c < nComb; c++)
+        {
+            const double* a( nIn ? &table.coef[c*nIn] : NULL );
+            const char* terms( nIn ? &table.terms[c*nIn] : NULL );
+            const int back( table.feedback[c] );
+
+            for(size_t r = 0; r < nRows; r++)
+            {
+                double* x( nIn ? &block[r*nIn] : NULL );
+                char* has( nIn ? &blockFlags[r*nIn] : NULL );
+
+                char ok(1);
+                for(size_t j = 0; j < nIn; j++)
+                {
+                    if( terms[j] == 2 && !has[j] )
+                    {
+                        ok = 0;
+                        break;
+                    }
+                }
+
+                valid[c*nRows + r] = ok;
+                if( !ok )
+                {
+                    continue;
+                }
+
+                // Missing optional inputs are zero in the block
+                double sum(0.0);
+                for(size_t j = 0; j < nIn; j++)
+                {
+                    if( terms[j] )
+                    {
+                        sum = sum + a[j] * x[j];
+                    }
+                }
+
+                result[c*nRows + r] = sum;
+
+                if( back >= 0 )
+                {
+                    x[back] = sum;
+                    has[back] = 1;
+                }
+            }
+        }
+
+    }  // End of method 'ComputeCombination::evaluate()'
+
+
+
       /* Return a satTypeValueMap object, adding the new data generated when
        * calling this object.
        *
@@ -32,81 +186,195 @@ namespace gpstk
 
         try
         {
-            SatIDSet satRejectedSet;
-            LinearCombList linearList;
+            if( !isCompiled )
+            {
+                compile();
+            }
 
-            // Loop through all the satellites
-            for(satTypeValueMap::iterator it = gData.begin();
-                it != gData.end();
-                ++it)
+            for(std::map<SatelliteSystem, CombTable>::const_iterator
+                    itTab = combTables.begin();
+                itTab != combTables.end();
+                ++itTab)
             {
-                // get combination coefficient
-                linearList = systemCombs[(*it).first.system];
-                // Loop through all the defined linear combinations
-                for(auto pos = linearList.begin(); pos != linearList.end(); ++pos)
-                {
-                    double result(0.0);
-
-                    bool valid( true );
-                    
-                    if(debug)
-                        cout << pos->header << endl;
-
-                    // Read the information of each linear combination
-                    for(typeValueMap::const_iterator iter = pos->body.begin();
-                        iter != pos->body.end();
-                        ++iter)
-                    {
-                        double temp(0.0);
+                const CombTable& table( itTab->second );
 
-                        TypeID type(iter->first);
+                // The satellites of this system
+                rowData.clear();
+                for(satTypeValueMap::iterator it = gData.begin();
+                    it != gData.end();
+                    ++it)
+                {
+                    if( (*it).first.system == itTab->first )
+                    {
+                        rowData.push_back( &(*it).second );
+                    }
+                }
 
-                        if(debug)
-                            cout << type << endl;
+                const size_t nRows( rowData.size() );
+                if( nRows == 0 )
+                {
+                    continue;
+                }
 
+                const size_t nIn( table.inputs.size() );
+                block.assign(nRows*nIn, 0.0);
+                blockFlags.assign(nRows*nIn, 0);
 
-                        // if found 
-                        if( (*it).second.find(type) != (*it).second.end() )
+                // Both the inputs and the satellite types are sorted, so
+                // they are gathered in one merge pass
+                for(size_t r = 0; r < nRows; r++)
+                {
+                    const typeValueMap& tvMap( *rowData[r] );
+                    typeValueMap::const_iterator iter( tvMap.begin() );
+                    size_t j(0);
+                    while( j < nIn && iter != tvMap.end() )
+                    {
+                        if( iter->first < table.inputs[j] )
+                        {
+                            ++iter;
+                        }
+                        else if( table.inputs[j] < iter->first )
                         {
-                           temp = (*it).second[type];
+                            ++j;
                         }
-                        else // not found
+                        else
                         {
-                           if((*pos).optionalTypes.find(type) != (*pos).optionalTypes.end())
-                           {
-                               temp = 0.0;
-                           }
-                           else
-                           {
-                               valid = false;
-                               break;
-                           }
+                            block[r*nIn + j] = iter->second;
+                            blockFlags[r*nIn + j] = 1;
+                            ++iter;
+                            ++j;
                         }
+                    }
+                }
+
+                evaluate(table, nRows);
+
+                if(debug)
+                {
+                    for(size_t c = 0; c < table.outputs.size(); c++)
+                    {
+                        cout << table.outputs[c] << " valid:";
+                        for(size_t r = 0; r < nRows; r++)
+                            cout << " " << int(valid[c*nRows + r]);
+                        cout << endl;
+                    }
+                }
 
-                        if(debug)
+                // Store the results in the proper place
+                for(size_t c = 0; c < table.outputs.size(); c++)
+                {
+                    for(size_t r = 0; r < nRows; r++)
+                    {
+                        if( valid[c*nRows + r] )
                         {
-                            cout << (*iter).second << endl;
-                            cout << type << " value: " << temp << endl;
+                            (*rowData[r])[table.outputs[c]] =
+                                result[c*nRows + r];
                         }
+                    }
+                }
+            }
+
+            return gData;
+
+        }
+        catch(Exception& u)
+        {
+            // Throw an exception if something unexpected happens
+            ProcessingException e( getClassName() + ":" + u.what() );
+            GPSTK_THROW(e);
+        }
+
+    }  // End of method 'ComputeCombination::Process()'
+
 
-                        result = result + (*iter).second * temp;
+
+      /* Return a satTypeValueTable object, adding the new data generated
+       * when calling this object.
+       *
+       * @param gData     Data table holding the data.
+       */
+    satTypeValueTable& ComputeCombination::Process(satTypeValueTable& gData)
+        noexcept(false)
+    {
+
+        try
+        {
+            if( !isCompiled )
+            {
+                compile();
+            }
+
+            for(std::map<SatelliteSystem, CombTable>::const_iterator
+                    itTab = combTables.begin();
+                itTab != combTables.end();
+                ++itTab)
+            {
+                const CombTable& table( itTab->second );
+
+                // The rows of this system
+                rowIndex.clear();
+                for(size_t row = 0; row < gData.numSats(); row++)
+                {
+                    if( gData.getSats()[row].system == itTab->first )
+                    {
+                        rowIndex.push_back(row);
+                    }
+                }
+
+                const size_t nRows( rowIndex.size() );
+                if( nRows == 0 )
+                {
+                    continue;
+                }
+
+                const size_t nIn( table.inputs.size() );
+                block.assign(nRows*nIn, 0.0);
+                blockFlags.assign(nRows*nIn, 0);
+
+                // Gather the inputs column by column
+                for(size_t j = 0; j < nIn; j++)
+                {
+                    int slot( gData.typeSlot(table.inputs[j]) );
+                    if( slot < 0 )
+                    {
+                        continue;
                     }
 
-                    if(debug)
+                    const std::vector<double>& values( gData.column(slot) );
+                    const std::vector<char>& flags( gData.columnFlags(slot) );
+                    for(size_t r = 0; r < nRows; r++)
                     {
-                        cout << "valid:" << valid << endl;
-                        cout << "result:" << result << endl;
+                        if( flags[rowIndex[r]] )
+                        {
+                            block[r*nIn + j] = values[rowIndex[r]];
+                            blockFlags[r*nIn + j] = 1;
+                        }
                     }
+                }
+
+                evaluate(table, nRows);
 
-                    // Store the result in the proper place
-                    if( valid )
-                        (*it).second[pos->header] = result;
+                // Store the results in the proper place, the column is
+                // added with the first valid result
+                for(size_t c = 0; c < table.outputs.size(); c++)
+                {
+                    int slot(-1);
+                    for(size_t r = 0; r < nRows; r++)
+                    {
+                        if( valid[c*nRows + r] )
+                        {
+                            if( slot < 0 )
+                            {
+                                slot = static_cast<int>(
+                                    gData.addType(table.outputs[c]) );
+                            }
+                            gData.setValue( rowIndex[r], slot,
+                                            result[c*nRows + r] );
+                        }
+                    }
                 }
             }
 
-               // Remove satellites with missing data
-            gData.removeSatID(satRejectedSet);
-
             return gData;
 
         }
@@ -6,6 +6,7 @@
  */
 
 #include "gnssData.hpp"
+#include "SatTypeValueTable.hpp"
 
 #ifndef ComputeCombination_HPP
 #define ComputeCombination_HPP
@@ -99,6 +100,14 @@ namespace gpstk
        * were added to the object, i.e. in a FIFO (First Input - First Output)
        * basis. Therefore, you must be mindful of combination order.
        *
+       * The combinations of each system are compiled, the first time they
+       * are used, into a dense coefficient table over the types they read
+       * (sorted as in the combination bodies). An epoch is then processed
+       * system by system: the inputs of the satellites are gathered once
+       * into a block, and every combination is a row of coefficients
+       * applied to that block. The result of a combination is written back
+       * into the block, so later combinations read it as before.
+       *
        * @sa ComputeCombination.hpp, ComputePC.hpp, ModelObsFixedStation.hpp
        * and ModelObs.hpp, among others, for related classes.
        */
@@ -108,6 +117,7 @@ namespace gpstk
 
         /// Default constructor
         ComputeCombination()
+            : bdsfopt(0), isCompiled(false)
         { clearAll(); };
 
         /// add other methods here
@@ -123,6 +133,17 @@ namespace gpstk
             noexcept(false);
 
 
+         /** Return a satTypeValueTable object, adding the new data
+          *  generated when calling this object. Same results as the
+          *  satTypeValueMap version, the type columns are looked up
+          *  through the table slots.
+          *
+          * @param gData     Data table holding the data.
+          */
+        virtual satTypeValueTable& Process(satTypeValueTable& gData)
+            noexcept(false);
+
+
         virtual void Process(gnssRinex& gRin)
             noexcept(false)
         { 
@@ -133,6 +154,7 @@ namespace gpstk
         void setSysCombs(std::map<SatelliteSystem, LinearCombList>& sysCombs)
         {
             systemCombs = sysCombs;
+            isCompiled = false;
         };
 
         void addLinear(const SatelliteSystem& sys, LinearCombList& list)
@@ -141,11 +163,13 @@ namespace gpstk
             {
                 systemCombs[sys].push_back( (*it) );
             }
+            isCompiled = false;
         };
 
         void addLinear(const SatelliteSystem& sys, gnssLinearCombination& comb)
         {
             systemCombs[sys].push_back(comb);
+            isCompiled = false;
         };
 
         LinearCombList getLinear(const SatelliteSystem& sys)
@@ -163,6 +187,7 @@ namespace gpstk
         virtual ComputeCombination& clearAll(void)
         {
             systemCombs.clear();
+            isCompiled = false;
             return (*this);
         };
 
@@ -187,11 +212,58 @@ namespace gpstk
 
     private:
 
+         /// Linear combinations of one system, as a dense table
+        struct CombTable
+        {
+             /// Types read by the combinations, in ascending order
+            TypeIDVec inputs;
+
+             /// Type computed by each combination
+            TypeIDVec outputs;
+
+             /// Coefficients, row 'c' holds combination 'c' over 'inputs'
+            std::vector<double> coef;
+
+             /// Same layout as 'coef': 0 if the input is not a term of the
+             /// combination, 1 if it is an optional term, 2 if it is a term
+             /// that can not be missing
+            std::vector<char> terms;
+
+             /// Index in 'inputs' of each output, -1 if it is not read
+            std::vector<int> feedback;
+        };
+
+
+         /// Build 'combTables' from 'systemCombs'
+        void compile();
+
+
+         /// Evaluate the combinations of 'table' over the first 'nRows'
+         /// rows of 'block'/'blockFlags', results go to 'result'/'valid'
+        void evaluate(const CombTable& table, size_t nRows);
+
+
         int bdsfopt;
          /// List of linear combinations to compute
         std::map<SatelliteSystem, LinearCombList> systemCombs;
         // sys-<prefitType-coeffient>
         map<SatelliteSystem, map<TypeID, double>> sysTypeIonCoeff;
+
+         /// Compiled combinations of each system
+        std::map<SatelliteSystem, CombTable> combTables;
+
+         /// 'combTables' matches 'systemCombs'
+        bool isCompiled;
+
+         /// Work storage, kept between epochs: input values and flags of
+         /// the satellites (row-major, one row per satellite), results and
+         /// result flags (one row per combination)
+        std::vector<double> block;
+        std::vector<char> blockFlags;
+        std::vector<double> result;
+        std::vector<char> valid;
+        std::vector<typeValueMap*> rowData;
+        std::vector<size_t> rowIndex;
     }; // End class ComputeCombination
 
     //@}
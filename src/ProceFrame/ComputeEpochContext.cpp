@@ -0,0 +1,103 @@
+#pragma ident "$Id$"
+
+/**
+ * @file ComputeEpochContext.cpp
+ * This class computes the epoch-level values shared by the processors.
+ */
+
+#include "ComputeEpochContext.hpp"
+#include "SunPosition.hpp"
+#include "JulianDate.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+
+      // Return a string identifying this object.
+   std::string ComputeEpochContext::getClassName() const
+   { return "ComputeEpochContext"; }
+
+
+      /* Compute the context of an epoch.
+       *
+       * @param[in] time     Epoch (GPST)
+       */
+   std::shared_ptr<const EpochContext>
+      ComputeEpochContext::getContext(const CommonTime& time)
+      noexcept(false)
+   {
+
+      std::shared_ptr<EpochContext> context( new EpochContext );
+      EpochContext& c( *context );
+
+      c.epoch = time;
+
+      SunPosition sunPosition;
+      c.sunPosition = sunPosition.getPosition(time);
+
+      if( pRefSys == NULL || pSolSys == NULL )
+      {
+         return context;
+      }
+
+      try
+      {
+         c.utc = pRefSys->GPS2UTC(time);
+         c.tt = pRefSys->GPS2TT(time);
+
+         c.c2t = pRefSys->C2TRotation(c.utc);
+         c.t2c = transpose(c.c2t);
+
+         c.xPole = pRefSys->getXPole(c.utc);
+         c.yPole = pRefSys->getYPole(c.utc);
+         c.UT1mUTC = pRefSys->getUT1mUTC(c.utc);
+
+            // Sun and Moon in ICRS, unit: km
+         double jd_tt( JulianDate(c.tt).jd );
+
+         SolarSystem::Planet center(SolarSystem::Earth);
+
+         double rv_sun[6] = {0.0};
+         pSolSys->computeState(jd_tt, SolarSystem::Sun, center, rv_sun);
+
+         double rv_moon[6] = {0.0};
+         pSolSys->computeState(jd_tt, SolarSystem::Moon, center, rv_moon);
+
+            // unit: m
+         c.sunECI = Vec3(rv_sun[0], rv_sun[1], rv_sun[2]);
+         c.sunECI *= 1.0e+3;
+
+         Vec3 rMoonECI(rv_moon[0], rv_moon[1], rv_moon[2]);
+         rMoonECI *= 1.0e+3;
+
+         c.sunECEF = c.c2t*c.sunECI;
+         c.moonECEF = c.c2t*rMoonECI;
+
+         c.haveEarthOrientation = true;
+      }
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":" + u.what() );
+         GPSTK_THROW(e);
+      }
+
+      return context;
+
+   }  // End of method 'ComputeEpochContext::getContext()'
+
+
+      /* Attach the context of the epoch of 'gData' to its header.
+       *
+       * @param gData     Data object holding the data.
+       */
+   void ComputeEpochContext::Process(gnssRinex& gData)
+      noexcept(false)
+   {
+
+      gData.header.context = getContext(gData.header.epoch);
+
+   }  // End of method 'ComputeEpochContext::Process()'
+
+}  // End of namespace gpstk
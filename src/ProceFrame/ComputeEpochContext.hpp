@@ -0,0 +1,99 @@
+#pragma ident "$Id$"
+
+/**
+ * @file ComputeEpochContext.hpp
+ * This class computes the epoch-level values shared by the processors.
+ */
+
+#ifndef COMPUTE_EPOCH_CONTEXT_HPP
+#define COMPUTE_EPOCH_CONTEXT_HPP
+
+#include <memory>
+#include <string>
+
+#include "EpochContext.hpp"
+#include "ReferenceSystem.hpp"
+#include "SolarSystem.hpp"
+#include "DataStructures.hpp"
+#include "gnssData.hpp"
+
+namespace gpstk
+{
+
+      /** @addtogroup GPSsolutions */
+      //@{
+
+      /** This class computes the EpochContext of the current epoch and
+       *  attaches it to the gnssRinex header. It must run before the
+       *  processors that use it:
+       *
+       * @code
+       *   ComputeEpochContext epochContext;
+       *   epochContext.setReferenceSystem(refSys);
+       *   epochContext.setSolarSystem(solarSys);
+       *
+       *   epochContext.Process(gRin);
+       *   eclipsedSV.Process(gRin);
+       *   satPCenter.Process(gRin);
+       *   windUp.Process(gRin);
+       *   staTides.Process(gRin);
+       * @endcode
+       *
+       * Without a ReferenceSystem and a SolarSystem only the Sun position
+       * of the 'SunPosition' model is computed.
+       */
+   class ComputeEpochContext
+   {
+   public:
+
+         /// Default constructor
+      ComputeEpochContext()
+         : pRefSys(NULL), pSolSys(NULL)
+      {};
+
+
+      ComputeEpochContext& setReferenceSystem(ReferenceSystem& refSys)
+      { pRefSys = &refSys; return (*this); };
+
+
+      ComputeEpochContext& setSolarSystem(SolarSystem& solSys)
+      { pSolSys = &solSys; return (*this); };
+
+
+         /** Compute the context of an epoch.
+          *
+          * @param[in] time     Epoch (GPST)
+          */
+      std::shared_ptr<const EpochContext> getContext(const CommonTime& time)
+         noexcept(false);
+
+
+         /** Attach the context of the epoch of 'gData' to its header.
+          *
+          * @param gData     Data object holding the data.
+          */
+      virtual void Process(gnssRinex& gData)
+         noexcept(false);
+
+
+         /// Return a string identifying this object.
+      virtual std::string getClassName(void) const;
+
+
+         /// Destructor
+      virtual ~ComputeEpochContext() {};
+
+
+   private:
+
+      ReferenceSystem* pRefSys;
+
+      SolarSystem* pSolSys;
+
+   }; // End of class 'ComputeEpochContext'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // COMPUTE_EPOCH_CONTEXT_HPP
@@ -69,7 +69,7 @@ namespace gpstk
        */
    satTypeValueMap& ComputeIonoDelay::Process( const CommonTime& time,
                                                std::map<RinexSatID, TypeIDVec>& satShortTypes,
-                                               std::map<RinexSatID, int>& glonassFreqNo,
+                                               const std::map<RinexSatID, int>& glonassFreqNo,
                                                satTypeValueMap& gData )
       noexcept(false)
    {
@@ -112,7 +112,9 @@ namespace gpstk
                        double freq;
                        if(sysChar=='R')
                        {
-                           int k = glonassFreqNo[sat];
+                           std::map<RinexSatID, int>::const_iterator itK =
+                               glonassFreqNo.find(sat);
+                           int k = (itK != glonassFreqNo.end()) ? itK->second : 0;
                            freq = getFreq( (*stv).first.system, n, k);
                        }
                        else
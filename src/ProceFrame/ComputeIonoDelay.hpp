@@ -79,7 +79,7 @@ namespace gpstk
           */
       virtual satTypeValueMap& Process( const CommonTime& time,
                                         std::map<RinexSatID, TypeIDVec>& satShortTypes,
-                                        std::map<RinexSatID, int>& glonassFreqNo,
+                                        const std::map<RinexSatID, int>& glonassFreqNo,
                                         satTypeValueMap& gData )
          noexcept(false);
 
@@ -94,7 +94,7 @@ namespace gpstk
       {
           Process(gRin.header.epoch,
               gRin.header.satShortTypes,
-              gRin.header.glonassFreqNo,
+              gRin.header.glonassFreq(),
               gRin.body);
       };
 
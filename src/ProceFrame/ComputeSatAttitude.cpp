@@ -45,31 +45,34 @@ namespace gpstk
                 GPSTK_THROW(e);
             }
 
-            CommonTime utc( pRefSys->GPS2UTC(epoch) );
-
-            Matrix<double> t2cRaw( pRefSys->T2CMatrix(utc) );
-            Matrix<double> t2cDot( pRefSys->dT2CMatrix(utc) );
+            // Sun pos in ECI, unit: m
+            Vec3 rSunECI;
 
-            CommonTime tt( pRefSys->GPS2TT(epoch) );
-            double jd_tt( JulianDate(tt).jd );
+            if( epochContext &&
+                epochContext->haveEarthOrientation &&
+                epochContext->epoch == epoch )
+            {
+                rSunECI = epochContext->sunECI;
+            }
+            else
+            {
+                CommonTime tt( pRefSys->GPS2TT(epoch) );
+                double jd_tt( JulianDate(tt).jd );
 
-            // Sun pos and vel in ECI, unit: km, km/day
-            SolarSystem::Planet center(SolarSystem::Earth);
-            SolarSystem::Planet target(SolarSystem::Sun);
+                // Sun pos and vel in ECI, unit: km, km/day
+                SolarSystem::Planet center(SolarSystem::Earth);
+                SolarSystem::Planet target(SolarSystem::Sun);
 
-            double rv_sun[6] = {0.0};
-            pSolSys->computeState(jd_tt, target, center, rv_sun);
+                double rv_sun[6] = {0.0};
+                pSolSys->computeState(jd_tt, target, center, rv_sun);
 
-            // Sun pos in ECI, unit: m
-            Vector<double> rSunECI(3,0.0);
-            rSunECI(0) = rv_sun[0];
-            rSunECI(1) = rv_sun[1];
-            rSunECI(2) = rv_sun[2];
-            rSunECI *= 1.0e+3;
+                rSunECI = Vec3(rv_sun[0], rv_sun[1], rv_sun[2]);
+                rSunECI *= 1.0e+3;
+            }
 
 
             // Sat pos/vel in ECI
-            Vector<double> rSatECI(3,0.0), vSatECI(3,0.0);
+            Vec3 rSatECI, vSatECI;
 
 
             satYawDataMap currentYawData;
@@ -93,7 +96,7 @@ namespace gpstk
 
                 if(sat.system != SatelliteSystem::GPS) continue;
 
-                Vector<double> orbit( it->second );
+                const Vector<double>& orbit( it->second );
 
                 if(orbit.size() == 0)
                 {
@@ -104,42 +107,42 @@ namespace gpstk
                 {
                     for(int i=0; i<3; ++i)
                     {
-                        rSatECI(i+0) = orbit(i+0);
-                        vSatECI(i+0) = orbit(i+3);
+                        rSatECI[i] = orbit(i+0);
+                        vSatECI[i] = orbit(i+3);
                     }
                 }
 
-                double rSatECI2( dot(rSatECI,rSatECI) );
-                double vSatECI2( dot(vSatECI,vSatECI) );
+                double rSatECI2( rSatECI.dot(rSatECI) );
+                double vSatECI2( vSatECI.dot(vSatECI) );
 
                 // unit vector from Sat to Sun, ECI
-                Vector<double> sat2sun( normalize(rSunECI-rSatECI) );
+                Vec3 sat2sun( (rSunECI-rSatECI).unitVector() );
 
                 // unit vector from Sat to Earth, ECI
-                Vector<double> rk( ( (-1.0)*normalize(rSatECI) ) );
+                Vec3 rk( (-1.0)*rSatECI.unitVector() );
 
                 // rj = rk x sat2sun, ECI
-                Vector<double> rj( normalize(cross(rk,sat2sun)) );
+                Vec3 rj( rk.cross(sat2sun).unitVector() );
 
                 // ri = rj x rk, ECF
-                Vector<double> ri( normalize(cross(rj,rk)) );
+                Vec3 ri( rj.cross(rk).unitVector() );
 
 
                 // normal of orbit plane
-                Vector<double> unit_nop( normalize(cross(rSatECI,vSatECI)) );
+                Vec3 unit_nop( rSatECI.cross(vSatECI).unitVector() );
 
                 // morning of orbit plane
-                Vector<double> unit_mop( normalize(cross(rSunECI,unit_nop)) );
+                Vec3 unit_mop( rSunECI.cross(unit_nop).unitVector() );
 
                 // unit vector
-                Vector<double> unit_rsat( normalize(rSatECI) );
-                Vector<double> unit_rsun( normalize(rSunECI) );
+                Vec3 unit_rsat( rSatECI.unitVector() );
+                Vec3 unit_rsun( rSunECI.unitVector() );
 
                 // elevation angle of Sun above Sat orbit plane
-                double beta( PI/2.0 - std::acos(dot(unit_nop,unit_rsun)) );
+                double beta( PI/2.0 - std::acos(unit_nop.dot(unit_rsun)) );
 
                 // nominal yaw angle
-                nominalYaw = std::acos(dot(ri,vSatECI)/std::sqrt(vSatECI2));
+                nominalYaw = std::acos(ri.dot(vSatECI)/std::sqrt(vSatECI2));
                 if(beta > 0.0) nominalYaw = -nominalYaw;
 
                 // average orbital anglular velocity
@@ -155,8 +158,8 @@ namespace gpstk
                     satstr << sat.id;
                 }
 
-                Antenna antenna( pAntexReader->getAntenna(satstr.str(),epoch) );
-                string type( antenna.getAntennaType() );
+                string type( pAntexReader->getSatAntenna(satstr.str(),epoch)
+                                                       ->getAntennaType() );
 
                 bool blockIIR( type.find("BLOCK IIR") != string::npos );
                 bool blockIIF( type.find("BLOCK IIF") != string::npos );
@@ -165,13 +168,13 @@ namespace gpstk
                 double yawBias(0.0);
 
                 double mu(0.0);
-                if(dot(unit_rsat,unit_rsun) <= 0.0)
+                if(unit_rsat.dot(unit_rsun) <= 0.0)
                 {
-                    mu = PI/2.0 - std::acos(dot(unit_rsat,unit_mop));
+                    mu = PI/2.0 - std::acos(unit_rsat.dot(unit_mop));
                 }
                 else
                 {
-                    mu = PI/2.0 + std::acos(dot(unit_rsat,unit_mop));
+                    mu = PI/2.0 + std::acos(unit_rsat.dot(unit_mop));
                 }
 
                 double smu( std::sin(mu) );
@@ -324,8 +327,8 @@ namespace gpstk
                                           const double muRate,
                                           const double maxYawRate,
                                           const double yawBias,
-                                          const Vector<double>& unit_rsat,
-                                          const Vector<double>& unit_rsun,
+                                          const Vec3& unit_rsat,
+                                          const Vec3& unit_rsun,
                                           double& modeledYaw)
     {
         bool status( false );
@@ -370,7 +373,7 @@ namespace gpstk
         {
             status = true;
 
-            E = std::acos(dot(unit_rsat,unit_rsun));
+            E = std::acos(unit_rsat.dot(unit_rsun));
 
             if(mu > +0.5*PI && mu <= +1.0*PI)
             {
@@ -399,8 +402,8 @@ namespace gpstk
                                            const double muRate,
                                            const double maxYawRate,
                                            const double yawBias,
-                                           const Vector<double>& unit_rsat,
-                                           const Vector<double>& unit_rsun,
+                                           const Vec3& unit_rsat,
+                                           const Vec3& unit_rsun,
                                            double& modeledYaw)
     {
         bool status(false);
@@ -445,7 +448,7 @@ namespace gpstk
         {
             status = true;
 
-            E = PI - std::acos(dot(unit_rsat,unit_rsun));
+            E = PI - std::acos(unit_rsat.dot(unit_rsun));
 
             if(mu > -0.5*PI && mu <= 0.0)
             {
@@ -474,8 +477,8 @@ namespace gpstk
                                             const double muRate,
                                             const double maxYawRate,
                                             const double yawBias,
-                                            const Vector<double>& unit_rsat,
-                                            const Vector<double>& unit_rsun,
+                                            const Vec3& unit_rsat,
+                                            const Vec3& unit_rsun,
                                             double& modeledYaw)
     {
         bool status(false);
@@ -512,7 +515,7 @@ namespace gpstk
         {
             status = true;
 
-            E = PI - std::acos(dot(unit_rsat,unit_rsun));
+            E = PI - std::acos(unit_rsat.dot(unit_rsun));
 
             if(mu > -0.5*PI && mu <= 0.0)
             {
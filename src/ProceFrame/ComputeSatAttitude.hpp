@@ -59,7 +59,10 @@ namespace gpstk
 
         virtual void Process(gnssRinex& gData)
             noexcept(false)
-        { Process(gData.header.epoch, gData.body);  };
+        {
+            epochContext = gData.header.context;
+            Process(gData.header.epoch, gData.body);
+        };
 
 
         satYawDataMap getAttitude( const CommonTime& epoch,
@@ -83,8 +86,8 @@ namespace gpstk
                           const double muRate,
                           const double maxYawRate,
                           const double yawBias,
-                          const Vector<double>& unit_rsat,
-                          const Vector<double>& unit_rsun,
+                          const Vec3& unit_rsat,
+                          const Vec3& unit_rsun,
                           double& modeledYaw);
 
         bool nightManeuver(const CommonTime& epoch,
@@ -94,8 +97,8 @@ namespace gpstk
                            const double muRate,
                            const double maxYawRate,
                            const double yawBias,
-                           const Vector<double>& unit_rsat,
-                           const Vector<double>& unit_rsun,
+                           const Vec3& unit_rsat,
+                           const Vec3& unit_rsun,
                            double& modeledYaw);
 
         bool shadowManeuver(const CommonTime& epoch,
@@ -105,8 +108,8 @@ namespace gpstk
                             const double muRate,
                             const double maxYawRate,
                             const double yawBias,
-                            const Vector<double>& unit_rsat,
-                            const Vector<double>& unit_rsun,
+                            const Vec3& unit_rsat,
+                            const Vec3& unit_rsun,
                             double& modeledYaw);
 
     private:
@@ -120,6 +123,9 @@ namespace gpstk
         /// Pointer to AntexReader
         AntexReader* pAntexReader;
 
+        /// Context of the epoch being processed (may be empty)
+        std::shared_ptr<const EpochContext> epochContext;
+
         double nominalYaw;
         double modeledYaw;
 
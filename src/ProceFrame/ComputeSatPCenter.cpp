@@ -57,9 +57,8 @@ namespace gpstk
 		try
 		{
 
-			// Compute Sun position at this epoch
-			SunPosition sunPosition;
-			Triple sunPos(sunPosition.getPosition(time));
+			// Sun position at this epoch
+			Triple sunPos(getSunPosition(epochContext, time));
 
 			// Define a Triple that will hold satellite position, in ECEF
 			Triple svPos(0.0, 0.0, 0.0);
@@ -305,258 +304,62 @@ namespace gpstk
                 cout << "satStr:"<< sat.toString() << endl;
             }
 
-		    // Get satellite antenna information out of AntexReader object
-		    Antenna antenna( pAntexReader->getAntenna( sat.toString(), time ) );
+		    // Get satellite antenna information out of AntexReader object,
+		    // the antenna is shared, not copied
+		    std::shared_ptr<const Antenna> pAntenna(
+		                pAntexReader->getSatAntenna( sat.toString(), time ) );
+		    const Antenna& antenna( *pAntenna );
 
 		    // get the largest nadir angle for GPS
-		    int max = antenna.getAntennaNoAziMap()[freqType].size() - 1;
+		    int max = static_cast<int>( antenna.getNoAziSize(freqType) ) - 1;
             if(max > 0)
             {
 		        nadir = ( nadir > max) ? max: nadir;
             }
 		    double elev(90.0 - nadir);
 
-            Triple satAnt, var;
+		    // Antenna eccentricity for freqType, in satellite reference
+		    // system. NOTE: It is NOT in ECEF, it is in UEN!!!
+		    // and the phase center variation(only elevation).
+            double satAnt[3] = { 0.0, 0.0, 0.0 };
+            double var(0.0);
 
-            string antType( antenna.getAntennaType() );
-            try
+            bool haveEcc( antenna.getEccentricityUEN( freqType, satAnt ) );
+            if( !haveEcc || !antenna.getPCVariationUp( freqType, elev, var ) )
             {
-		        // Get antenna eccentricity for freqType , in satellite reference system.
-		        // NOTE: It is NOT in ECEF, it is in UEN!!!
-		        satAnt = ( antenna.getAntennaEccentricity( freqType ) );
-		        // Now, get the phase center variation(only elevation).
-		        var = ( antenna.getAntennaPCVariation( freqType, elev) );
+                var = 0.0;
 
-                if(debug)
-                {
-                    cout << "satAnt:" << satAnt << endl;
-                    cout << "var:" << var<< endl;
-                }
-            }
-            catch(InvalidRequest& e)
-            {
 				// we use the second frequency of GPS to correct others, chao hu/ragnwang
-                if(freqType==Antenna::G05)
+                if( freqType == Antenna::G05 ||
+                    freqType == Antenna::C01 || freqType == Antenna::C02 ||
+                    freqType == Antenna::C05 || freqType == Antenna::C06 ||
+                    freqType == Antenna::C07 || freqType == Antenna::C08 ||
+                    freqType == Antenna::E01 || freqType == Antenna::E05 ||
+                    freqType == Antenna::E06 || freqType == Antenna::E07 ||
+                    freqType == Antenna::E08 )
                 {
-		            int max = antenna.getAntennaNoAziMap()[Antenna::G02].size() - 1;
+		            int max = static_cast<int>(
+		                            antenna.getNoAziSize(Antenna::G02) ) - 1;
                     if(max > 0)
                     {
 		                nadir = ( nadir > max) ? max: nadir;
                     }
 		            double elev(90.0 - nadir);
 
-		            satAnt = ( antenna.getAntennaEccentricity( Antenna::G02) );
-		            var = ( antenna.getAntennaPCVariation( Antenna::G02, elev) );
-
-                    if(debug)
+                    // no correction if L2 is missing too
+                    if( !antenna.getEccentricityUEN( Antenna::G02, satAnt ) ||
+                        !antenna.getPCVariationUp( Antenna::G02, elev, var ) )
                     {
-                        cout << "satAnt:" << satAnt << endl;
-                        cout << "var:" << var<< endl;
+                        return 0.0;
                     }
                 }
-                else if(freqType==Antenna::C01)
-                {
-		            int max = antenna.getAntennaNoAziMap()[Antenna::G02].size() - 1;
-                    if(max > 0)
-                    {
-		                nadir = ( nadir > max) ? max: nadir;
-                    }
-		            double elev(90.0 - nadir);
-
-		            satAnt = ( antenna.getAntennaEccentricity( Antenna::G02) );
-		            var = ( antenna.getAntennaPCVariation( Antenna::G02, elev) );
-
-                    if(debug)
-                    {
-                        cout << "satAnt:" << satAnt << endl;
-                        cout << "var:" << var<< endl;
-                    }
-                }
-				else if (freqType == Antenna::C05)
-				{
-					int max = antenna.getAntennaNoAziMap()[Antenna::G02].size() - 1;
-					if (max > 0)
-					{
-						nadir = (nadir > max) ? max : nadir;
-					}
-					double elev(90.0 - nadir);
-
-					satAnt = (antenna.getAntennaEccentricity(Antenna::G02));
-					var = (antenna.getAntennaPCVariation(Antenna::G02, elev));
-
-					if (debug)
-					{
-						cout << "satAnt:" << satAnt << endl;
-						cout << "var:" << var << endl;
-					}
-				}
-				else if (freqType == Antenna::C06)
-				{
-					int max = antenna.getAntennaNoAziMap()[Antenna::G02].size() - 1;
-					if (max > 0)
-					{
-						nadir = (nadir > max) ? max : nadir;
-					}
-					double elev(90.0 - nadir);
-
-					satAnt = (antenna.getAntennaEccentricity(Antenna::G02));
-					var = (antenna.getAntennaPCVariation(Antenna::G02, elev));
-
-					if (debug)
-					{
-						cout << "satAnt:" << satAnt << endl;
-						cout << "var:" << var << endl;
-					}
-				}
-				else if (freqType == Antenna::C08)
-				{
-					int max = antenna.getAntennaNoAziMap()[Antenna::G02].size() - 1;
-					if (max > 0)
-					{
-						nadir = (nadir > max) ? max : nadir;
-					}
-					double elev(90.0 - nadir);
-
-					satAnt = (antenna.getAntennaEccentricity(Antenna::G02));
-					var = (antenna.getAntennaPCVariation(Antenna::G02, elev));
-
-					if (debug)
-					{
-						cout << "satAnt:" << satAnt << endl;
-						cout << "var:" << var << endl;
-					}
-				}
-				else if (freqType==Antenna::C02)
-				{
-					int max = antenna.getAntennaNoAziMap()[Antenna::G02].size() - 1;
-					if (max > 0)
-					{
-						nadir = (nadir > max) ? max : nadir;
-					}
-					double elev(90.0 - nadir);
-
-					satAnt = (antenna.getAntennaEccentricity(Antenna::G02));
-					var = (antenna.getAntennaPCVariation(Antenna::G02, elev));
-
-					if (debug)
-					{
-						cout << "satAnt:" << satAnt << endl;
-						cout << "var:" << var << endl;
-					}
-				}
-				else if (freqType == Antenna::C07)
-				{
-					int max = antenna.getAntennaNoAziMap()[Antenna::G02].size() - 1;
-					if (max > 0)
-					{
-						nadir = (nadir > max) ? max : nadir;
-					}
-					double elev(90.0 - nadir);
-
-					satAnt = (antenna.getAntennaEccentricity(Antenna::G02));
-					var = (antenna.getAntennaPCVariation(Antenna::G02, elev));
-
-					if (debug)
-					{
-						cout << "satAnt:" << satAnt << endl;
-						cout << "var:" << var << endl;
-					}
-				}
-				// galileo
-				else if (freqType == Antenna::E01)
-				{
-					int max = antenna.getAntennaNoAziMap()[Antenna::G02].size() - 1;
-					if (max > 0)
-					{
-						nadir = (nadir > max) ? max : nadir;
-					}
-					double elev(90.0 - nadir);
-
-					satAnt = (antenna.getAntennaEccentricity(Antenna::G02));
-					var = (antenna.getAntennaPCVariation(Antenna::G02, elev));
-
-					if (debug)
-					{
-						cout << "satAnt:" << satAnt << endl;
-						cout << "var:" << var << endl;
-					}
-				}
-				// galileo
-				else if (freqType == Antenna::E05)
-				{
-					int max = antenna.getAntennaNoAziMap()[Antenna::G02].size() - 1;
-					if (max > 0)
-					{
-						nadir = (nadir > max) ? max : nadir;
-					}
-					double elev(90.0 - nadir);
-
-					satAnt = (antenna.getAntennaEccentricity(Antenna::G02));
-					var = (antenna.getAntennaPCVariation(Antenna::G02, elev));
-
-					if (debug)
-					{
-						cout << "satAnt:" << satAnt << endl;
-						cout << "var:" << var << endl;
-					}
-				}
-				// galileo
-				else if (freqType == Antenna::E07)
-				{
-					int max = antenna.getAntennaNoAziMap()[Antenna::G02].size() - 1;
-					if (max > 0)
-					{
-						nadir = (nadir > max) ? max : nadir;
-					}
-					double elev(90.0 - nadir);
-
-					satAnt = (antenna.getAntennaEccentricity(Antenna::G02));
-					var = (antenna.getAntennaPCVariation(Antenna::G02, elev));
-
-					if (debug)
-					{
-						cout << "satAnt:" << satAnt << endl;
-						cout << "var:" << var << endl;
-					}
-				}
-				// galileo
-				else if (freqType == Antenna::E08)
-				{
-					int max = antenna.getAntennaNoAziMap()[Antenna::G02].size() - 1;
-					if (max > 0)
-					{
-						nadir = (nadir > max) ? max : nadir;
-					}
-					double elev(90.0 - nadir);
-
-					satAnt = (antenna.getAntennaEccentricity(Antenna::G02));
-					var = (antenna.getAntennaPCVariation(Antenna::G02, elev));
-
-					if (debug)
-					{
-						cout << "satAnt:" << satAnt << endl;
-						cout << "var:" << var << endl;
-					}
-				}
-				// galileo
-				else if (freqType == Antenna::E06)
-				{
-					int max = antenna.getAntennaNoAziMap()[Antenna::G02].size() - 1;
-					if (max > 0)
-					{
-						nadir = (nadir > max) ? max : nadir;
-					}
-					double elev(90.0 - nadir);
-
-					satAnt = (antenna.getAntennaEccentricity(Antenna::G02));
-					var = (antenna.getAntennaPCVariation(Antenna::G02, elev));
+            }
 
-					if (debug)
-					{
-						cout << "satAnt:" << satAnt << endl;
-						cout << "var:" << var << endl;
-					}
-				}
+            if(debug)
+            {
+                cout << "satAnt:" << satAnt[0] << " " << satAnt[1]
+                     << " " << satAnt[2] << endl;
+                cout << "var:" << var << endl;
             }
 
 		    // Change to ECEF(only PCO)
@@ -568,7 +371,7 @@ namespace gpstk
             }
 
 		    // Projection of "svAntenna" vector to line of sight vector rrho
-		    svPCcorr =  (rrho.dot(svAntenna)) - var[0];
+		    svPCcorr =  (rrho.dot(svAntenna)) - var;
 
         }
         catch(InvalidRequest& e)
@@ -594,6 +397,7 @@ namespace gpstk
     void ComputeSatPCenter::Process(gnssRinex& gData)
         noexcept(false)
     {
+        epochContext = gData.header.context;
         Process( gData.header.epoch, gData.header.satShortTypes, gData.body );
 
     }  // End of method 'ComputeWindUp::Process()'
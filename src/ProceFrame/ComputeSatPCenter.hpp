@@ -259,6 +259,11 @@ namespace gpstk
       Position nominalPos;
 
 
+         /// Context of the epoch being processed, from the gnssRinex
+         /// header (may be empty)
+      std::shared_ptr<const EpochContext> epochContext;
+
+
 
          /// Name of "PRN_GPS"-like file containing satellite data.
       std::string fileData;
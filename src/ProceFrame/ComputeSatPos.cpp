@@ -3,6 +3,7 @@
  */
 
 #include "ComputeSatPos.hpp"
+#include "SP3EphemerisStore.hpp"
 #include "YDSTime.hpp"
 #include "GNSSconstants.hpp"
 #include "DataStructures.hpp"
@@ -39,6 +40,11 @@ namespace gpstk
         {
             SatIDSet satRejectedSet;
 
+            // satellites computed together with the SP3 store
+            std::vector<satTypeValueMap::iterator> batchIts;
+            std::vector<SatID> batchSats;
+            std::vector<double> batchObs;
+
             // Loop through all the satellites
             for (satTypeValueMap::iterator it = gData.begin();
                 it != gData.end();
@@ -62,16 +68,18 @@ namespace gpstk
                     // firstly, find the optimal code observable for current satellite 
 
                     // 2-char Types for current satellite
-                    vector<TypeID> shortTypes = satShortTypes[sat];
-
                     TypeID codeType;
-                    for (int i = 0; i < shortTypes.size(); i++)
+                    auto itTypes = satShortTypes.find(it->first);
+                    if (itTypes != satShortTypes.end())
                     {
-                        string typeStr = shortTypes[i].asString();
-                        if (typeStr[0] == 'C')
+                        const TypeIDVec& shortTypes = itTypes->second;
+                        for (size_t i = 0; i < shortTypes.size(); i++)
                         {
-                            codeType = shortTypes[i];
-                            break;
+                            if (TypeID::tStrings[shortTypes[i].type][0] == 'C')
+                            {
+                                codeType = shortTypes[i];
+                                break;
+                            }
                         }
                     }
 
@@ -89,6 +97,15 @@ namespace gpstk
                         continue;
                     }
 
+                    // the SP3 satellites are computed all at once below
+                    if (pSP3Store != NULL)
+                    {
+                        batchIts.push_back(it);
+                        batchSats.push_back(sat);
+                        batchObs.push_back(obs);
+                        continue;
+                    }
+
                     // now, compute svPosVel
                     try
                     {
@@ -103,37 +120,7 @@ namespace gpstk
                         continue;
                     }
 
-                    //
-                    // transmitting-time related parameters
-                    //
-
-                    // relativity
-                    double relativity(0.0);
-                    relativity = svPosVel.computeRelativityCorrection() * C_MPS;
-
-                    // clock bias, clock drift
-                    double svClkBias(0.0), svClkDrift(0.0);
-
-                    svClkBias = svPosVel.getClockBias() * C_MPS;
-                    svClkDrift = svPosVel.getClockDrift() * C_MPS;
-
-                    // warning: the sign is changed!
-                    // see that in LinearCombination.
-                    (*it).second[TypeID::relativity] = -relativity;
-
-                    // Let's insert satellite clock bias at transmit time
-                    (*it).second[TypeID::cdtSat] = svClkBias;
-                    (*it).second[TypeID::cdtSatDot] = svClkDrift;
-
-                    // Let's insert satellite position at transmit time
-                    (*it).second[TypeID::satXECEF] = svPosVel.x[0];
-                    (*it).second[TypeID::satYECEF] = svPosVel.x[1];
-                    (*it).second[TypeID::satZECEF] = svPosVel.x[2];
-
-                    // Let's insert satellite velocity at transmit time
-                    (*it).second[TypeID::satVXECEF] = svPosVel.v[0];
-                    (*it).second[TypeID::satVYECEF] = svPosVel.v[1];
-                    (*it).second[TypeID::satVZECEF] = svPosVel.v[2];
+                    insertXvt(svPosVel, (*it).second);
 
                 }
                 catch (InvalidRequest& e)
@@ -148,6 +135,20 @@ namespace gpstk
 
             } // End of loop for(satTypeValueMap = gData.begin()...
 
+            if (!batchSats.empty())
+            {
+                std::vector<Xvt> xvts;
+                ComputeAtTransmitTime(time, batchSats, batchObs, xvts);
+
+                for (size_t i = 0; i < batchSats.size(); i++)
+                {
+                    if (xvts[i].health == Xvt::HealthStatus::Unavailable)
+                        satRejectedSet.insert(batchSats[i]);
+                    else
+                        insertXvt(xvts[i], (*batchIts[i]).second);
+                }
+            }
+
             // Remove satellites with missing data
             gData.removeSatID(satRejectedSet);
 
@@ -164,6 +165,113 @@ namespace gpstk
     }  // End of method 'ComputeSatPos::Process()'
 
 
+    // Insert the transmitting-time related parameters of a satellite
+    void ComputeSatPos::insertXvt(Xvt& svPosVel, typeValueMap& tvMap)
+    {
+        // relativity
+        double relativity(0.0);
+        relativity = svPosVel.computeRelativityCorrection() * C_MPS;
+
+        // clock bias, clock drift
+        double svClkBias(0.0), svClkDrift(0.0);
+
+        svClkBias = svPosVel.getClockBias() * C_MPS;
+        svClkDrift = svPosVel.getClockDrift() * C_MPS;
+
+        // warning: the sign is changed!
+        // see that in LinearCombination.
+        tvMap[TypeID::relativity] = -relativity;
+
+        // Let's insert satellite clock bias at transmit time
+        tvMap[TypeID::cdtSat] = svClkBias;
+        tvMap[TypeID::cdtSatDot] = svClkDrift;
+
+        // Let's insert satellite position at transmit time
+        tvMap[TypeID::satXECEF] = svPosVel.x[0];
+        tvMap[TypeID::satYECEF] = svPosVel.x[1];
+        tvMap[TypeID::satZECEF] = svPosVel.x[2];
+
+        // Let's insert satellite velocity at transmit time
+        tvMap[TypeID::satVXECEF] = svPosVel.v[0];
+        tvMap[TypeID::satVYECEF] = svPosVel.v[1];
+        tvMap[TypeID::satVZECEF] = svPosVel.v[2];
+    }
+
+
+    /* Compute the satellites of an epoch at their transmitting time
+     * with the SP3 store, all the satellites in one call for each
+     * light-time iteration. Satellites that cannot be computed get the
+     * "Unavailable" health; the reason is printed like in the single
+     * satellite version.
+     */
+    void ComputeSatPos::ComputeAtTransmitTime(const CommonTime& tr,
+        const std::vector<SatID>& sats,
+        const std::vector<double>& prs,
+        std::vector<Xvt>& xvts)
+        noexcept(false)
+    {
+        const size_t n(sats.size());
+        std::vector<CommonTime> transmit(n, tr), tt(n);
+        std::vector<bool> failed(n, false);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            transmit[i] -= prs[i] / C_MPS;
+            tt[i] = transmit[i];
+        }
+
+        for (int iter = 0; iter < 2; iter++)
+        {
+            pSP3Store->getXvt(sats, tt, segCache, xvts);
+
+            for (size_t i = 0; i < n; i++)
+            {
+                if (xvts[i].health == Xvt::HealthStatus::Unavailable)
+                {
+                    if (!failed[i])
+                    {
+                        // get the reason from the throwing version
+                        try
+                        {
+                            pSP3Store->getXvt(sats[i], tt[i]);
+                        }
+                        catch (InvalidRequest& e)
+                        {
+                            cerr << e << endl;
+                        }
+                        failed[i] = true;
+                    }
+                    continue;
+                }
+
+                tt[i] = transmit[i];
+                tt[i] -= (xvts[i].clkbias + xvts[i].relcorr);
+            }
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            if (failed[i])
+            {
+                xvts[i].health = Xvt::HealthStatus::Unavailable;
+                continue;
+            }
+
+            // transmitting time
+            double dt = std::abs(tr - tt[i]);
+
+            if (debug)
+            {
+                cout << getClassName() << ":" << dt << endl;
+            }
+
+            // earth rotation
+            rotateEarth(dt, xvts[i]);
+        }
+
+    }  // End of method 'ComputeSatPos::ComputeAtTransmitTime()'
+
+
     Xvt ComputeSatPos::ComputeAtTransmitTime(const CommonTime& tr,
         const double& pr,
         const RinexSatID/*SatID*/& sat)
@@ -180,7 +288,11 @@ namespace gpstk
         {
             try
             {
-                if (pEphStore != NULL)
+                if (pNavStore != NULL)
+                {
+                    svPosVel = pNavStore->getXvt(sat, tt, navCache);
+                }
+                else if (pEphStore != NULL)
                 {
                     svPosVel = pEphStore->getXvt(sat, tt);
                 }
@@ -5,6 +5,8 @@
 #define ComputeSatPos_HPP
 
 #include "XvtStore.hpp"
+#include "SP3EphemerisStore.hpp"
+#include "Rinex3EphemerisStore.hpp"
 #include "DataStructures.hpp"
 #include "gnssData.hpp"
 
@@ -30,7 +32,7 @@ namespace gpstk
          /// and satellites with elevation less than 10 degrees will be
          /// deleted.
         ComputeSatPos()
-            : pEphStore(NULL) 
+            : pEphStore(NULL), pSP3Store(NULL), pNavStore(NULL)
         {};
 
 
@@ -43,9 +45,11 @@ namespace gpstk
           *                      corrected from TGD effect.
           *
           */
-        ComputeSatPos( XvtStore<SatID>& ephStore)
+        ComputeSatPos( const XvtStore<SatID>& ephStore)
         {
             pEphStore = &ephStore;
+            pSP3Store = dynamic_cast<const SP3EphemerisStore*>(pEphStore);
+            pNavStore = dynamic_cast<const Rinex3EphemerisStore*>(pEphStore);
         };
 
 
@@ -74,6 +78,22 @@ namespace gpstk
                                           const RinexSatID/*SatID*/& sat)
             noexcept(false);
 
+         /** Compute the satellites of an epoch at their transmitting
+          *  time with the SP3 store, in one batch per light-time
+          *  iteration. The Xvt of a satellite that cannot be computed
+          *  has the "Unavailable" health.
+          *
+          * @param tr        Reception time.
+          * @param sats      Satellites.
+          * @param prs       Pseudorange of each satellite.
+          * @param xvts      Xvt of each satellite.
+          */
+        virtual void ComputeAtTransmitTime(const CommonTime& tr,
+                                           const std::vector<SatID>& sats,
+                                           const std::vector<double>& prs,
+                                           std::vector<Xvt>& xvts)
+            noexcept(false);
+
         virtual void rotateEarth(double dt, Xvt& svPosVel);
 
 
@@ -89,7 +109,22 @@ namespace gpstk
 
 
         /// Pointer to XvtStore<SatID> object
-        XvtStore<SatID>* pEphStore;
+        const XvtStore<SatID>* pEphStore;
+
+        /// pEphStore, when it is a SP3 store
+        const SP3EphemerisStore* pSP3Store;
+
+        /// Interpolation segments of the satellites in the SP3 store
+        SP3EphemerisStore::SegmentCache segCache;
+
+        /// pEphStore, when it is a broadcast ephemeris store
+        const Rinex3EphemerisStore* pNavStore;
+
+        /// Ephemerides of the satellites in the broadcast store
+        Rinex3EphemerisStore::EphCache navCache;
+
+        /// Insert the clock, relativity, position and velocity values
+        void insertXvt(Xvt& svPosVel, typeValueMap& tvMap);
 
     }; // End of class 'ComputeSatPos'
 
@@ -86,6 +86,10 @@ namespace gpstk
         ocean.setReferenceSystem(*pRefSys);
         // pole
         pole.setReferenceSystem(*pRefSys);
+        // Sun/Moon and Earth orientation of the epoch
+        solid.setEpochContext(gData.header.context);
+        ocean.setEpochContext(gData.header.context);
+        pole.setEpochContext(gData.header.context);
 
         // get receiver position from gnssDataHeader
         source = gData.header.source;
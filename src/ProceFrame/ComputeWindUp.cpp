@@ -86,9 +86,8 @@ namespace gpstk
 		try
 		{
 
-			// Compute Sun position at this epoch
-			SunPosition sunPosition;
-			Triple sunPos(sunPosition.getPosition(time));
+			// Sun position at this epoch
+			Triple sunPos(getSunPosition(epochContext, time));
 
 			// Define a Triple that will hold satellite position, in ECEF
 			Triple svPos(0.0, 0.0, 0.0);
@@ -284,22 +283,23 @@ namespace gpstk
         }
 
 		// Get vector from Earth mass center to receiver
-		Triple rxPos(nominalPos.X(), nominalPos.Y(), nominalPos.Z());
+		Vec3 rxPos(nominalPos.X(), nominalPos.Y(), nominalPos.Z());
 
 		// Vector from SV to Sun center of mass
-		Triple gps_sun( sunPosition-sat );
+		Vec3 satPos( sat );
+		Vec3 gps_sun( Vec3(sunPosition)-satPos );
 
 		// satellite-fixed system
-		Triple ri(0.0,0.0,0.0), rj(0.0,0.0,0.0), rk(0.0,0.0,0.0);
+		Vec3 ri(0.0,0.0,0.0), rj(0.0,0.0,0.0), rk(0.0,0.0,0.0);
 		//Triple ri2(0.0,0.0,0.0), rj2(0.0,0.0,0.0), rk2(0.0,0.0,0.0);
 
 		if(peclipse != NULL) // from eclipse
 		{
 			// Unitary vector from satellite to Earth mass center (ECEF)
-			rk = (-1.0)*(sat.unitVector());
+			rk = (-1.0)*(satPos.unitVector());
 
 			// ri = rj x rk (ECEF)
-			ri = (peclipse->getSatBodyX(satid)).unitVector();
+			ri = Vec3(peclipse->getSatBodyX(satid)).unitVector();
 
 			// rj = rk x ri: Rotation axis of solar panels (ECEF)
 			rj = (rk.cross(ri)).unitVector();
@@ -307,7 +307,7 @@ namespace gpstk
 		else // nominal attitude
 		{
 			// Define rk: Unitary vector from satellite to Earth mass center
-			rk = ( ( (-1.0)*(sat.unitVector()) ) );
+			rk = ( ( (-1.0)*(satPos.unitVector()) ) );
 
 			// Define rj: rj = rk x gps_sun, then make sure it is unitary
 			rj = ( (rk.cross(gps_sun)).unitVector() );
@@ -319,14 +319,14 @@ namespace gpstk
 		}
 
 		// Compute unitary vector vector from satellite to RECEIVER
-		Triple rrho( (rxPos-sat).unitVector() );
+		Vec3 rrho( (rxPos-satPos).unitVector() );
 
 		// Projection of "rk" vector to line of sight vector (rrho)
 		double zk(rrho.dot(rk));
 
 		// Get a vector without components on rk (i.e., belonging
 		// to ri, rj plane)
-		Triple dpp(rrho-zk*rk);
+		Vec3 dpp(rrho-zk*rk);
 
 		// Compute dpp components in ri, rj plane
 		double xk(dpp.dot(ri));
@@ -343,7 +343,7 @@ namespace gpstk
 
 		// Let's define a NORTH unitary vector in the Up, East, North
 		// (UEN) topocentric reference frame
-		Triple delta(0.0, 0.0, 1.0);
+		Vec3 delta(0.0, 0.0, 1.0);
 
 		// Rotate delta to XYZ reference frame
 		delta =
@@ -398,6 +398,7 @@ namespace gpstk
     void ComputeWindUp::Process(gnssRinex& gData)
         noexcept(false)
     {
+        epochContext = gData.header.context;
         Process( gData.header.epoch, gData.body );
 
     }  // End of method 'ComputeWindUp::Process()'
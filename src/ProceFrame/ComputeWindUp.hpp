@@ -18,6 +18,7 @@
 
 #include <string>
 #include "Triple.hpp"
+#include "Mat3.hpp"
 #include "Position.hpp"
 #include "SunPosition.hpp"
 #include "XvtStore.hpp"
@@ -241,6 +242,11 @@ namespace gpstk
       Position nominalPos;
 
 
+         /// Context of the epoch being processed, from the gnssRinex
+         /// header (may be empty)
+      std::shared_ptr<const EpochContext> epochContext;
+
+
          /// Pointer to object containing satellite antenna data, if available.
       AntexReader* pAntexReader;
 
@@ -51,7 +51,7 @@ namespace gpstk
          };
 
 
-         virtual void setDCBStore(BiasDataReader& dcbStore)
+         virtual void setDCBStore(const BiasDataReader& dcbStore)
          {
             pBiasStore = &dcbStore;
          };
@@ -78,7 +78,7 @@ namespace gpstk
           void getFirTChnel(const SatelliteSystem sys, 
               const TypeIDVec& typeVec, string& a, string& b);
 		 // Object that reads and stores MGEX DCB data
-          BiasDataReader* pBiasStore;
+          const BiasDataReader* pBiasStore;
           bool obsCorr;
           bool dcbCorr;
           bool bdsfopt;
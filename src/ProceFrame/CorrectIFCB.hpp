@@ -44,7 +44,7 @@ namespace fippp
 			Process(gRin.header.epoch, gRin.header.satShortTypes, gRin.body);
 		}
 
-		virtual void setIFCBStore(IFCBDataReader& ifcbStore)
+		virtual void setIFCBStore(const IFCBDataReader& ifcbStore)
 		{
 			pIFCBStore = &ifcbStore;
 		}
@@ -58,7 +58,7 @@ namespace fippp
 		~CorrectIFCB() {};
 
 	private:
-		IFCBDataReader* pIFCBStore;
+		const IFCBDataReader* pIFCBStore;
 	};
 }
 
@@ -47,7 +47,7 @@ namespace gpstk
              Process(gRin.header.epoch, gRin.header.satTypes, gRin.body);
          };
 
-         virtual void setBiasStore(BiasDataReader& dcbStore)
+         virtual void setBiasStore(const BiasDataReader& dcbStore)
          {
             pBiasStore = &dcbStore;
          };
@@ -63,7 +63,7 @@ namespace gpstk
       private:
 
 		 // Object that reads and stores MGEX DCB data
-		 BiasDataReader* pBiasStore;
+		 const BiasDataReader* pBiasStore;
          
    }; // End of class 'CorrectPhaseBiases'
 
@@ -15,6 +15,57 @@ using namespace std;
 namespace gpstk
 {
 
+    // Start a new epoch with antenna 'ant'
+    void CorrectRecBias::EpochPCV::reset( const Antenna& ant )
+    {
+        pAntenna = &ant;
+
+        elevation.clear();
+        azimuth.clear();
+
+        for(int i = 0; i < numSlots; i++)
+        {
+            table[i].done = false;
+        }
+    }
+
+
+    // Same result as Antenna::getAntennaPCVariation() for satellite
+    // 'index', with or without azimuth
+    Triple CorrectRecBias::EpochPCV::get( Antenna::frequencyType freq,
+                                          size_t index,
+                                          bool withAzimuth )
+        noexcept(false)
+    {
+        const int slot( 2*static_cast<int>(freq) + (withAzimuth ? 1 : 0) );
+        if( slot < 0 || slot >= numSlots || pAntenna == NULL )
+        {
+            InvalidRequest e("No phase center variation was found.");
+            GPSTK_THROW(e);
+        }
+
+        Values& values( table[slot] );
+        if( !values.done )
+        {
+            pAntenna->getPCVariations( freq,
+                                       elevation,
+                                       withAzimuth ? azimuth : noAzimuth,
+                                       values.pcv,
+                                       values.valid );
+            values.done = true;
+        }
+
+        if( index >= values.valid.size() || !values.valid[index] )
+        {
+            InvalidRequest e("No phase center variation was found.");
+            GPSTK_THROW(e);
+        }
+
+        return Triple( values.pcv[index], 0.0, 0.0 );
+    }
+
+
+
     // Return a string identifying this object.
     std::string CorrectRecBias::getClassName() const
     { return "CorrectRecBias"; }
@@ -76,10 +127,31 @@ namespace gpstk
 
             SatIDSet satRejectedSet;
 
+            // Directions of the satellites, so each phase center variation
+            // pattern is interpolated for all of them at once
+            epochPCV.reset( antenna );
+            if( antenna.isValid() )
+            {
+                for(satTypeValueMap::const_iterator it = gData.begin();
+                    it != gData.end();
+                    ++it)
+                {
+                    typeValueMap::const_iterator itElev(
+                                        (*it).second.find(TypeID::elevation) );
+                    typeValueMap::const_iterator itAzim(
+                                        (*it).second.find(TypeID::azimuth) );
+
+                    epochPCV.addSatellite(
+                        ( itElev != (*it).second.end() ) ? (*itElev).second : 0.0,
+                        ( itAzim != (*it).second.end() ) ? (*itAzim).second : 0.0 );
+                }
+            }
+
             // Loop through all the satellites
+            size_t iSat( 0 );
             for(satTypeValueMap::iterator it = gData.begin();
                 it != gData.end();
-                ++it)
+                ++it, ++iSat)
             {
                 SatID sat( it->first );
 
@@ -359,9 +431,8 @@ namespace gpstk
                     // Check if we have elevation information
                     if( (*it).second.find(TypeID::elevation) != (*it).second.end() )
                     {
-
-                        // Get elevation value
-                        double elev( (*it).second[TypeID::elevation] );
+                        // The elevation and azimuth of this satellite are
+                        // already in 'epochPCV'
 
                         // Check if azimuth is also required
                         if( !useAzimuth )
@@ -375,8 +446,8 @@ namespace gpstk
                                     try
                                     {
                                         L1Var 
-                                        = antenna.getAntennaPCVariation(Antenna::G01, 
-                                           elev );
+                                        = epochPCV.get(Antenna::G01, 
+                                           iSat );
                                     }
                                     catch(Exception& e)
                                     {
@@ -385,8 +456,8 @@ namespace gpstk
                                     try 
                                     {
                                         L2Var 
-                                        = antenna.getAntennaPCVariation(Antenna::G02, 
-                                           elev );
+                                        = epochPCV.get(Antenna::G02, 
+                                           iSat );
                                     }
                                     catch(Exception& e)
                                     {
@@ -395,13 +466,13 @@ namespace gpstk
                                     try 
                                     {
                                         L5Var 
-                                        = antenna.getAntennaPCVariation(Antenna::G05, 
-                                            elev );
+                                        = epochPCV.get(Antenna::G05, 
+                                            iSat );
                                     }
                                     catch(Exception& e)
                                     {
-										L5Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
+										L5Var = epochPCV.get(Antenna::G02,
+											iSat);
                                     }
                                 }
                                 else if( sat.system == SatelliteSystem::Glonass )
@@ -409,8 +480,8 @@ namespace gpstk
                                     try 
                                     {
                                         L1Var 
-                                        = antenna.getAntennaPCVariation(Antenna::R01, 
-                                            elev );
+                                        = epochPCV.get(Antenna::R01, 
+                                            iSat );
                                     }
                                     catch(Exception& e)
                                     {
@@ -419,8 +490,8 @@ namespace gpstk
                                     try 
                                     {
                                         L2Var 
-                                        = antenna.getAntennaPCVariation(Antenna::R02, 
-                                            elev );
+                                        = epochPCV.get(Antenna::R02, 
+                                            iSat );
                                     }
                                     catch(Exception& e)
                                     {
@@ -432,58 +503,58 @@ namespace gpstk
                                     try 
                                     {
                                         L1Var 
-                                        = antenna.getAntennaPCVariation(Antenna::E01, 
-                                            elev );
+                                        = epochPCV.get(Antenna::E01, 
+                                            iSat );
                                     }
                                     catch(Exception& e) 
                                     {
-										L1Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
+										L1Var = epochPCV.get(Antenna::G02,
+											iSat);
                                     }
                                     try 
                                     {
                                         L5Var 
-                                        = antenna.getAntennaPCVariation(Antenna::E05, 
-                                                elev );
+                                        = epochPCV.get(Antenna::E05, 
+                                                iSat );
                                     }
                                     catch(Exception& e) 
                                     {
-										L5Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
+										L5Var = epochPCV.get(Antenna::G02,
+											iSat);
                                     }
                                     try
                                     {
                                         L6Var 
-                                        = antenna.getAntennaPCVariation(Antenna::E06, 
-                                                                        elev );
+                                        = epochPCV.get(Antenna::E06, 
+                                                                        iSat );
                                     }
                                     catch(Exception& e) 
                                     {
-										L6Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
+										L6Var = epochPCV.get(Antenna::G02,
+											iSat);
                                     }
 
                                     try 
                                     {
                                         L7Var 
-                                        = antenna.getAntennaPCVariation(Antenna::E07, 
-                                            elev );
+                                        = epochPCV.get(Antenna::E07, 
+                                            iSat );
                                     }
                                     catch(Exception& e) 
                                     {
-										L7Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
+										L7Var = epochPCV.get(Antenna::G02,
+											iSat);
                                     }
                                     try 
                                     {
                                         L8Var
-                                        = antenna.getAntennaPCVariation(Antenna::E08, 
-                                            elev );
+                                        = epochPCV.get(Antenna::E08, 
+                                            iSat );
                                     }
                                     catch(Exception& e) 
                                     {
-										L8Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
+										L8Var = epochPCV.get(Antenna::G02,
+											iSat);
                                     }
                                 }
                                 else if( sat.system == SatelliteSystem::BeiDou ) // no PCV available
@@ -491,35 +562,35 @@ namespace gpstk
                                     try 
                                     {
                                         L2Var 
-                                        = antenna.getAntennaPCVariation(Antenna::C02, 
-                                            elev );
+                                        = epochPCV.get(Antenna::C02, 
+                                            iSat );
                                     }
                                     catch(Exception& e) 
                                     {
-										L2Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
+										L2Var = epochPCV.get(Antenna::G02,
+											iSat);
                                     }
                                     try 
                                     {
                                         L6Var 
-                                        = antenna.getAntennaPCVariation(Antenna::C06, 
-                                             elev );
+                                        = epochPCV.get(Antenna::C06, 
+                                             iSat );
                                     }
                                     catch(Exception& e) 
                                     {
-										L6Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
+										L6Var = epochPCV.get(Antenna::G02,
+											iSat);
                                     }
                                     try 
                                     {
                                         L7Var 
-                                        = antenna.getAntennaPCVariation(Antenna::C07, 
-                                            elev );
+                                        = epochPCV.get(Antenna::C07, 
+                                            iSat );
                                     }
                                     catch(Exception& e) 
                                     {
-										L7Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
+										L7Var = epochPCV.get(Antenna::G02,
+											iSat);
                                     }
                                 }
                                 else if( sat.system == SatelliteSystem::QZSS ) // no PCV available
@@ -527,28 +598,28 @@ namespace gpstk
                                     try 
                                     {
                                         L1Var 
-                                        = antenna.getAntennaPCVariation(Antenna::J01, 
-                                                elev );
+                                        = epochPCV.get(Antenna::J01, 
+                                                iSat );
                                         L2Var 
-                                        = antenna.getAntennaPCVariation(Antenna::J02, 
-                                                elev );
+                                        = epochPCV.get(Antenna::J02, 
+                                                iSat );
                                         L5Var 
-                                        = antenna.getAntennaPCVariation(Antenna::J05, 
-                                                elev );
+                                        = epochPCV.get(Antenna::J05, 
+                                                iSat );
                                         L6Var 
-                                        = antenna.getAntennaPCVariation(Antenna::J06, 
-                                                elev );
+                                        = epochPCV.get(Antenna::J06, 
+                                                iSat );
                                     }
                                     catch(Exception& e)
                                     {
-										L1Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
-										L2Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
-										L5Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
-										L6Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
+										L1Var = epochPCV.get(Antenna::G02,
+											iSat);
+										L2Var = epochPCV.get(Antenna::G02,
+											iSat);
+										L5Var = epochPCV.get(Antenna::G02,
+											iSat);
+										L6Var = epochPCV.get(Antenna::G02,
+											iSat);
                                     }
 
                                 }
@@ -557,18 +628,18 @@ namespace gpstk
                                     try 
                                     { 
                                         L5Var 
-                                        = antenna.getAntennaPCVariation(Antenna::I05, 
-                                                                        elev );
+                                        = epochPCV.get(Antenna::I05, 
+                                                                        iSat );
                                         L9Var 
-                                        = antenna.getAntennaPCVariation(Antenna::I09, 
-                                                                        elev );
+                                        = epochPCV.get(Antenna::I09, 
+                                                                        iSat );
                                     }
                                     catch(Exception& e) 
                                     {
-										L5Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
-										L9Var = antenna.getAntennaPCVariation(Antenna::G02,
-											elev);
+										L5Var = epochPCV.get(Antenna::G02,
+											iSat);
+										L9Var = epochPCV.get(Antenna::G02,
+											iSat);
                                     }
                                 }
                             }
@@ -589,10 +660,6 @@ namespace gpstk
                             if( (*it).second.find(TypeID::azimuth) !=
                                                             (*it).second.end() )
                             {
-
-                                // Get azimuth value
-                                double azim( (*it).second[TypeID::azimuth] );
-
                                 // Use a gentle fallback mechanism to get antenna
                                 // phase center variations
                                 try
@@ -601,77 +668,77 @@ namespace gpstk
                                     if( sat.system == SatelliteSystem::GPS )
                                     {
                                         L1Var 
-                                        = antenna.getAntennaPCVariation(Antenna::G01, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::G01, 
+                                                                        iSat, true );
                                         L2Var 
-                                        = antenna.getAntennaPCVariation(Antenna::G02, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::G02, 
+                                                                        iSat, true );
                                         L5Var 
-                                        = antenna.getAntennaPCVariation(Antenna::G05, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::G05, 
+                                                                        iSat, true );
                                     }
                                     else if( sat.system == SatelliteSystem::Glonass )
                                     {
                                         L1Var 
-                                        = antenna.getAntennaPCVariation(Antenna::R01, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::R01, 
+                                                                        iSat, true );
                                         L2Var 
-                                        = antenna.getAntennaPCVariation(Antenna::R02, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::R02, 
+                                                                        iSat, true );
                                     }
                                     else if( sat.system == SatelliteSystem::Galileo ) // no PCV available
                                     {
                                         L1Var 
-                                        = antenna.getAntennaPCVariation(Antenna::E01, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::E01, 
+                                                                        iSat, true );
                                         L5Var 
-                                        = antenna.getAntennaPCVariation(Antenna::E05, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::E05, 
+                                                                        iSat, true );
                                         L6Var 
-                                        = antenna.getAntennaPCVariation(Antenna::E06, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::E06, 
+                                                                        iSat, true );
                                         L7Var 
-                                        = antenna.getAntennaPCVariation(Antenna::E07, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::E07, 
+                                                                        iSat, true );
                                         L8Var 
-                                        = antenna.getAntennaPCVariation(Antenna::E08, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::E08, 
+                                                                        iSat, true );
                                     }
                                     else if( sat.system == SatelliteSystem::QZSS ) // no PCV available
                                     {
                                         L1Var 
-                                        = antenna.getAntennaPCVariation(Antenna::J01, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::J01, 
+                                                                        iSat, true );
                                         L2Var 
-                                        = antenna.getAntennaPCVariation(Antenna::J02, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::J02, 
+                                                                        iSat, true );
                                         L5Var 
-                                        = antenna.getAntennaPCVariation(Antenna::J05, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::J05, 
+                                                                        iSat, true );
                                         L6Var 
-                                        = antenna.getAntennaPCVariation(Antenna::J06, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::J06, 
+                                                                        iSat, true );
                                     }
                                     else if( sat.system == SatelliteSystem::BeiDou ) // no PCV available
                                     {
                                         L2Var 
-                                        = antenna.getAntennaPCVariation(Antenna::C02, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::C02, 
+                                                                        iSat, true );
                                         L6Var 
-                                        = antenna.getAntennaPCVariation(Antenna::C06, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::C06, 
+                                                                        iSat, true );
                                         L7Var 
-                                        = antenna.getAntennaPCVariation(Antenna::C07, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::C07, 
+                                                                        iSat, true );
                                     }
                                     else if( sat.system == SatelliteSystem::IRNSS ) // no PCV available
                                     {
                                         L5Var 
-                                        = antenna.getAntennaPCVariation(Antenna::I05, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::I05, 
+                                                                        iSat, true );
                                         L9Var 
-                                        = antenna.getAntennaPCVariation(Antenna::I09, 
-                                                                        elev, azim );
+                                        = epochPCV.get(Antenna::I09, 
+                                                                        iSat, true );
                                     }
                                 }
                                 catch(InvalidRequest& ir)
@@ -683,87 +750,87 @@ namespace gpstk
                                         if( sat.system == SatelliteSystem::GPS )
                                         {
                                             L1Var 
-												= antenna.getAntennaPCVariation(Antenna::G01,
-													elev, azim);
+												= epochPCV.get(Antenna::G01,
+													iSat, true);
                                             L2Var
-                                                = antenna.getAntennaPCVariation(Antenna::G02,
-                                                    elev, azim);
+                                                = epochPCV.get(Antenna::G02,
+                                                    iSat, true);
                                             L5Var 
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
                                         }
                                         else if( sat.system == SatelliteSystem::Glonass )
                                         {
                                             L1Var 
-                                            = antenna.getAntennaPCVariation(Antenna::R01,
-                                                                            elev );
+                                            = epochPCV.get(Antenna::R01,
+                                                                            iSat );
                                             L2Var 
-                                            = antenna.getAntennaPCVariation(Antenna::R02,
-                                                                            elev );
+                                            = epochPCV.get(Antenna::R02,
+                                                                            iSat );
                                         }
                                         else if( sat.system == SatelliteSystem::Galileo )
                                         {
                                             L1Var 
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
                                             L5Var 
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
                                             L6Var 
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
                                             L7Var 
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
 
                                             L8Var 
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
                                         }
                                         else if( sat.system == SatelliteSystem::QZSS )
                                         {
                                             L1Var 
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
                                             L2Var 
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
                                             L5Var 
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
                                             L6Var 
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
                                         }
                                         else if( sat.system == SatelliteSystem::BeiDou )
                                         {
                                             L1Var
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
 											L2Var
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
 											L5Var
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
 											L6Var
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
 											L7Var
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
 											L8Var
-												= antenna.getAntennaPCVariation(Antenna::G02,
-													elev, azim);
+												= epochPCV.get(Antenna::G02,
+													iSat, true);
                                         }
                                         else if( sat.system == SatelliteSystem::IRNSS )
                                         {
                                             L5Var 
-                                            = antenna.getAntennaPCVariation(Antenna::I05,
-                                                                            elev );
+                                            = epochPCV.get(Antenna::I05,
+                                                                            iSat );
                                             L9Var 
-                                            = antenna.getAntennaPCVariation(Antenna::I09,
-                                                                            elev );
+                                            = epochPCV.get(Antenna::I09,
+                                                                            iSat );
                                         }
                                     }
                                     catch(InvalidRequest& ir)
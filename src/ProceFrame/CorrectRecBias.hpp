@@ -254,6 +254,63 @@ namespace gpstk
         Triple L9PhaseCenter;
 
 
+            // Phase center variations of the receiver antenna for all the
+            // satellites of an epoch. A frequency is evaluated for every
+            // satellite with one Antenna::getPCVariations() call the first
+            // time one of them asks for it. The buffers are kept from one
+            // epoch to the next.
+        class EpochPCV
+        {
+        public:
+
+            EpochPCV()
+                : pAntenna(NULL)
+            {}
+
+                // Start a new epoch with antenna 'ant'
+            void reset( const Antenna& ant );
+
+                // Direction of the next satellite of the epoch
+            void addSatellite( double elev, double azim )
+            {
+                elevation.push_back(elev);
+                azimuth.push_back(azim);
+            }
+
+                // Same result as Antenna::getAntennaPCVariation() for
+                // satellite 'index', with or without azimuth
+            Triple get( Antenna::frequencyType freq,
+                        size_t index,
+                        bool withAzimuth = false )
+                noexcept(false);
+
+        private:
+
+                // One slot per frequency, without and with azimuth
+            static const int numSlots = 2*(Antenna::I09 + 1);
+
+            struct Values
+            {
+                Values() : done(false) {}
+
+                bool done;
+                std::vector<double> pcv;
+                std::vector<unsigned char> valid;
+            };
+
+            const Antenna* pAntenna;
+
+            std::vector<double> elevation;
+            std::vector<double> azimuth;
+            std::vector<double> noAzimuth;
+
+            Values table[numSlots];
+        };
+
+         /// Phase center variations of the current epoch
+        EpochPCV epochPCV;
+
+
     }; // End of class 'CorrectRecBias'
 
     //@}
@@ -100,8 +100,7 @@ namespace gpstk
 			// Since the algorithm of solar coordinates in GPSTK is  rough , the calculated 
 			// solar coordinates are not accurate, which result in several minites error of the 
 			// start/end time of the maneuver/shadow-crossing.
-			SunPosition sunPosition;
-			Triple sunPos(sunPosition.getPosition(epoch));
+			Triple sunPos(getSunPosition(epochContext, epoch));
 
 			// Define a Triple that will hold satellite position and
 			// velocity, in ECEF
@@ -239,8 +238,8 @@ namespace gpstk
 				}
 
 				// Get satellite antenna information out of AntexReader object
-				Antenna antenna( pAntexReader->getAntenna( sat.str(), epoch ) );
-				std::string satType(antenna.getAntennaType());
+				std::string satType( pAntexReader->getSatAntenna( sat.str(), epoch )
+				                                    ->getAntennaType() );
 
 				if(satType.find("GALILEO-FOC")!= string::npos)
 					satType = "GALILEO-2";
@@ -357,6 +356,7 @@ namespace gpstk
 
 		try
 		{
+			epochContext = gData.header.context;
 			Process(gData.header.epoch, gData.body);
 
 			return;
@@ -330,6 +330,10 @@ orbit plane, unit in degree.
 		/// Pointer to object containing satellite antenna data, if available.
 		AntexReader* pAntexReader;
 
+		/// Context of the epoch being processed, from the gnssRinex
+		/// header (may be empty)
+		std::shared_ptr<const EpochContext> epochContext;
+
 		/// Strategy when satellite is in maneuver or shadow crossing
 		int eclipseModel;
 
@@ -0,0 +1,91 @@
+#pragma ident "$Id$"
+
+/**
+ * @file EpochContext.hpp
+ * Earth orientation, Sun and Moon values shared by the processors of one
+ * epoch.
+ */
+
+#ifndef EPOCH_CONTEXT_HPP
+#define EPOCH_CONTEXT_HPP
+
+#include <memory>
+
+#include "CommonTime.hpp"
+#include "Triple.hpp"
+#include "SunPosition.hpp"
+#include "Mat3.hpp"
+
+namespace gpstk
+{
+
+      /** @addtogroup GPSsolutions */
+      //@{
+
+      /** Quantities that depend only on the epoch, computed once by
+       *  'ComputeEpochContext' and attached to the gnssRinex header, so
+       *  that the processors of the chain (satellite phase center, wind-up,
+       *  eclipse, tides, attitude) do not evaluate them each on their own.
+       *
+       * A processor uses the context only when its 'epoch' is the epoch
+       * being processed, and the Earth orientation part only when
+       * 'haveEarthOrientation' is set; otherwise it computes the values
+       * itself as before. The context must come from the same
+       * ReferenceSystem and SolarSystem objects the processors are
+       * configured with.
+       */
+   struct EpochContext
+   {
+      EpochContext()
+         : haveEarthOrientation(false),
+           xPole(0.0), yPole(0.0), UT1mUTC(0.0)
+      {};
+
+         /// Epoch (GPS time) the values are for
+      CommonTime epoch;
+
+         /// Sun position in ECEF (meters) from the 'SunPosition' model
+      Triple sunPosition;
+
+         /// The values below are set
+      bool haveEarthOrientation;
+
+         /// 'epoch' in UTC and TT
+      CommonTime utc, tt;
+
+         /// ICRS to ITRS rotation, and its transpose
+      Mat3 c2t, t2c;
+
+         /// Pole coordinates (arcseconds) and UT1-UTC (seconds)
+      double xPole, yPole, UT1mUTC;
+
+         /// Sun position in ICRS (meters) from the planetary ephemeris
+      Vec3 sunECI;
+
+         /// Sun and Moon positions in ITRS (meters) from the planetary
+         /// ephemeris
+      Vec3 sunECEF, moonECEF;
+
+   }; // End of struct 'EpochContext'
+
+
+      /** Sun position (ECEF, meters) of the 'SunPosition' model at
+       *  'time', taken from 'context' if it is the context of that epoch.
+       */
+   inline Triple getSunPosition( const std::shared_ptr<const EpochContext>& context,
+                                 const CommonTime& time )
+   {
+      if( context && context->epoch == time )
+      {
+         return context->sunPosition;
+      }
+
+      SunPosition sunPosition;
+      return sunPosition.getPosition(time);
+   }
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // EPOCH_CONTEXT_HPP
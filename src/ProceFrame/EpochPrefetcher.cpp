@@ -0,0 +1,140 @@
+#pragma ident "$ID: ragn wang 2023-06 $"
+
+#include <sstream>
+
+#include "EpochPrefetcher.hpp"
+
+using namespace std;
+
+namespace fippp
+{
+	EpochPrefetcher::EpochPrefetcher(const Producer& p, int depth)
+		: producer(p), maxSize(depth > 0 ? depth : 0),
+		stopping(false), finished(false)
+	{
+		if (maxSize > 0)
+			worker = std::thread(&EpochPrefetcher::run, this);
+	}
+
+	/// <summary>
+	/// prefetch thread: prepare epochs until the end of the file, or
+	/// until the consumer stops, never more than 'maxSize' ahead
+	/// </summary>
+	void EpochPrefetcher::run()
+	{
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(queueMutex);
+				notFull.wait(lock, [this]
+					{ return stopping || queue.size() < maxSize; });
+				if (stopping)
+					return;
+			}
+
+			PrefetchedEpoch epoch;
+			epoch.status = PrefetchedEpoch::Ready;
+			try
+			{
+				producer(epoch);
+			}
+			catch (Exception& e)
+			{
+				ostringstream os;
+				os << e;
+				epoch.status = PrefetchedEpoch::Failed;
+				epoch.message = os.str();
+			}
+			catch (std::exception& e)
+			{
+				epoch.status = PrefetchedEpoch::Failed;
+				epoch.message = e.what();
+			}
+
+			// nothing is read after the end or a failure
+			bool last(epoch.status == PrefetchedEpoch::End ||
+				epoch.status == PrefetchedEpoch::Failed);
+			{
+				std::lock_guard<std::mutex> lock(queueMutex);
+				queue.push_back(std::move(epoch));
+			}
+			notEmpty.notify_one();
+
+			if (last)
+				return;
+		}
+
+	}	// End of method 'EpochPrefetcher::run()'
+
+	/// <summary>
+	/// get the next epoch in reading order
+	/// </summary>
+	/// <param name="epoch"> the epoch </param>
+	/// <returns> false if the end was already handed out </returns>
+	bool EpochPrefetcher::pop(PrefetchedEpoch& epoch)
+	{
+		if (finished)
+			return false;
+
+		if (maxSize == 0)
+		{
+			epoch = PrefetchedEpoch();
+			epoch.status = PrefetchedEpoch::Ready;
+			try
+			{
+				producer(epoch);
+			}
+			catch (Exception& e)
+			{
+				ostringstream os;
+				os << e;
+				epoch.status = PrefetchedEpoch::Failed;
+				epoch.message = os.str();
+			}
+			catch (std::exception& e)
+			{
+				epoch.status = PrefetchedEpoch::Failed;
+				epoch.message = e.what();
+			}
+		}
+		else
+		{
+			{
+				std::unique_lock<std::mutex> lock(queueMutex);
+				notEmpty.wait(lock, [this] { return !queue.empty(); });
+				epoch = std::move(queue.front());
+				queue.pop_front();
+			}
+			notFull.notify_one();
+		}
+
+		if (epoch.status == PrefetchedEpoch::End ||
+			epoch.status == PrefetchedEpoch::Failed)
+			finished = true;
+
+		return true;
+
+	}	// End of method 'EpochPrefetcher::pop()'
+
+	/// <summary>
+	/// stop the prefetch thread, the epochs not handed out are dropped
+	/// </summary>
+	void EpochPrefetcher::stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			stopping = true;
+			queue.clear();
+		}
+		notFull.notify_all();
+
+		if (worker.joinable())
+			worker.join();
+
+	}	// End of method 'EpochPrefetcher::stop()'
+
+	EpochPrefetcher::~EpochPrefetcher()
+	{
+		stop();
+	}
+}
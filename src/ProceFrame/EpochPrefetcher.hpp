@@ -0,0 +1,106 @@
+#pragma ident "$ID: ragn wang 2023-06 $"
+
+#ifndef FiPPP_EpochPrefetcher_HPP
+#define FiPPP_EpochPrefetcher_HPP
+
+// Epoch prefetcher runs the front stages of the processing chain
+// (reading the RINEX record, building the gnssRinex, decimation and the
+// system/satellite/observation filters) on a thread of its own, a few
+// epochs ahead of the filter. Those stages do not depend on the filter
+// state, so reading and parsing are hidden behind the estimation.
+// The epochs are handed over in the order they are read.
+//
+#include <string>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "CommonTime.hpp"
+#include "gnssData.hpp"
+
+using namespace gpstk;
+
+namespace fippp
+{
+	/// one epoch prepared by the front stages
+	struct PrefetchedEpoch
+	{
+		enum Status
+		{
+			Ready = 0,	// gRin is ready for the filter
+			Skipped,	// epoch rejected, 'message' tells why
+			ReadError,	// record could not be read, 'message' tells why
+			Failed,		// processing error, stop the station
+			End			// end of the observation file
+		};
+
+		PrefetchedEpoch() : status(End) {};
+
+		Status status;
+
+		/// epoch of the RINEX record
+		CommonTime time;
+
+		/// the data, for 'Ready'
+		std::unique_ptr<gnssRinex> gRin;
+
+		/// text to print for 'Skipped', 'ReadError' and 'Failed'
+		std::string message;
+	};
+
+	class EpochPrefetcher
+	{
+	public:
+
+		/// fills the next epoch; set status 'End' when there is no more
+		typedef std::function<void(PrefetchedEpoch&)> Producer;
+
+		/// <summary>
+		/// start preparing epochs with 'producer'
+		/// </summary>
+		/// <param name="producer"> front stages of the chain, only
+		/// called from the prefetch thread </param>
+		/// <param name="depth"> number of epochs prepared ahead of the
+		/// consumer, 0 runs the producer in pop() without thread </param>
+		EpochPrefetcher(const Producer& producer, int depth);
+
+		/// get the next epoch, false once the 'End' epoch was handed out
+		bool pop(PrefetchedEpoch& epoch);
+
+		/// stop preparing epochs and wait for the thread
+		void stop();
+
+		~EpochPrefetcher();
+
+	private:
+
+		void run();
+
+		Producer producer;
+
+		size_t maxSize;
+
+		std::deque<PrefetchedEpoch> queue;
+
+		std::mutex queueMutex;
+		std::condition_variable notEmpty;
+		std::condition_variable notFull;
+
+		// set by the consumer
+		bool stopping;
+
+		// 'End' was handed out
+		bool finished;
+
+		std::thread worker;
+
+		// no copy
+		EpochPrefetcher(const EpochPrefetcher&);
+		EpochPrefetcher& operator=(const EpochPrefetcher&);
+	};
+}
+
+#endif // !FiPPP_EpochPrefetcher_HPP
@@ -26,6 +26,9 @@
 // 
 //  modify Prepare
 //
+//  look the column of a variable up in 'varIndex' instead of walking
+//  'currentUnkSet', and fill the geometry matrix as sparse rows
+//
 //============================================================================
 
 
@@ -144,6 +147,9 @@ namespace gpstk
          // Prepare set of current unknowns and set of current equations
       currentUnkSet = prepareEquations(gData);
 
+         // Index the columns of the unknowns
+      setUpColumns();
+
          // Compute phiMatrix and qMatrix
       getPhiQ(gData);
 
@@ -299,18 +305,92 @@ namespace gpstk
 
 
 
+      // Index the columns of the current unknowns
+   void EquSys::setUpColumns()
+   {
+
+      const int numVar( currentUnkSet.size() );
+
+      if( freeSlots == 0 )
+      {
+         varIndex.clear();
+         varIndex.reserve( numVar );
+
+         int col(0);
+         for( VariableSet::const_iterator itVar = currentUnkSet.begin();
+              itVar != currentUnkSet.end();
+              ++itVar )
+         {
+            varIndex[*itVar] = col;
+            ++col;
+         }
+
+         numColumns = numVar;
+
+         return;
+      }
+
+         // The unknowns take the columns 0 .. numVar-1. An old unknown
+         // keeps its column if it is one of them; the others, i.e. the
+         // old ones beyond numVar and the new ones, fill the holes left
+         // by the unknowns that set.
+      VariableIndexMap oldIndex;
+      oldIndex.swap( varIndex );
+      varIndex.reserve( numVar );
+
+      std::vector<char> taken( numVar, 0 );
+      std::vector<const Variable*> pending;
+      for( VariableSet::const_iterator itVar = currentUnkSet.begin();
+           itVar != currentUnkSet.end();
+           ++itVar )
+      {
+         VariableIndexMap::const_iterator itOld = oldIndex.find( *itVar );
+         if( itOld != oldIndex.end() && itOld->second < numVar )
+         {
+            varIndex[*itVar] = itOld->second;
+            taken[itOld->second] = 1;
+         }
+         else
+         {
+            pending.push_back( &(*itVar) );
+         }
+      }
+
+      int hole(0);
+      for( size_t k = 0; k < pending.size(); k++ )
+      {
+         while( taken[hole] )
+         {
+            ++hole;
+         }
+         varIndex[*pending[k]] = hole;
+         taken[hole] = 1;
+      }
+
+         // Spare columns: grow when full, compact when too many are free
+      if( numVar > numColumns || numColumns - numVar > 2*freeSlots )
+      {
+         numColumns = numVar + freeSlots;
+      }
+
+      return;
+
+   }  // End of method 'EquSys::setUpColumns()'
+
+
+
       // Compute PhiMatrix
    void EquSys::getPhiQ( const sourceRinex& gData )
    {
-    
-         // Set to store the variables that already prepared
-      VariableSet varUnkPrepared;
 
-      const int numVar( currentUnkSet.size() );
+      const int numVar( numColumns );
+
+         // Whether the variable of each column is already prepared
+      std::vector<char> varPrepared( numVar, 0 );
 
-         // Resize phiMatrix and qMatrix
-      phiMatrix.resize( numVar, numVar, 0.0);
-      qMatrix.resize( numVar, numVar, 0.0);
+         // Resize phiVector and qVector
+      phiVector.resize( numVar, 0.0);
+      qVector.resize( numVar, 0.0);
 
          // Let's get current time
       CommonTime epoch(gData.header.epoch);
@@ -322,19 +402,23 @@ namespace gpstk
       {
              // Now, let's visit all Variables and the corresponding 
              // coefficient in this equation description
-          for( auto vc: (*itEq).body)
+          for( const auto& vc: (*itEq).body)
           {
-                // We will work with a copy of current Variable
-             Variable var( vc.first );
-             Coefficient coef( vc.second );
-
+             const Variable& var( vc.first );
 
-                // find this current varialbe in 'varUnkPrepared'
-             VariableSet::const_iterator itVar=varUnkPrepared.find( var );
-
-                // If not found, then you should 'prepare' the stochastic model
-                // for this variable
-             if( itVar == varUnkPrepared.end() )
+                // Now, Let's get the position of this variable in 
+                // 'currentUnkSet'
+             VariableIndexMap::const_iterator itCol = varIndex.find( var );
+             if( itCol == varIndex.end() )
+             {
+                InvalidEquSys e("variable of an equation is not an unknown");
+                GPSTK_THROW(e);
+             }
+             const int i( itCol->second );
+
+                // If not prepared, then you should 'prepare' the stochastic
+                // model for this variable
+             if( !varPrepared[i] )
              {
                 SatID varSat(var.getSatellite());
                 SourceID varSource(var.getSource());
@@ -346,40 +430,41 @@ namespace gpstk
                                         varSat, 
                                         tData);
 
-                   // Now, Let's get the position of this variable in 
-                   // 'currentUnkSet'
-                int i(0);
-                VariableSet::const_iterator itVar1=currentUnkSet.begin();
-                while( (*itVar1) != var )
-                {
-                   i++;
-                   itVar1++;
-                }
                    // Now, check if this is an 'old' variable
                 if( oldUnkSet.find( var ) != oldUnkSet.end() )
                 {
                       // This variable is 'old'; compute its phi and q values
-                   phiMatrix(i,i) = var.getModel()->getPhi();
-                   qMatrix(i,i)   = var.getModel()->getQ();
+                   phiVector(i) = var.getModel()->getPhi();
+                   qVector(i)   = var.getModel()->getQ();
                 }
                 else
                 {
                       // This variable is 'new', so let's use its initial variance
                       // instead of its stochastic model
-                   phiMatrix(i,i) = 0.0;
-                   qMatrix(i,i)   = var.getInitialVariance();
+                   phiVector(i) = 0.0;
+                   qVector(i)   = var.getInitialVariance();
 
                 }
 
-                   // At last, insert current variable into 'varUnkPrepared'
-                varUnkPrepared.insert(var);
+                   // At last, mark current variable as prepared
+                varPrepared[i] = 1;
 
-             }  // End of 'if(itVar==varUnkPrepared.end())'
+             }  // End of 'if( !varPrepared[i] )'
                
           }  // End of 'for( VarCoeffMap::const_iterator varIt = ...'
 
       }  // End of 'for( std::set<Equation>::const_iterator itEq = ...'
 
+         // The spare columns keep their state
+      for( int i = 0; i < numVar; i++ )
+      {
+         if( !varPrepared[i] )
+         {
+            phiVector(i) = 1.0;
+            qVector(i)   = 0.0;
+         }
+      }
+
 
       return;
 
@@ -390,9 +475,6 @@ namespace gpstk
    void EquSys::getPrefitGeometryWeights( sourceRinex& gData )
    {
 
-         // Declare temporal storage for values
-      std::vector<double> tempPrefit;
-
          // Total number of the current equations
       int numEqu( currentEquSet.size() );
       int numVar( currentUnkSet.size() );
@@ -402,9 +484,11 @@ namespace gpstk
          GPSTK_THROW(InvalidEquSys("currentUnkSet is empty, you must set it first!"));
       }
 
-         // Resize hMatrix and rMatrix
-      hMatrix.resize( numEqu, numVar, 0.0);
-      rMatrix.resize( numEqu, numEqu, 0.0);
+         // Resize hRows, rVector and measVector
+      hRows.clear( numColumns );
+      hRows.reserve( numEqu, numEqu * (*currentEquSet.begin()).body.size() );
+      rVector.resize( numEqu, 0.0 );
+      measVector.resize( numEqu, 0.0 );
 
          // We need an equation index
       int row(0);
@@ -415,36 +499,38 @@ namespace gpstk
            ++itEq )
       {
             // Get the type value data from the header of the equation
-         typeValueMap tData( (*itEq).header.typeValueData );
+         const typeValueMap& tData( (*itEq).header.typeValueData );
 
             // Get the independent type of this equation
          TypeID indepType( (*itEq).header.indTerm.getType() );
             // Temp measurement
-         double tempMeas(tData(indepType));
+         measVector(row) = tData.getValue(indepType);
 
             // First, fill weights matrix
             // Check if current 'tData' has weight info. If you don't want those
             // weights to get into equations, please don't put them in GDS
-         if( tData.find(TypeID::weight) != tData.end() )
+         typeValueMap::const_iterator itWeight = tData.find(TypeID::weight);
+         if( itWeight != tData.end() )
          {
                // Weights matrix = Equation weight * observation weight
-            rMatrix(row,row) = (*itEq).header.constWeight * tData(TypeID::weight);
+            rVector(row) = (*itEq).header.constWeight * itWeight->second;
          }
          else
          {
                // Weights matrix = Equation weight
-            rMatrix(row,row) = (*itEq).header.constWeight;
+            rVector(row) = (*itEq).header.constWeight;
          }
 
             // Second, fill geometry matrix: Look for equation coefficients
             
             // Now, let's visit all Variables and the corresponding 
-            // coefficient in this equation description
-         for( auto vc: (*itEq).body )
+            // coefficient in this equation description. They come in the
+            // order of 'currentUnkSet', so without spare columns the
+            // columns of the row increase
+         for( const auto& vc: (*itEq).body )
          {
-               // We will work with a copy of current Variable
-            Variable var( vc.first );
-            Coefficient coef( vc.second );
+            const Variable& var( vc.first );
+            const Coefficient& coef( vc.second );
 
                // Coefficient values
             double tempCoef(0.0);
@@ -456,18 +542,13 @@ namespace gpstk
             else
             {
                   // Look for the coefficient in 'tdata'
-/*
-                  // Get type of current unknown
-               TypeID type( var.getType() );
-*/
-
-               TypeID type = coef.coeffType;
+               typeValueMap::const_iterator itCoef = tData.find(coef.coeffType);
 
                   // Check if this type has an entry in current GDS type set
-               if( tData.find(type) != tData.end() )
+               if( itCoef != tData.end() )
                {
-                     // If type was found, insert value into hMatrix
-                  tempCoef = tData(type);
+                     // If type was found, insert value into hRows
+                  tempCoef = itCoef->second;
                }
                else
                {
@@ -480,30 +561,25 @@ namespace gpstk
 
                // Now, Let's get the position of this variable in 
                // 'currentUnkSet'
-            int col(0);
-            VariableSet::const_iterator itVar2=currentUnkSet.begin();
-            while( (*itVar2) != var )
+            VariableIndexMap::const_iterator itCol = varIndex.find( var );
+            if( itCol == varIndex.end() )
             {
-               col++;
-               itVar2++;
+               InvalidEquSys e("variable of an equation is not an unknown");
+               GPSTK_THROW(e);
             }
 
                // Set the geometry matrix
-            hMatrix(row, col) = tempCoef;
+            hRows.add( itCol->second, tempCoef );
               
          }  // End of 'for( VarCoeffMap::const_iterator varIt = ...'
 
-            // insert current 'measurment vector' into 'tempPrefit'
-         tempPrefit.push_back(tempMeas);
+         hRows.endRow();
 
             // Increment row number
          ++row;
 
       }  // End of 'for( std::set<Equation>::const_iterator itEq = ...'
 
-         // Then, finally get prefit residuals into appropriate gpstk::Vector
-      measVector = tempPrefit;
-
       return;
 
    }  // End of method 'EquSys::getPrefitGeometryWeights()'
@@ -530,6 +606,28 @@ namespace gpstk
 
 
 
+      /* Return the number of columns of the geometry matrix, the unknowns
+       * plus the spare columns.
+       *
+       * \warning You must call method Prepare() first, otherwise this
+       * method will throw an InvalidEquSys exception.
+       */
+   int EquSys::getNumColumns() const
+      noexcept(false)
+   {
+
+         // If the object as not ready, throw an exception
+      if (!isPrepared)
+      {
+         GPSTK_THROW(InvalidEquSys("EquSys is not prepared"));
+      }
+
+      return numColumns;
+
+   }  // End of method 'EquSys::getNumColumns()'
+
+
+
       /* Return the set containing all variables being processed.
        *
        * \warning You must call method Prepare() first, otherwise this
@@ -665,13 +763,32 @@ namespace gpstk
       {
          GPSTK_THROW(InvalidEquSys("EquSys is not prepared"));
       }
-      return hMatrix;
+      return hRows.toMatrix();
    }  // End of method 'EquSys::getGeometryMatrix()'
 
 
 
+      /* Get geometry matrix in sparse rows, given the current equation
+       * system definition and the GDS' involved.
+       *
+       * \warning You must call method Prepare() first, otherwise this
+       * method will throw an InvalidEquSys exception.
+       */
+   SparseRowMatrix EquSys::getGeometryRows() const
+      noexcept(false)
+   {
+         // If the object as not ready, throw an exception
+      if (!isPrepared)
+      {
+         GPSTK_THROW(InvalidEquSys("EquSys is not prepared"));
+      }
+      return hRows;
+   }  // End of method 'EquSys::getGeometryRows()'
+
+
+
       /* Get weights matrix, given the current equation system definition
-       *  and the GDS' involved.
+       * and the GDS' involved.
        *
        * \warning You must call method Prepare() first, otherwise this
        * method will throw an InvalidEquSys exception.
@@ -684,11 +801,38 @@ namespace gpstk
       {
          GPSTK_THROW(InvalidEquSys("EquSys is not prepared"));
       }
+      const size_t numEqu( rVector.size() );
+      Matrix<double> rMatrix( numEqu, numEqu, 0.0 );
+      for( size_t i = 0; i < numEqu; i++ )
+      {
+         rMatrix(i,i) = rVector(i);
+      }
+
       return rMatrix;
 
    }  // End of method 'EquSys::getWeightsMatrix()'
 
 
+
+      /* Get the diagonal of the weights matrix, given the current
+       * equation system definition and the GDS' involved.
+       *
+       * \warning You must call method Prepare() first, otherwise this
+       * method will throw an InvalidEquSys exception.
+       */
+   Vector<double> EquSys::getWeightsVector() const
+      noexcept(false)
+   {
+         // If the object as not ready, throw an exception
+      if (!isPrepared)
+      {
+         GPSTK_THROW(InvalidEquSys("EquSys is not prepared"));
+      }
+      return rVector;
+
+   }  // End of method 'EquSys::getWeightsVector()'
+
+
       /* Get the State Transition Matrix (PhiMatrix), given the current
        * equation system definition and the GDS' involved.
        *
@@ -703,6 +847,13 @@ namespace gpstk
       {
          GPSTK_THROW(InvalidEquSys("EquSys is not prepared"));
       }
+      const size_t numVar( phiVector.size() );
+      Matrix<double> phiMatrix( numVar, numVar, 0.0 );
+      for( size_t i = 0; i < numVar; i++ )
+      {
+         phiMatrix(i,i) = phiVector(i);
+      }
+
       return phiMatrix;
    }  // End of method 'EquSys::getPhiMatrix()'
 
@@ -722,16 +873,62 @@ namespace gpstk
       {
          GPSTK_THROW(InvalidEquSys("EquSys is not prepared"));
       }
+      const size_t numVar( qVector.size() );
+      Matrix<double> qMatrix( numVar, numVar, 0.0 );
+      for( size_t i = 0; i < numVar; i++ )
+      {
+         qMatrix(i,i) = qVector(i);
+      }
+
       return qMatrix;
 
    }  // End of method 'EquSys::getQMatrix()'
 
 
+
+      /* Get the diagonal of the State Transition Matrix, given the
+       * current equation system definition and the GDS' involved.
+       *
+       * \warning You must call method Prepare() first, otherwise this
+       * method will throw an InvalidEquSys exception.
+       */
+   Vector<double> EquSys::getPhiVector() const
+      noexcept(false)
+   {
+         // If the object as not ready, throw an exception
+      if (!isPrepared)
+      {
+         GPSTK_THROW(InvalidEquSys("EquSys is not prepared"));
+      }
+      return phiVector;
+
+   }  // End of method 'EquSys::getPhiVector()'
+
+
+
+      /* Get the diagonal of the Process Noise Covariance Matrix, given
+       * the current equation system definition and the GDS' involved.
+       *
+       * \warning You must call method Prepare() first, otherwise this
+       * method will throw an InvalidEquSys exception.
+       */
+   Vector<double> EquSys::getQVector() const
+      noexcept(false)
+   {
+         // If the object as not ready, throw an exception
+      if (!isPrepared)
+      {
+         GPSTK_THROW(InvalidEquSys("EquSys is not prepared"));
+      }
+      return qVector;
+
+   }  // End of method 'EquSys::getQVector()'
+
+
    void EquSys::setUpIndex()
    {
 
-       // Then setup index for this epoch
-       int nowIndex  = 0;
+       // Then setup index for this epoch, the column of the variable
        VariableSet varSet;
        for( auto &var: currentUnkSet )
        {
@@ -745,13 +942,10 @@ namespace gpstk
 
 
            /// set current index
-           nowVar.setNowIndex( nowIndex );
+           nowVar.setNowIndex( varIndex[var] );
 
            /// store the set
            varSet.insert(nowVar);
-
-           /// index increment
-           nowIndex++;
        }
 
        // copy 'varSet' to 'currentUnkSet'
@@ -17,6 +17,9 @@
 //  2020/09/03
 //  add dump for descriptionEquation output 
 //
+//  find the columns of the unknowns through a hash index, and keep
+//  the geometry matrix in sparse rows and the weights as a diagonal
+//
 //============================================================================
 
 
@@ -26,6 +29,7 @@
 #include "StochasticModel.hpp"
 #include "Equation.hpp"
 #include "gnssData.hpp"
+#include "SparseRowMatrix.hpp"
 
 
 namespace gpstk
@@ -152,7 +156,7 @@ namespace gpstk
 
          /// Default constructor
       EquSys()
-         : isPrepared(false)
+         : isPrepared(false), freeSlots(0), numColumns(0)
       {};
 
 
@@ -200,6 +204,30 @@ namespace gpstk
          noexcept(false);
 
 
+         /** Keep the column of each unknown from one epoch to the next.
+          *  The column of an unknown that sets is taken by the unknown of
+          *  the last column, and a new unknown takes the first free one.
+          *  'slots' spare columns are kept for the unknowns that rise, and
+          *  the columns are compacted when more than twice as many are
+          *  free. The spare columns have no geometry, phi 1 and q 0.
+          *
+          *  With 0 slots (the default) the columns follow the order of the
+          *  set of unknowns.
+          */
+      virtual EquSys& setFreeSlots(int slots)
+      { freeSlots = (slots > 0) ? slots : 0; return (*this); }
+
+
+         /** Return the number of columns of the geometry matrix, the
+          *  unknowns plus the spare columns.
+          *
+          * \warning You must call method Prepare() first, otherwise this
+          * method will throw an InvalidEquSys exception.
+          */
+      virtual int getNumColumns() const
+         noexcept(false);
+
+
          /** Return the set containing all variables being processed.
           *
           * \warning You must call method Prepare() first, otherwise this
@@ -268,6 +296,17 @@ namespace gpstk
          noexcept(false);
 
 
+         /** Get geometry matrix in sparse rows: each row holds the
+          *  coefficients of the unknowns of its equation, in increasing
+          *  column order.
+          *
+          * \warning You must call method Prepare() first, otherwise this
+          * method will throw an InvalidEquSys exception.
+          */
+      virtual SparseRowMatrix getGeometryRows() const
+         noexcept(false);
+
+
          /** Get weights matrix, given the current equation system definition
           *  and the GDS' involved.
           *
@@ -278,6 +317,16 @@ namespace gpstk
          noexcept(false);
 
 
+         /** Get the diagonal of the weights matrix, one value per
+          *  equation.
+          *
+          * \warning You must call method Prepare() first, otherwise this
+          * method will throw an InvalidEquSys exception.
+          */
+      virtual Vector<double> getWeightsVector() const
+         noexcept(false);
+
+
          /** Get the State Transition Matrix (PhiMatrix), given the current
           *  equation system definition and the GDS' involved.
           *
@@ -298,6 +347,25 @@ namespace gpstk
          noexcept(false);
 
 
+         /** Get the diagonal of the State Transition Matrix, one value
+          *  per unknown in the order of the current unknowns set.
+          *
+          * \warning You must call method Prepare() first, otherwise this
+          * method will throw an InvalidEquSys exception.
+          */
+      virtual Vector<double> getPhiVector() const
+         noexcept(false);
+
+
+         /** Get the diagonal of the Process Noise Covariance Matrix.
+          *
+          * \warning You must call method Prepare() first, otherwise this
+          * method will throw an InvalidEquSys exception.
+          */
+      virtual Vector<double> getQVector() const
+         noexcept(false);
+
+
          /// Get the number of equation descriptions being currently processed.
       virtual int getEquationDefinitionNumber() const
       { return equDescripSet.size(); };
@@ -361,17 +429,28 @@ namespace gpstk
          /// Set containing satellites being currently processed
       SatIDSet currentSatSet;
 
-         /// State Transition Matrix (PhiMatrix)
-      Matrix<double> phiMatrix;
+         /// Diagonal of the State Transition Matrix (PhiMatrix). Every
+         /// variable has its own stochastic model, so Phi is diagonal.
+      Vector<double> phiVector;
+
+         /// Diagonal of the process noise covariance matrix (QMatrix)
+      Vector<double> qVector;
+
+         /// Geometry matrix, by rows
+      SparseRowMatrix hRows;
 
-         /// Process noise covariance matrix (QMatrix)
-      Matrix<double> qMatrix;
+         /// Diagonal of the weights matrix
+      Vector<double> rVector;
 
-         /// Geometry matrix
-      Matrix<double> hMatrix;
+         /// Column of each current unknown
+      VariableIndexMap varIndex;
 
-         /// Weights matrix
-      Matrix<double> rMatrix;
+         /// Spare columns kept for the unknowns that rise, 0 if the
+         /// columns follow the order of the set
+      int freeSlots;
+
+         /// Number of columns, the unknowns plus the spare columns
+      int numColumns;
 
          /// Measurements vector (Prefit-residuals)
       Vector<double> measVector;
@@ -385,7 +464,10 @@ namespace gpstk
          /// Get current sources (SourceID's) and satellites (SatID's)
       void prepareCurrentSourceSat( sourceRinex& gData );
 
-         /// Compute phiMatrix and qMatrix
+         /// Index the columns of the current unknowns
+      void setUpColumns();
+
+         /// Compute the diagonals of phiMatrix and qMatrix
       void getPhiQ( const sourceRinex& gData );
 
          /// Compute prefit residuals vector
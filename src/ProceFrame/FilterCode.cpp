@@ -22,7 +22,7 @@ namespace gpstk
    //
    // @param gData     Data object holding the data.
    //
-   satTypeValueMap& FilterCode::Process( SysTypesMap& mapObsTypes,
+   satTypeValueMap& FilterCode::Process( const SysTypesMap& mapObsTypes,
                                          std::map<RinexSatID/*SatID*/, TypeIDVec>& satTypes,
                                          satTypeValueMap& gData )
       noexcept(false)
@@ -49,7 +49,10 @@ namespace gpstk
                // convert 1-char to 1-string
                string sysString = string(1, sysChar);
 
-               std::vector<TypeID> typeVec = mapObsTypes[sysString];
+               static const std::vector<TypeID> noTypes;
+               SysTypesMap::const_iterator sysTypes = mapObsTypes.find(sysString);
+               const std::vector<TypeID>& typeVec =
+                   (sysTypes != mapObsTypes.end()) ? sysTypes->second : noTypes;
 
                if(debug)
                {
@@ -79,7 +79,11 @@ namespace gpstk
         Vector<double> arguments(11, 0.0);
 
         // Change the time system from GPST to UTC(UT1)
-        CommonTime utc(pRefSys->GPS2UTC(time));
+        CommonTime utc( ( epochContext &&
+                          epochContext->haveEarthOrientation &&
+                          epochContext->epoch == time )
+                        ? epochContext->utc
+                        : pRefSys->GPS2UTC(time) );
 
         arguments = getArg(utc);
 
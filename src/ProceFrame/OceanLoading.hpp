@@ -39,6 +39,7 @@
 #include "CommonTime.hpp"
 #include "BLQDataReader.hpp"
 #include "ReferenceSystem.hpp"
+#include "EpochContext.hpp"
 #include "GNSSconstants.hpp"
 
 
@@ -98,6 +99,13 @@ namespace gpstk
         { pRefSys = &refSys; return (*this); };
 
 
+        /** Set the context of the epochs to be processed; its values are
+         *  used instead of being computed for the epoch it holds.
+         */
+        OceanLoading& setEpochContext(const std::shared_ptr<const EpochContext>& context)
+        { epochContext = context; return (*this); };
+
+
          /** Return the effect of ocean tides loading (meters) at the given
           *  station and epoch, in the Up-East-North (UEN) reference frame.
           *
@@ -129,6 +137,9 @@ namespace gpstk
 
         ReferenceSystem* pRefSys;
 
+        /// Context of the epoch being processed (may be empty)
+        std::shared_ptr<const EpochContext> epochContext;
+
 
          /** Compute the value of the corresponding astronomical arguments,
           * in radians. This routine is based on IERS routine ARG.f.
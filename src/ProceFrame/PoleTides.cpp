@@ -62,8 +62,14 @@ namespace gpstk
 
         if(pRefSys == NULL) return ret;
 
+        // Values of the epoch context, if it is for this epoch
+        const bool useContext( epochContext &&
+                               epochContext->haveEarthOrientation &&
+                               epochContext->epoch == time );
+
         // UTC time, which will used in ERP interpolation
-        CommonTime utc( pRefSys->GPS2UTC(time) );
+        CommonTime utc( useContext ? epochContext->utc
+                                   : pRefSys->GPS2UTC(time) );
 
         try
         {
@@ -72,8 +78,8 @@ namespace gpstk
             double lon( pos.longitude() * DEG_TO_RAD );
 
             // Get polar motion from files (UTC)
-            xdisp = pRefSys->getXPole(utc);
-            ydisp = pRefSys->getYPole(utc);
+            xdisp = useContext ? epochContext->xPole : pRefSys->getXPole(utc);
+            ydisp = useContext ? epochContext->yPole : pRefSys->getYPole(utc);
 
             // The conventional mean pole from IERS 2010, chap 7, Table 7.7
             double MJD_UTC = MJD(utc).mjd;
@@ -39,6 +39,7 @@
 #include "CommonTime.hpp"
 #include "GNSSconstants.hpp"
 #include "ReferenceSystem.hpp"
+#include "EpochContext.hpp"
 
 
 
@@ -109,6 +110,13 @@ namespace gpstk
         { pRefSys = & refSys; return (*this); };
 
 
+        /** Set the context of the epochs to be processed; its values are
+         *  used instead of being computed for the epoch it holds.
+         */
+        PoleTides& setEpochContext(const std::shared_ptr<const EpochContext>& context)
+        { epochContext = context; return (*this); };
+
+
          /** Return the effect of pole tides (meters) at the given
           *  position and epoch, in the Up-East-North (UEN) reference frame.
           *
@@ -188,6 +196,9 @@ namespace gpstk
 
         ReferenceSystem* pRefSys;
 
+        /// Context of the epoch being processed (may be empty)
+        std::shared_ptr<const EpochContext> epochContext;
+
     }; // End of class 'PoleTides'
 
     //@}
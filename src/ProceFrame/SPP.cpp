@@ -22,16 +22,23 @@ namespace fippp
 			gnssRinex bRin(gRin);
 			// covert obs type C1WG=>C1G
 			converObs.Process(bRin);
-			ComputeSatPos computeSatPos(navEph);
+			if (pNavEph == NULL)
+			{
+				InvalidRequest e("broadcast ephemeris should be given");
+				GPSTK_THROW(e);
+			}
 			computeSatPos.Process(bRin);
 			
 			// ionoModel
 			IonoModel ionoModel;
-			if (navEph.Rhead.mapIonoCorr.find("GPSA") != navEph.Rhead.mapIonoCorr.end()&&
-				navEph.Rhead.mapIonoCorr.find("GPSB") != navEph.Rhead.mapIonoCorr.end())
+			const auto& ionoCorr = pNavEph->Rhead.mapIonoCorr;
+			auto itGPSA = ionoCorr.find("GPSA");
+			auto itGPSB = ionoCorr.find("GPSB");
+			if (itGPSA != ionoCorr.end() &&
+				itGPSB != ionoCorr.end())
 			{
-				ionoModel.setModel(navEph.Rhead.mapIonoCorr["GPSA"].param,
-					navEph.Rhead.mapIonoCorr["GPSB"].param);
+				ionoModel.setModel(itGPSA->second.param,
+					itGPSB->second.param);
 			}
 			// Tropospheric model
 			SaasTropModel saasTM;
@@ -62,13 +69,13 @@ namespace fippp
 	}	// end of SPP::Process
     ///
     /// \param pOutStream
-    void SPP::printNewLine(std::ofstream *pOutStream) {
-        *pOutStream << std::endl;
+    void SPP::printNewLine(SolutionStream *pOutStream) {
+        pOutStream->endl();
     }
     ///
     /// \param pOutStream
     /// \param gRinHeader
-	void SPP::printSol(std::ofstream* pOutStream, 
+	void SPP::printSol(SolutionStream* pOutStream, 
 		const gnssRinexHeader& gRinHeader)
 	{
 		CommonTime epoch(gRinHeader.epoch);
@@ -78,22 +85,18 @@ namespace fippp
 		Position rcvPos = gRinHeader.rcvPos;
 
 		// print time
-		*pOutStream << fixed
-			<< setprecision(2)
-			<< setw(4) << time.year
-			<< setw(3) << cvT.month
-			<< setw(3) << cvT.day
-			<< setw(3) << cvT.hour
-			<< setw(3) << cvT.minute
-			<< setw(6) << cvT.second
-			<< setw(4) << time.doy
-			<< setw(9) << time.sod;
+		pOutStream->putInt(time.year, 4)
+			.putInt(cvT.month, 3)
+			.putInt(cvT.day, 3)
+			.putInt(cvT.hour, 3)
+			.putInt(cvT.minute, 3)
+			.putFixed(cvT.second, 6, 2)
+			.putInt(time.doy, 4)
+			.putFixed(time.sod, 9, 2);
 
-		*pOutStream << fixed
-			<< setprecision(4)
-			<< setw(15) << rcvPos.X()
-			<< setw(15) << rcvPos.Y()
-			<< setw(15) << rcvPos.Z();
+		pOutStream->putFixed(rcvPos.X(), 15, 4)
+			.putFixed(rcvPos.Y(), 15, 4)
+			.putFixed(rcvPos.Z(), 15, 4);
 
 		Vector<double> enu(3, 0.), dxyz(3, 0.);
 		double e, n, u, rmsENU, rmsXYZ;
@@ -116,28 +119,22 @@ namespace fippp
 		if (opts.outENU)
 		{
 			// out enu value
-			*pOutStream << fixed
-				<< setprecision(4)
-				<< setw(9) << e
-				<< setw(9) << n
-				<< setw(9) << u
-				<< setw(9) << rmsENU
-				<< setw(3) << 0
-				;
+			pOutStream->putFixed(e, 9, 4)
+				.putFixed(n, 9, 4)
+				.putFixed(u, 9, 4)
+				.putFixed(rmsENU, 9, 4)
+				.putInt(0, 3);
 		}
 		else
 		{
 			// out dx dy dz value
-			*pOutStream << fixed
-				<< setprecision(4)
-				<< setw(9) << dx
-				<< setw(9) << dy
-				<< setw(9) << dz
-				<< setw(9) << rmsXYZ
-				<< setw(3) << 0
-				;
+			pOutStream->putFixed(dx, 9, 4)
+				.putFixed(dy, 9, 4)
+				.putFixed(dz, 9, 4)
+				.putFixed(rmsXYZ, 9, 4)
+				.putInt(0, 3);
 		}
-		*pOutStream << endl;
+		pOutStream->endl();
 
 	}
 }
\ No newline at end of file
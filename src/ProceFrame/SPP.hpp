@@ -22,6 +22,8 @@
 #include "ComputeSPP.hpp"
 #include "XYZ2ENU.hpp"
 #include "AboutOptions.hpp"
+#include "Trace.hpp"
+#include "SolutionWriter.hpp"
 
 using namespace gpstk;
 using namespace gpstk::StringUtils;
@@ -33,12 +35,14 @@ namespace fippp
 	public:
 		//default constuct
 		SPP():
+			pNavEph(NULL),
 			pOutStream(NULL)
 		{};
 
-		SPP(Rinex3EphemerisStore& nav, const Options::options_t& opt) :
-			navEph(nav),
+		SPP(const Rinex3EphemerisStore& nav, const Options::options_t& opt) :
 			opts(opt),
+			pNavEph(&nav),
+			computeSatPos(nav),
 			pOutStream(NULL)
 		{}
 		/// <summary>
@@ -55,12 +59,12 @@ namespace fippp
 			opts = opt;
 		}
 
-		void setFwdOutStream(std::ofstream* pStream)
+		void setFwdOutStream(SolutionStream* pStream)
 		{
 			pOutStream = pStream;
 		};
 
-		void setTraceStream(std::ofstream* pStream)
+		void setTraceStream(TraceStream* pStream)
 		{ pTraceStream = pStream; }
 
 		void setRefPos(const Triple& pos)
@@ -68,10 +72,10 @@ namespace fippp
 
 
 		// print solution
-		void printSol(std::ofstream* pOutStream, const gnssRinexHeader& gRinHeader);
+		void printSol(SolutionStream* pOutStream, const gnssRinexHeader& gRinHeader);
 
         // print newline
-        void printNewLine(std::ofstream* pOutStream);
+        void printNewLine(SolutionStream* pOutStream);
 
 		//default destruct
 		virtual ~SPP() {};
@@ -81,11 +85,13 @@ namespace fippp
 		// reference station position
 		Position refPos;
 		// broadcast epheremic data
-		Rinex3EphemerisStore navEph;
+		const Rinex3EphemerisStore* pNavEph;
+		// satellite positions, keeps the ephemerides between epochs
+		ComputeSatPos computeSatPos;
 		// out file stream
-		std::ofstream* pOutStream;
+		SolutionStream* pOutStream;
 
-		std::ofstream* pTraceStream;
+		TraceStream* pTraceStream;
 
 	};
 }
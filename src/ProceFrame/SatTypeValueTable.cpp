@@ -0,0 +1,339 @@
+#pragma ident "$Id$"
+
+/**
+ * @file SatTypeValueTable.cpp
+ * Flat satellite/type data table, the dense counterpart of satTypeValueMap.
+ */
+
+#include <algorithm>
+
+#include "SatTypeValueTable.hpp"
+
+namespace gpstk
+{
+
+      // Build the table from a satTypeValueMap
+    satTypeValueTable::satTypeValueTable(const satTypeValueMap& stvMap)
+        : slotOf(TypeID::count, -1)
+    {
+        assign(stvMap);
+    }
+
+
+
+      // Replace the contents with the data of a satTypeValueMap
+    satTypeValueTable& satTypeValueTable::assign(const satTypeValueMap& stvMap)
+    {
+
+        clear();
+
+           // The map is sorted, so the rows are appended in order
+        sats.reserve(stvMap.size());
+        for( satTypeValueMap::const_iterator it = stvMap.begin();
+             it != stvMap.end();
+             ++it )
+        {
+            sats.push_back( (*it).first );
+        }
+
+        size_t row(0);
+        for( satTypeValueMap::const_iterator it = stvMap.begin();
+             it != stvMap.end();
+             ++it, ++row )
+        {
+            for( typeValueMap::const_iterator itType = (*it).second.begin();
+                 itType != (*it).second.end();
+                 ++itType )
+            {
+                int slot( typeSlot( (*itType).first ) );
+                if( slot < 0 )
+                {
+                    slot = static_cast<int>( addType( (*itType).first ) );
+                }
+
+                setValue(row, slot, (*itType).second);
+            }
+        }
+
+        return (*this);
+
+    }  // End of method 'satTypeValueTable::assign()'
+
+
+
+      // Return the data as a satTypeValueMap
+    satTypeValueMap satTypeValueTable::toMap() const
+    {
+        satTypeValueMap stvMap;
+        fillMap(stvMap);
+        return stvMap;
+
+    }  // End of method 'satTypeValueTable::toMap()'
+
+
+
+      // Write the data into a satTypeValueMap
+    void satTypeValueTable::fillMap(satTypeValueMap& stvMap) const
+    {
+
+        for( size_t row = 0; row < sats.size(); row++ )
+        {
+            typeValueMap& tvMap( stvMap[ sats[row] ] );
+
+            for( size_t slot = 0; slot < types.size(); slot++ )
+            {
+                if( present[slot][row] )
+                {
+                    tvMap[ types[slot] ] = columns[slot][row];
+                }
+            }
+        }
+
+    }  // End of method 'satTypeValueTable::fillMap()'
+
+
+
+      // Remove all the data, the column storage is kept
+    void satTypeValueTable::clear()
+    {
+
+        sats.clear();
+
+        for( size_t slot = 0; slot < types.size(); slot++ )
+        {
+            slotOf[ types[slot].type ] = -1;
+        }
+        types.clear();
+
+           // Keep the column vectors, their capacity is reused by the
+           // next epoch
+        for( size_t slot = 0; slot < columns.size(); slot++ )
+        {
+            columns[slot].clear();
+            present[slot].clear();
+        }
+
+    }  // End of method 'satTypeValueTable::clear()'
+
+
+
+      // Return the row of the satellite, -1 if it is not in the table
+    int satTypeValueTable::satIndex(const SatID& satellite) const
+    {
+
+        RinexSatID sat(satellite);
+        std::vector<RinexSatID>::const_iterator it(
+                        std::lower_bound(sats.begin(), sats.end(), sat) );
+
+        if( it != sats.end() && (*it) == sat )
+        {
+            return static_cast<int>( it - sats.begin() );
+        }
+
+        return -1;
+
+    }  // End of method 'satTypeValueTable::satIndex()'
+
+
+
+      // Add a satellite and return its row
+    size_t satTypeValueTable::addSat(const RinexSatID& satellite)
+    {
+
+        std::vector<RinexSatID>::iterator it(
+                        std::lower_bound(sats.begin(), sats.end(), satellite) );
+
+        const size_t row( it - sats.begin() );
+        if( it != sats.end() && (*it) == satellite )
+        {
+            return row;
+        }
+
+        sats.insert(it, satellite);
+
+        for( size_t slot = 0; slot < types.size(); slot++ )
+        {
+            columns[slot].insert(columns[slot].begin() + row, 0.0);
+            present[slot].insert(present[slot].begin() + row, 0);
+        }
+
+        return row;
+
+    }  // End of method 'satTypeValueTable::addSat()'
+
+
+
+      // Add a type and return its column
+    size_t satTypeValueTable::addType(const TypeID& type)
+    {
+
+        const size_t t( static_cast<size_t>(type.type) );
+        if( t >= slotOf.size() )
+        {
+            slotOf.resize(t + 1, -1);
+        }
+
+        if( slotOf[t] >= 0 )
+        {
+            return slotOf[t];
+        }
+
+        const size_t slot( types.size() );
+        types.push_back(type);
+        slotOf[t] = static_cast<int>(slot);
+
+           // Reuse the storage left by 'clear()'
+        if( slot < columns.size() )
+        {
+            columns[slot].assign(sats.size(), 0.0);
+            present[slot].assign(sats.size(), 0);
+        }
+        else
+        {
+            columns.push_back( std::vector<double>(sats.size(), 0.0) );
+            present.push_back( std::vector<char>(sats.size(), 0) );
+        }
+
+        return slot;
+
+    }  // End of method 'satTypeValueTable::addType()'
+
+
+
+      /* Return the data value (double) corresponding to provided SatID
+       * and TypeID.
+       *
+       * @param satellite     Satellite to be looked for.
+       * @param type          Type to be looked for.
+       */
+    double satTypeValueTable::getValue( const SatID& satellite,
+                                        const TypeID& type ) const
+        noexcept(false)
+    {
+
+        int row( satIndex(satellite) );
+        if( row < 0 )
+        {
+            GPSTK_THROW(SatIDNotFound("SatID not found in table"));
+        }
+
+        int slot( typeSlot(type) );
+        if( slot < 0 || !present[slot][row] )
+        {
+            GPSTK_THROW(TypeIDNotFound("TypeID not found in table"));
+        }
+
+        return columns[slot][row];
+
+    }  // End of method 'satTypeValueTable::getValue()'
+
+
+
+      // Return a reference to the data value (double) with
+      // corresponding SatID and TypeID, adding them if needed.
+    double& satTypeValueTable::operator()( const RinexSatID& satellite,
+                                           const TypeID& type )
+    {
+
+        int row( satIndex(satellite) );
+        if( row < 0 )
+        {
+            row = static_cast<int>( addSat(satellite) );
+        }
+
+        int slot( typeSlot(type) );
+        if( slot < 0 )
+        {
+            slot = static_cast<int>( addType(type) );
+        }
+
+        present[slot][row] = 1;
+        return columns[slot][row];
+
+    }  // End of method 'satTypeValueTable::operator()'
+
+
+
+      // Return the types of the satellite, in column order
+    TypeIDVec satTypeValueTable::getTypeID(const SatID& satellite) const
+    {
+
+        TypeIDVec typeVec;
+
+        int row( satIndex(satellite) );
+        if( row < 0 )
+        {
+            return typeVec;
+        }
+
+        for( size_t slot = 0; slot < types.size(); slot++ )
+        {
+            if( present[slot][row] )
+            {
+                typeVec.push_back( types[slot] );
+            }
+        }
+
+        return typeVec;
+
+    }  // End of method 'satTypeValueTable::getTypeID()'
+
+
+
+      // Modifies this object, removing this satellite.
+    satTypeValueTable& satTypeValueTable::removeSatID(const SatID& satellite)
+    {
+
+        int row( satIndex(satellite) );
+        if( row < 0 )
+        {
+            return (*this);
+        }
+
+        sats.erase( sats.begin() + row );
+
+        for( size_t slot = 0; slot < types.size(); slot++ )
+        {
+            columns[slot].erase( columns[slot].begin() + row );
+            present[slot].erase( present[slot].begin() + row );
+        }
+
+        return (*this);
+
+    }  // End of method 'satTypeValueTable::removeSatID()'
+
+
+
+      // Modifies this object, removing these satellites.
+    satTypeValueTable& satTypeValueTable::removeSatID(const SatIDSet& satSet)
+    {
+
+        for( SatIDSet::const_iterator pos = satSet.begin();
+             pos != satSet.end();
+             ++pos )
+        {
+            removeSatID(*pos);
+        }
+
+        return (*this);
+
+    }  // End of method 'satTypeValueTable::removeSatID()'
+
+
+
+      // Modifies this object, removing this type of data. The column is
+      // only emptied, so the other columns keep their slot.
+    satTypeValueTable& satTypeValueTable::removeTypeID(const TypeID& type)
+    {
+
+        int slot( typeSlot(type) );
+        if( slot >= 0 )
+        {
+            std::fill( present[slot].begin(), present[slot].end(), 0 );
+        }
+
+        return (*this);
+
+    }  // End of method 'satTypeValueTable::removeTypeID()'
+
+}  // End of namespace gpstk
@@ -0,0 +1,198 @@
+#pragma ident "$Id$"
+
+/**
+ * @file SatTypeValueTable.hpp
+ * Flat satellite/type data table, the dense counterpart of satTypeValueMap.
+ */
+
+#ifndef GPSTK_SATTYPEVALUETABLE_HPP
+#define GPSTK_SATTYPEVALUETABLE_HPP
+
+#include <vector>
+
+#include "DataStructures.hpp"
+
+namespace gpstk
+{
+
+      /** Flat GNSS data table holding the same data as a satTypeValueMap.
+       *
+       * Satellites are kept in a sorted vector (the row index) and every
+       * type of value owns a column, so the data are stored as structure
+       * of arrays:
+       *
+       *  \li sats      RinexSatID of each row
+       *  \li types     TypeID of each column
+       *  \li slotOf    column of each TypeID::ValueType, -1 if absent
+       *
+       * Looking a type up is an array access and looking a satellite up a
+       * binary search on a short vector, instead of two red-black-tree
+       * finds. No node is allocated per value.
+       *
+       * The table can be built from a satTypeValueMap and written back
+       * into one, so processors can be migrated one by one: a processor
+       * working on the table keeps the 'satTypeValueMap' version as
+       * adapter for the rest of the chain.
+       */
+    struct satTypeValueTable
+    {
+
+         /// Default constructor
+        satTypeValueTable()
+            : slotOf(TypeID::count, -1)
+        {};
+
+
+         /// Build the table from a satTypeValueMap
+        explicit satTypeValueTable(const satTypeValueMap& stvMap);
+
+
+         /// Replace the contents with the data of a satTypeValueMap
+        satTypeValueTable& assign(const satTypeValueMap& stvMap);
+
+
+         /// Return the data as a satTypeValueMap
+        satTypeValueMap toMap() const;
+
+
+         /// Write the data into a satTypeValueMap, the values already in
+         /// 'stvMap' for satellites of this table are overwritten.
+        void fillMap(satTypeValueMap& stvMap) const;
+
+
+         /// Remove all the data, the column storage is kept
+        void clear();
+
+
+         /// Return the number of satellites (rows)
+        size_t numSats() const
+        { return sats.size(); }
+
+
+         /// Return the number of types (columns)
+        size_t numTypes() const
+        { return types.size(); }
+
+
+         /// Return the satellites, in ascending order
+        const std::vector<RinexSatID>& getSats() const
+        { return sats; }
+
+
+         /// Return the types, in column order
+        const TypeIDVec& getTypes() const
+        { return types; }
+
+
+         /// Return the row of the satellite, -1 if it is not in the table
+        int satIndex(const SatID& satellite) const;
+
+
+         /// Return the column of the type, -1 if it is not in the table
+        int typeSlot(const TypeID& type) const
+        {
+            const size_t t( static_cast<size_t>(type.type) );
+            return (t < slotOf.size()) ? slotOf[t] : -1;
+        }
+
+
+         /// Add a satellite and return its row; existing rows after it
+         /// are shifted, so add satellites before caching row indexes.
+        size_t addSat(const RinexSatID& satellite);
+
+
+         /// Add a type and return its column. Columns are never moved.
+        size_t addType(const TypeID& type);
+
+
+         /// Return true if the value of row 'sat' and column 'slot' is set
+        bool hasValue(size_t sat, size_t slot) const
+        { return present[slot][sat] != 0; }
+
+
+         /// Return the value of row 'sat' and column 'slot', no checks
+        double value(size_t sat, size_t slot) const
+        { return columns[slot][sat]; }
+
+
+         /// Set the value of row 'sat' and column 'slot'
+        void setValue(size_t sat, size_t slot, double val)
+        {
+            columns[slot][sat] = val;
+            present[slot][sat] = 1;
+        }
+
+
+         /// Remove the value of row 'sat' and column 'slot'
+        void removeValue(size_t sat, size_t slot)
+        { present[slot][sat] = 0; }
+
+
+         /// Return the column of values of 'slot', indexed by row. Only
+         /// the rows flagged by 'columnFlags()' hold valid data.
+        const std::vector<double>& column(size_t slot) const
+        { return columns[slot]; }
+
+
+         /// Return the presence flags of the column 'slot'
+        const std::vector<char>& columnFlags(size_t slot) const
+        { return present[slot]; }
+
+
+         /** Return the data value (double) corresponding to provided SatID
+          *  and TypeID.
+          *
+          * @param satellite     Satellite to be looked for.
+          * @param type          Type to be looked for.
+          */
+        double getValue(const SatID& satellite, const TypeID& type) const
+            noexcept(false);
+
+
+         /// Return a reference to the data value (double) with
+         /// corresponding SatID and TypeID, adding them if needed.
+        double& operator()(const RinexSatID& satellite, const TypeID& type);
+
+
+         /// Return the types of the satellite, in column order
+        TypeIDVec getTypeID(const SatID& satellite) const;
+
+
+         /// Modifies this object, removing this satellite.
+        satTypeValueTable& removeSatID(const SatID& satellite);
+
+
+         /// Modifies this object, removing these satellites.
+        satTypeValueTable& removeSatID(const SatIDSet& satSet);
+
+
+         /// Modifies this object, removing this type of data.
+        satTypeValueTable& removeTypeID(const TypeID& type);
+
+
+         /// Destructor.
+        virtual ~satTypeValueTable() {};
+
+
+    private:
+
+         /// Satellites of the rows, ascending
+        std::vector<RinexSatID> sats;
+
+         /// Types of the columns
+        TypeIDVec types;
+
+         /// Column of each TypeID::ValueType, -1 if absent
+        std::vector<int> slotOf;
+
+         /// Values, one vector per column indexed by row
+        std::vector< std::vector<double> > columns;
+
+         /// Presence flags, same layout as 'columns'
+        std::vector< std::vector<char> > present;
+
+    };  // End of 'satTypeValueTable'
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_SATTYPEVALUETABLE_HPP
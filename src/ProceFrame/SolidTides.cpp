@@ -49,50 +49,55 @@ namespace gpstk
             if(pRefSys == NULL) return ret;
             if(pSolSys == NULL) return ret;
 
-            CommonTime utc( pRefSys->GPS2UTC(time) );
+            CommonTime utc, tt;
 
-            Matrix<double> c2tRaw( pRefSys->C2TMatrix(utc) );
+            // Variables to hold Sun and Moon positions in ECF.
+            Vec3 sunPos, moonPos;
 
+            if( epochContext &&
+                epochContext->haveEarthOrientation &&
+                epochContext->epoch == time )
+            {
+                utc = epochContext->utc;
+                tt = epochContext->tt;
+                sunPos = epochContext->sunECEF;
+                moonPos = epochContext->moonECEF;
+            }
+            else
+            {
+                utc = pRefSys->GPS2UTC(time);
 
-            CommonTime tt( pRefSys->GPS2TT(time) );
+                Mat3 c2tRaw( pRefSys->C2TRotation(utc) );
 
+                tt = pRefSys->GPS2TT(time);
 
-            double jd_tt( JulianDate(tt).jd );
+                double jd_tt( JulianDate(tt).jd );
 
-            Triple p2(pos.X(),pos.Y(),pos.Z());
+                SolarSystem::Planet center(SolarSystem::Earth);
+                SolarSystem::Planet sun(SolarSystem::Sun);
+                SolarSystem::Planet moon(SolarSystem::Moon);
 
-            // Fraction of hour
-            double FHR = YDSTime(utc).sod/3600.0;
+                double rv_sun[6] = {0.0};
+                pSolSys->computeState(jd_tt, sun, center, rv_sun);
 
-            SolarSystem::Planet center(SolarSystem::Earth);
-            SolarSystem::Planet sun(SolarSystem::Sun);
-            SolarSystem::Planet moon(SolarSystem::Moon);
+                Vec3 rSunECI(rv_sun[0], rv_sun[1], rv_sun[2]);
+                rSunECI *= 1.0e+3;
 
-            double rv_sun[6] = {0.0};
-            pSolSys->computeState(jd_tt, sun, center, rv_sun);
+                sunPos = c2tRaw*rSunECI;
 
-            Vector<double> rSunECI(3,0.0);
-            rSunECI(0) = rv_sun[0];
-            rSunECI(1) = rv_sun[1];
-            rSunECI(2) = rv_sun[2];
-            rSunECI *= 1.0e+3;
+                double rv_moon[6] = {0.0};
+                pSolSys->computeState(jd_tt, moon, center, rv_moon);
 
-            Vector<double> rSunECF( c2tRaw*rSunECI );
+                Vec3 rMoonECI(rv_moon[0], rv_moon[1], rv_moon[2]);
+                rMoonECI *= 1.0e+3;
 
-            double rv_moon[6] = {0.0};
-            pSolSys->computeState(jd_tt, moon, center, rv_moon);
-
-            Vector<double> rMoonECI(3,0.0);
-            rMoonECI(0) = rv_moon[0];
-            rMoonECI(1) = rv_moon[1];
-            rMoonECI(2) = rv_moon[2];
-            rMoonECI *= 1.0e+3;
+                moonPos = c2tRaw*rMoonECI;
+            }
 
-            Vector<double> rMoonECF( c2tRaw*rMoonECI );
+            Vec3 p2(pos.X(),pos.Y(),pos.Z());
 
-            // Variables to hold Sun and Moon positions in ECF.
-            Triple sunPos(rSunECF[0], rSunECF[1], rSunECF[2]);
-            Triple moonPos(rMoonECF[0], rMoonECF[1], rMoonECF[2]);
+            // Fraction of hour
+            double FHR = YDSTime(utc).sod/3600.0;
 
             double SCS = p2.dot(sunPos);
             double SCM = p2.dot(moonPos);
@@ -131,7 +136,7 @@ namespace gpstk
             double FAC3MON = FAC2MON*(RE_EARTH/RMON);
 
             // Total displacement for degree 2 and 3(in-phase)
-            Triple DXTIDE(0.0,0.0,0.0);
+            Vec3 DXTIDE(0.0,0.0,0.0);
             for(int i = 0; i< 3; ++i)
             {
                 DXTIDE[i] = FAC2SUN*( X2SUN*sunPos[i]/RSUN + P2SUN*p2[i]/RSTA ) +
@@ -143,13 +148,13 @@ namespace gpstk
             // Then corrects for the out-of-phase part of love numbers(PART H_2^(0)I AND L_2^(0)I)
 
             // First, the diurnal band
-            Triple XCORSTA1 = getStep1Diu(p2, sunPos, moonPos, FAC2SUN, FAC2MON);
+            Vec3 XCORSTA1 = getStep1Diu(p2, sunPos, moonPos, FAC2SUN, FAC2MON);
 
             // Second, the semi-diurnal band
-            Triple XCORSTA2 = getStep1Sem(p2, sunPos, moonPos, FAC2SUN, FAC2MON);
+            Vec3 XCORSTA2 = getStep1Sem(p2, sunPos, moonPos, FAC2SUN, FAC2MON);
 
             // Then corrects for thr latitude dependence of love numbers(PART L^(1) )
-            Triple XCORSTA3 = getStep1L1(p2, sunPos, moonPos, FAC2SUN, FAC2MON);
+            Vec3 XCORSTA3 = getStep1L1(p2, sunPos, moonPos, FAC2SUN, FAC2MON);
 
             for (int i=0; i<3; ++i)
             {
@@ -166,10 +171,10 @@ namespace gpstk
             double T( (MJD(tt).mjd - MJD_J2000)/JC );
 
             // Caculate the diurnal band corrections(in-phase and out-of-phase frequency dependence)
-            Triple XCORSTA4 = getStep2Diu(p2,FHR,T);
+            Vec3 XCORSTA4 = getStep2Diu(p2,FHR,T);
 
             // Corretions for the long period band(in-phase and out-of-phase frequency dependence)
-            Triple XCORSTA5 = getStep2Lon(p2,T);
+            Vec3 XCORSTA5 = getStep2Lon(p2,T);
 
             for (int i=0; i<3; ++i)
             {
@@ -199,13 +204,13 @@ namespace gpstk
     } // End SolidTides::getSolidTide()
 
 
-    Triple SolidTides::getStep1Diu( const Triple& XSTA,
-                                    const Triple& XSUN,
-                                    const Triple& XMON,
-                                    double FAC2SUN,
-                                    double FAC2MON )
+    Vec3 SolidTides::getStep1Diu( const Vec3& XSTA,
+                                  const Vec3& XSUN,
+                                  const Vec3& XMON,
+                                  double FAC2SUN,
+                                  double FAC2MON )
     {
-        Triple XCORSTA(0.0,0.0,0.0);
+        Vec3 XCORSTA(0.0,0.0,0.0);
 
         double DHI = -0.0025, DLI = -0.0007;
 
@@ -255,13 +260,13 @@ namespace gpstk
     } // End SolidTides::getStep1Diu()
 
 
-    Triple SolidTides::getStep1Sem( const Triple& XSTA,
-                                    const Triple& XSUN,
-                                    const Triple& XMON,
-                                    double FAC2SUN,
-                                    double FAC2MON )
+    Vec3 SolidTides::getStep1Sem( const Vec3& XSTA,
+                                  const Vec3& XSUN,
+                                  const Vec3& XMON,
+                                  double FAC2SUN,
+                                  double FAC2MON )
     {
-        Triple XCORSTA(0.0,0.0,0.0);
+        Vec3 XCORSTA(0.0,0.0,0.0);
 
         double DHI = -0.0022, DLI = -0.0007;
 
@@ -318,13 +323,13 @@ namespace gpstk
     } // End SolidTides::getStep1Sem()
 
 
-    Triple SolidTides::getStep1L1( const Triple& XSTA,
-                                   const Triple& XSUN,
-                                   const Triple& XMON,
-                                   double FAC2SUN,
-                                   double FAC2MON )
+    Vec3 SolidTides::getStep1L1( const Vec3& XSTA,
+                                 const Vec3& XSUN,
+                                 const Vec3& XMON,
+                                 double FAC2SUN,
+                                 double FAC2MON )
     {
-        Triple XCORSTA(0.0,0.0,0.0);
+        Vec3 XCORSTA(0.0,0.0,0.0);
 
         double L1D = 0.0012,L1SD = 0.0024;
 
@@ -391,10 +396,10 @@ namespace gpstk
     } // End SolidTides::getStep1L1()
 
 
-    Triple SolidTides::getStep2Diu( const Triple& XSTA, double FHR, double T )
+    Vec3 SolidTides::getStep2Diu( const Vec3& XSTA, double FHR, double T )
     {
 
-        Triple XCORSTA(0.0,0.0,0.0);
+        Vec3 XCORSTA(0.0,0.0,0.0);
 
         // IERS 2010, TABLE 7.3a(extended)
         double DATDI[31][9] =
@@ -524,9 +529,9 @@ namespace gpstk
     } // End SolidTides::getStep2Diu()
 
 
-    Triple SolidTides::getStep2Lon( const Triple& XSTA, double T )
+    Vec3 SolidTides::getStep2Lon( const Vec3& XSTA, double T )
     {
-        Triple XCORSTA(0.0,0.0,0.0);
+        Vec3 XCORSTA(0.0,0.0,0.0);
 
         double DATDI[5][9] =
         {
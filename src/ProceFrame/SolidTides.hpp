@@ -13,9 +13,11 @@
 
 #include "CommonTime.hpp"
 #include "Triple.hpp"
+#include "Mat3.hpp"
 #include "Position.hpp"
 #include "GNSSconstants.hpp"
 #include "ReferenceSystem.hpp"
+#include "EpochContext.hpp"
 #include "SolarSystem.hpp"
 
 
@@ -53,6 +55,13 @@ namespace gpstk
         { pSolSys = &solSys; return (*this); };
 
 
+        /** Set the context of the epochs to be processed; its values are
+         *  used instead of being computed for the epoch it holds.
+         */
+        SolidTides& setEpochContext(const std::shared_ptr<const EpochContext>& context)
+        { epochContext = context; return (*this); };
+
+
          /** Return the effect of solid Earth tides (meters) at the given
           *  position and epoch, in the Up-East-North (UEN) reference frame.
           *
@@ -79,14 +88,14 @@ namespace gpstk
          * @param XMON      Geocentric position of the Moon
          * @param FAC2SUN   Degree 2 TGP factor for the Sun
          * @param FAC2MON   Degree 2 TGP factor for the Moon
-         * @return          a Triple with the solid tidal effect, in meters
+         * @return          a Vec3 with the solid tidal effect, in meters
          *                  and in the ITRF reference frame.
          */
-        Triple getStep1Diu( const Triple& XSTA,
-                            const Triple& XSUN,
-                            const Triple& XMON,
-                            double FAC2SUN,
-                            double FAC2MON );
+        Vec3 getStep1Diu( const Vec3& XSTA,
+                          const Vec3& XSUN,
+                          const Vec3& XMON,
+                          double FAC2SUN,
+                          double FAC2MON );
 
 
         /** This subroutine gives the out-of-phase corrections induced by
@@ -97,14 +106,14 @@ namespace gpstk
          * @param XMON      Geocentric position of the Moon
          * @param FAC2SUN   Degree 2 TGP factor for the Sun
          * @param FAC2MON   Degree 2 TGP factor for the Moon
-         * @return          a Triple with the solid tidal effect, in meters
+         * @return          a Vec3 with the solid tidal effect, in meters
          *                  and in the ITRF reference frame.
          */
-        Triple getStep1Sem( const Triple& XSTA,
-                            const Triple& XSUN,
-                            const Triple& XMON,
-                            double FAC2SUN,
-                            double FAC2MON );
+        Vec3 getStep1Sem( const Vec3& XSTA,
+                          const Vec3& XSUN,
+                          const Vec3& XMON,
+                          double FAC2SUN,
+                          double FAC2MON );
 
 
         /** This subroutine gives the corrections induced by the latitude
@@ -115,14 +124,14 @@ namespace gpstk
          * @param XMON      Geocentric position of the Moon
          * @param FAC2SUN   Degree 2 TGP factor for the Sun
          * @param FAC2MON   Degree 2 TGP factor for the Moon
-         * @return          a Triple with the solid tidal effect, in meters
+         * @return          a Vec3 with the solid tidal effect, in meters
          *                  and in the ITRF reference frame.
          */
-        Triple getStep1L1( const Triple& XSTA,
-                           const Triple& XSUN,
-                           const Triple& XMON,
-                           double FAC2SUN,
-                           double FAC2MON );
+        Vec3 getStep1L1( const Vec3& XSTA,
+                         const Vec3& XSUN,
+                         const Vec3& XMON,
+                         double FAC2SUN,
+                         double FAC2MON );
 
 
         /** This subroutine gives the in-phase and out-of-phase corrections
@@ -131,20 +140,20 @@ namespace gpstk
          * @param XSTA      Geocentric position of the IGS station
          * @param FHR       Fractional hours in the day
          * @param T         Centuries since J2000
-         * @return          a Triple with the solid tidal effect, in meters
+         * @return          a Vec3 with the solid tidal effect, in meters
          *                  and in the ITRF reference frame.
          */
-        Triple getStep2Diu( const Triple& XSTA,double FHR,double T );
+        Vec3 getStep2Diu( const Vec3& XSTA,double FHR,double T );
 
 
         /** This subroutine gives the in-phase and out-of-phase corrections
          *  induced by mantle anelasticity in the long period band.
          * @param XSTA      Geocentric position of the IGS station
          * @param T         Centuries since J2000
-         * @return          a Triple with the solid tidal effect, in meters
+         * @return          a Vec3 with the solid tidal effect, in meters
          *                  and in the ITRF reference frame.
          */
-        Triple getStep2Lon( const Triple& XSTA, double T );
+        Vec3 getStep2Lon( const Vec3& XSTA, double T );
 
 
     private:
@@ -159,6 +168,9 @@ namespace gpstk
 
         SolarSystem* pSolSys;
 
+        /// Context of the epoch being processed (may be empty)
+        std::shared_ptr<const EpochContext> epochContext;
+
     }; // end class SolidTides
 
 
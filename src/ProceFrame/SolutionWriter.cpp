@@ -0,0 +1,323 @@
+#pragma ident "$ID: ragn wang 2023-06 $"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+
+#include "SolutionWriter.hpp"
+
+using namespace std;
+
+namespace fippp
+{
+	namespace
+	{
+		// blocks are handed to the writer once they hold this much
+		const size_t blockSize = 64 * 1024;
+
+		const double pow10[10] =
+		{ 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+
+		const uint64_t ipow10[10] =
+		{ 1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL,
+		  1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL };
+
+		// digits of 'value' with 'prec' decimals into 'buf', as
+		// printf("%.*f"). It returns 0 when the rounding of the scaled
+		// value is too close to call, or out of range, so that the
+		// caller uses snprintf.
+		int fastFixed(double value, int prec, char* buf)
+		{
+			if (prec < 0 || prec > 9)
+				return 0;
+
+			double a(std::fabs(value));
+			if (!(a < 1e15))
+				return 0;
+			a *= pow10[prec];
+			if (!(a < 4e15))
+				return 0;
+
+			// the product is within one ulp of the exact value, so the
+			// halfway cases are left to snprintf
+			double fl(std::floor(a));
+			double frac(a - fl);
+			if (std::fabs(frac - 0.5) <= a * 1e-15 + 1e-12)
+				return 0;
+
+			uint64_t r(static_cast<uint64_t>(fl) + (frac > 0.5 ? 1 : 0));
+			uint64_t ip(r / ipow10[prec]);
+			uint64_t fp(r % ipow10[prec]);
+
+			char tmp[32];
+			int n(0);
+			do
+			{
+				tmp[n++] = char('0' + ip % 10);
+				ip /= 10;
+			} while (ip);
+
+			int len(0);
+			if (std::signbit(value))
+				buf[len++] = '-';
+			while (n)
+				buf[len++] = tmp[--n];
+			if (prec > 0)
+			{
+				buf[len++] = '.';
+				for (int i = prec - 1; i >= 0; i--)
+				{
+					buf[len + i] = char('0' + fp % 10);
+					fp /= 10;
+				}
+				len += prec;
+			}
+			return len;
+		}
+
+		void pad(std::string& block, int width, int len)
+		{
+			if (width > len)
+				block.append(width - len, ' ');
+		}
+
+	}	// End of anonymous namespace
+
+
+	SolutionWriter::SolutionWriter(int depth)
+		: maxSize(depth > 0 ? depth : 0), stopping(false)
+	{
+		if (maxSize > 0)
+			worker = std::thread(&SolutionWriter::run, this);
+	}
+
+	int SolutionWriter::open(const std::string& file)
+	{
+		std::unique_ptr<std::ofstream> ofs(
+			new std::ofstream(file.c_str(), ios::out));
+		if (!ofs->is_open())
+			return -1;
+
+		std::lock_guard<std::mutex> lock(queueMutex);
+		files.push_back(std::move(ofs));
+		return static_cast<int>(files.size()) - 1;
+	}
+
+	void SolutionWriter::writeBlock(int file, const std::string& block)
+	{
+		std::ofstream* ofs(NULL);
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			if (file >= 0 && size_t(file) < files.size())
+				ofs = files[file].get();
+		}
+		if (ofs)
+			ofs->write(block.data(), block.size());
+	}
+
+	/// <summary>
+	/// hand over a block; the caller waits while 'maxSize' blocks are
+	/// waiting to be written
+	/// </summary>
+	void SolutionWriter::write(int file, std::string& block)
+	{
+		if (block.empty())
+			return;
+
+		if (maxSize == 0 || !worker.joinable())
+		{
+			writeBlock(file, block);
+			block.clear();
+			return;
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(queueMutex);
+			notFull.wait(lock, [this] { return queue.size() < maxSize; });
+			queue.push_back(std::make_pair(file, std::string()));
+			queue.back().second.swap(block);
+			if (!spare.empty())
+			{
+				block.swap(spare.back());
+				spare.pop_back();
+			}
+		}
+		notEmpty.notify_one();
+
+		block.clear();
+
+	}	// End of method 'SolutionWriter::write()'
+
+	/// <summary>
+	/// writing thread: write the blocks in the order they were handed
+	/// over, until close() and the queue is empty
+	/// </summary>
+	void SolutionWriter::run()
+	{
+		while (true)
+		{
+			std::pair<int, std::string> item;
+			std::ofstream* ofs(NULL);
+			{
+				std::unique_lock<std::mutex> lock(queueMutex);
+				notEmpty.wait(lock, [this]
+					{ return stopping || !queue.empty(); });
+				if (queue.empty())
+					return;
+				item.first = queue.front().first;
+				item.second.swap(queue.front().second);
+				queue.pop_front();
+				if (item.first >= 0 && size_t(item.first) < files.size())
+					ofs = files[item.first].get();
+			}
+			notFull.notify_one();
+
+			if (ofs)
+				ofs->write(item.second.data(), item.second.size());
+
+			item.second.clear();
+			{
+				std::lock_guard<std::mutex> lock(queueMutex);
+				if (spare.size() <= maxSize)
+				{
+					spare.push_back(std::string());
+					spare.back().swap(item.second);
+				}
+			}
+		}
+
+	}	// End of method 'SolutionWriter::run()'
+
+	void SolutionWriter::close()
+	{
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			stopping = true;
+		}
+		notEmpty.notify_all();
+
+		if (worker.joinable())
+			worker.join();
+
+		for (size_t i = 0; i < files.size(); i++)
+			files[i]->close();
+		files.clear();
+
+	}	// End of method 'SolutionWriter::close()'
+
+	SolutionWriter::~SolutionWriter()
+	{
+		close();
+	}
+
+
+	SolutionStream::SolutionStream()
+		: pWriter(NULL), fileIndex(-1)
+	{}
+
+	bool SolutionStream::open(const std::string& file, SolutionWriter* writer)
+	{
+		close();
+
+		if (writer)
+		{
+			fileIndex = writer->open(file);
+			if (fileIndex >= 0)
+				pWriter = writer;
+		}
+		else
+		{
+			ofs.open(file.c_str(), ios::out);
+		}
+
+		block.reserve(blockSize + blockSize / 8);
+		return is_open();
+	}
+
+	SolutionStream& SolutionStream::putFixed(double value, int width, int prec)
+	{
+		char buf[64];
+		int len(fastFixed(value, prec, buf));
+		if (len == 0)
+		{
+			len = std::snprintf(buf, sizeof(buf), "%.*f", prec, value);
+			if (len < 0 || len >= int(sizeof(buf)))
+			{
+				// very large values
+				std::vector<char> big(512);
+				len = std::snprintf(&big[0], big.size(), "%.*f", prec, value);
+				pad(block, width, len);
+				block.append(&big[0], std::min<size_t>(len, big.size() - 1));
+				return *this;
+			}
+		}
+		pad(block, width, len);
+		block.append(buf, len);
+		return *this;
+	}
+
+	SolutionStream& SolutionStream::putInt(long value, int width)
+	{
+		char tmp[24];
+		int n(0);
+		unsigned long u(value < 0 ? 0UL - static_cast<unsigned long>(value)
+			: static_cast<unsigned long>(value));
+		do
+		{
+			tmp[n++] = char('0' + u % 10);
+			u /= 10;
+		} while (u);
+		if (value < 0)
+			tmp[n++] = '-';
+
+		pad(block, width, n);
+		while (n)
+			block += tmp[--n];
+		return *this;
+	}
+
+	SolutionStream& SolutionStream::putText(const std::string& s, int width)
+	{
+		pad(block, width, static_cast<int>(s.size()));
+		block += s;
+		return *this;
+	}
+
+	SolutionStream& SolutionStream::endl()
+	{
+		block += '\n';
+		if (block.size() >= blockSize)
+			flush();
+		return *this;
+	}
+
+	void SolutionStream::flush()
+	{
+		if (block.empty())
+			return;
+
+		if (pWriter)
+			pWriter->write(fileIndex, block);
+		else if (ofs.is_open())
+			ofs.write(block.data(), block.size());
+		block.clear();
+
+		if (block.capacity() < blockSize)
+			block.reserve(blockSize + blockSize / 8);
+	}
+
+	void SolutionStream::close()
+	{
+		flush();
+		if (ofs.is_open())
+			ofs.close();
+		pWriter = NULL;
+		fileIndex = -1;
+	}
+
+	SolutionStream::~SolutionStream()
+	{
+		close();
+	}
+}
@@ -0,0 +1,138 @@
+#pragma ident "$ID: ragn wang 2023-06 $"
+
+#ifndef FiPPP_SolutionWriter_HPP
+#define FiPPP_SolutionWriter_HPP
+
+// The solution files of a station (.pos, .state, .amb, .ele, .pdop,
+// .trop, .resl, .resp) are formatted by the solvers into blocks of
+// memory, which a thread of the SolutionWriter writes to the files.
+// The numbers are formatted as the iostream manipulators fixed,
+// setprecision and setw do, so the files are unchanged.
+//
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace fippp
+{
+	class SolutionWriter
+	{
+	public:
+
+		/// <summary>
+		/// start the writing thread
+		/// </summary>
+		/// <param name="depth"> number of blocks waiting to be
+		/// written before the solver waits, 0 writes the blocks in
+		/// the calling thread </param>
+		explicit SolutionWriter(int depth = 16);
+
+		/// open a file, its index or -1 if it cannot be opened
+		int open(const std::string& file);
+
+		/// hand a block of text for 'file'; 'block' is given back empty
+		void write(int file, std::string& block);
+
+		/// write the blocks waiting, close the files and stop the thread
+		void close();
+
+		~SolutionWriter();
+
+	private:
+
+		void run();
+
+		void writeBlock(int file, const std::string& block);
+
+		size_t maxSize;
+
+		std::vector<std::unique_ptr<std::ofstream> > files;
+
+		std::deque<std::pair<int, std::string> > queue;
+
+		/// buffers written, given back by write()
+		std::vector<std::string> spare;
+
+		std::mutex queueMutex;
+		std::condition_variable notEmpty;
+		std::condition_variable notFull;
+
+		bool stopping;
+
+		std::thread worker;
+
+		// no copy
+		SolutionWriter(const SolutionWriter&);
+		SolutionWriter& operator=(const SolutionWriter&);
+	};
+
+
+	class SolutionStream
+	{
+	public:
+
+		SolutionStream();
+
+		/// <summary>
+		/// open the file
+		/// </summary>
+		/// <param name="file"> name of the file </param>
+		/// <param name="writer"> writer of the station, NULL to write
+		/// the blocks in this thread </param>
+		bool open(const std::string& file, SolutionWriter* writer = NULL);
+
+		bool is_open() const
+		{ return fileIndex >= 0 || ofs.is_open(); }
+
+		SolutionStream& operator<<(const char* s)
+		{ block += s; return *this; }
+
+		SolutionStream& operator<<(const std::string& s)
+		{ block += s; return *this; }
+
+		SolutionStream& operator<<(char c)
+		{ block += c; return *this; }
+
+		/// value with 'prec' digits after the point, right aligned on
+		/// 'width' characters, as fixed << setprecision(prec) << setw(width)
+		SolutionStream& putFixed(double value, int width, int prec);
+
+		/// integer right aligned on 'width' characters
+		SolutionStream& putInt(long value, int width = 0);
+
+		/// text right aligned on 'width' characters
+		SolutionStream& putText(const std::string& s, int width);
+
+		/// end of line; the block is handed over once it is full
+		SolutionStream& endl();
+
+		/// hand the block over
+		void flush();
+
+		/// flush and close the file
+		void close();
+
+		~SolutionStream();
+
+	private:
+
+		SolutionWriter* pWriter;
+		int fileIndex;
+
+		/// file written in this thread, without writer
+		std::ofstream ofs;
+
+		std::string block;
+
+		// no copy
+		SolutionStream(const SolutionStream&);
+		SolutionStream& operator=(const SolutionStream&);
+	};
+}
+
+#endif // !FiPPP_SolutionWriter_HPP
@@ -10,6 +10,63 @@
 
 using namespace gpstk;
 
+namespace
+{
+	// Row of a single-difference operator: the coefficients of at
+	// most two unknowns, in increasing index order
+	struct SDRow
+	{
+		SDRow() : size(0) {}
+
+		SDRow(int i, double c) : size(1)
+		{
+			index[0] = i; coeff[0] = c;
+		}
+
+		SDRow(int i1, double c1, int i2, double c2) : size(2)
+		{
+			if (i2 < i1)
+			{
+				std::swap(i1, i2);
+				std::swap(c1, c2);
+			}
+			index[0] = i1; coeff[0] = c1;
+			index[1] = i2; coeff[1] = c2;
+		}
+
+		int index[2];
+		double coeff[2];
+		int size;
+	};
+
+	// Q = H * P * H^T for the rows of H, gathered from P. The products
+	// run over the nonzero elements in the order of the dense products,
+	// so Q equals the one computed with the full matrices.
+	void gatherCov(const std::vector<SDRow>& rows, const Matrix<double>& P,
+		Matrix<double>& Q)
+	{
+		const size_t n(rows.size());
+		Q.resize(n, n, 0.0);
+		for (size_t a = 0; a < n; a++)
+		{
+			const SDRow& ra(rows[a]);
+			for (size_t b = 0; b < n; b++)
+			{
+				const SDRow& rb(rows[b]);
+				double q(0.0);
+				for (int kb = 0; kb < rb.size; kb++)
+				{
+					double hp(0.0);
+					for (int ka = 0; ka < ra.size; ka++)
+						hp += ra.coeff[ka] * P(ra.index[ka], rb.index[kb]);
+					q += hp * rb.coeff[kb];
+				}
+				Q(a, b) = q;
+			}
+		}
+	}
+}
+
 namespace fippp
 {
 	void PPPAR::Process()
@@ -33,7 +90,7 @@ namespace fippp
 	void PPPAR::printNewLine()
 	{
 		if (pSolStream != NULL)
-			*pSolStream << std::endl;
+			pSolStream->endl();
 	}
 	void PPPAR::printSols()
 	{
@@ -43,16 +100,14 @@ namespace fippp
 		int state(6);
 
 		// print time
-		*pSolStream << fixed
-			<< setprecision(2)
-			<< setw(4) << time.year
-			<< setw(3) << cvT.month
-			<< setw(3) << cvT.day
-			<< setw(3) << cvT.hour
-			<< setw(3) << cvT.minute
-			<< setw(6) << cvT.second
-			<< setw(4) << time.doy
-			<< setw(9) << time.sod;
+		pSolStream->putInt(time.year, 4)
+			.putInt(cvT.month, 3)
+			.putInt(cvT.day, 3)
+			.putInt(cvT.hour, 3)
+			.putInt(cvT.minute, 3)
+			.putFixed(cvT.second, 6, 2)
+			.putInt(time.doy, 4)
+			.putFixed(time.sod, 9, 2);
 
 		double dx, dy, dz;
 		double x(0.), y(0.), z(0.), e(0.), n(0.), u(0.), rmsENU(0.), rmsXYZ(0.);
@@ -96,37 +151,29 @@ namespace fippp
 			rmsXYZ = std::sqrt(SQR(dx) + SQR(dy) + SQR(dz));
 		}
 
-		*pSolStream << fixed
-			<< setprecision(4)
-			<< setw(15) << x
-			<< setw(15) << y
-			<< setw(15) << z;
+		pSolStream->putFixed(x, 15, 4)
+			.putFixed(y, 15, 4)
+			.putFixed(z, 15, 4);
 
 		if (opts.outENU)
 		{
 			// out enu value
-			*pSolStream << fixed
-				<< setprecision(4)
-				<< setw(9) << e
-				<< setw(9) << n
-				<< setw(9) << u
-				<< setw(9) << rmsENU
-				<< setw(3) << state
-				;
+			pSolStream->putFixed(e, 9, 4)
+				.putFixed(n, 9, 4)
+				.putFixed(u, 9, 4)
+				.putFixed(rmsENU, 9, 4)
+				.putInt(state, 3);
 		}
 		else
 		{
 			// out dx dy dz value
-			*pSolStream << fixed
-				<< setprecision(4)
-				<< setw(9) << dx
-				<< setw(9) << dy
-				<< setw(9) << dz
-				<< setw(9) << rmsXYZ
-				<< setw(3) << state
-				;
+			pSolStream->putFixed(dx, 9, 4)
+				.putFixed(dy, 9, 4)
+				.putFixed(dz, 9, 4)
+				.putFixed(rmsXYZ, 9, 4)
+				.putInt(state, 3);
 		}
-		*pSolStream << endl;
+		pSolStream->endl();
 	}
 	void PPPAR::checkLinear()
 		noexcept(false)
@@ -432,13 +479,20 @@ to float solution!");
 	bool PPPAR::ILSIFFixSol()
 		noexcept(false)
 	{
-		int i, j, na(opts.nFixUnk), nb(sdNLAmbValue.size()), ny(na+nb), nx(pppUnkSet.size());
+		int i, j, na(opts.nFixUnk), nb(sdNLAmbValue.size()), ny(na+nb), nx(solution.size());
 		double BcFix(0.), BcFloat(0.);
 		Vector<double> yb(nb), dx(na), Bc(nb), y(ny), yf(na), dya;
 		Matrix<double> Qab(na, nb), QQ(na, nb), Qb(nb, nb), dQ(na, nb);
 		Matrix<double> DD(ny, nx, 0.), EE(ny, nx), Pa(na,na), Pf(3, 3);
-		// dx, dy, dz coeff
-		for (i = 0; i < na; i++) DD(ny-1-i, nx-1-i) = 1.0;
+		std::vector<SDRow> ddRows(ny);
+		// dx, dy, dz coeff, the last unknowns of the set; their columns
+		// are kept by the float solver, so they are looked up
+		auto itUnk = pppUnkSet.rbegin();
+		for (i = 0; i < na && itUnk != pppUnkSet.rend(); i++, ++itUnk)
+		{
+			DD(ny-1-i, itUnk->getNowIndex()) = 1.0;
+			ddRows[ny-1-i] = SDRow(itUnk->getNowIndex(), 1.0);
+		}
 		int idx(getVariable(TypeID::dX, pppUnkSet).getNowIndex());
 		int idy(getVariable(TypeID::dY, pppUnkSet).getNowIndex());
 		int idz(getVariable(TypeID::dZ, pppUnkSet).getNowIndex());
@@ -465,6 +519,7 @@ to float solution!");
 
 			DD(i, ind2) = -1.0;
 			DD(i, ind1) = 1.0;
+			ddRows[i] = SDRow(ind1, 1.0, ind2, -1.0);
 			BcFloat = itData->second.sdFloatAmb[0];
 			std::cout << BcFloat << std::endl;
 
@@ -502,8 +557,8 @@ to float solution!");
 		/*get result*/
 		try
 		{
-			Matrix<double> DDT(transpose(DD));
-			QQ = DD * P * DDT;
+			// DD * P * DD^T
+			gatherCov(ddRows, P, QQ);
 			
 			for (i = 0; i < nb; i++) for (j = 0; j < nb; j++)	Qb(i, j) = QQ(i, j);
 			for (i = 0; i < na; i++) for (j = 0; j < nb; j++)	Qab(i, j) = QQ(nb+i, j);
@@ -553,15 +608,18 @@ to float solution!");
 	bool PPPAR::LAMBDAFixIFNLAmb()
 		noexcept(false)
 	{
-		int ns(sdNLAmbValue.size()), nx(pppUnkSet.size()), n, info, i(0);
+		int ns(sdNLAmbValue.size()), i(0);
 
-		Matrix<double> Qnl(ns, ns), hNLT, H_NL(ns, nx, 0.), Qnl_(ns, ns);
-		Vector<double> s, Nl(ns), VAmb;
+		Matrix<double> Qnl, L, L_, F;
+		Vector<double> s, Nl(ns), D, D_, VAmb;
+		std::vector<SDRow> nlRows(ns);
 		//
-		// Sorting and selecting values according to 
-		// the variance value of the narrow lane ambiguity
+		// The ambiguities are sorted by the variance of the narrow lane
+		// ambiguity, and the partial search drops the largest ones first.
+		// They are stored here in reverse order, so that every subset
+		// tried is a trailing block of Qnl and shares its factorization.
 		//
-		i = 0;
+		i = ns - 1;
 		auto itData = sdNLAmbValue.begin();
 		for(itData;
 			itData != sdNLAmbValue.end();
@@ -569,23 +627,19 @@ to float solution!");
 		{
 			int indSat(itData->second.index[0]), indSatRef(itData->second.index[1]);
 			double lamNL(itData->second.coeff[0]);
-			H_NL(i, indSat) = 1.0 / lamNL;
-			H_NL(i, indSatRef) = -1.0 / lamNL;
+			nlRows[i] = SDRow(indSat, 1.0 / lamNL, indSatRef, -1.0 / lamNL);
 			Nl(i) = itData->second.floatVal[0];
 			// index
-			++i;
+			--i;
 		}	// End of for sdNLAmbValue
 		// End of coefficient matrix assignment.
-		// Calculate the Q matrix
+		// Calculate the Q matrix, H_NL * P * H_NL^T
 		try
 		{
-			hNLT = transpose(H_NL);
-			Qnl = H_NL * P * hNLT;
+			gatherCov(nlRows, P, Qnl);
 
 			if (debug)
 			{
-				std::cout << "H_NL" << std::endl;
-				std::cout << H_NL << std::endl;
 				std::cout << "Qnl" << std::endl;
 				std::cout << Qnl << std::endl;
 			}
@@ -597,35 +651,66 @@ to float solution!");
 				<< e.getLocation() << std::endl;
 			GPSTK_THROW(e);
 		}
-		// partial ambiguity search
+
+		// Qnl = L'*diag(D)*L, computed from the last row up: the rows
+		// before a non positive pivot are left out of every subset
+		int first(0);
+		factorize(Qnl, L, D);
+		for (int k = ns - 1; k >= 0; k--)
+		{
+			if (!(D(k) > 0.0))
+			{
+				first = k + 1;
+				break;
+			}
+		}
+
+		// partial ambiguity search, on the trailing blocks of size i
 		for (i = ns; i > 2; i--)
 		{
-			VAmb.resize(i);
-			Qnl_.resize(i, i);
-			for (int m = 0; m < i; m++)
+			const int start(ns - i);
+			if (start < first)
 			{
-				VAmb(m) = Nl(m);
-				for (int n = 0; n < i; n++)
-					Qnl_(m, n) = Qnl(m, n);
+				sdNLAmbValue.erase(std::prev(sdNLAmbValue.rbegin().base()));
+				continue;
 			}
-			NLAmbF.resize(i, 2);
-			// calculate the ADOP value and check
-			double ADOP(det(Qnl_));
+
+			// calculate the ADOP value and check, det(Qnl_) = prod(D)
+			double ADOP(1.0);
+			for (int k = start; k < ns; k++)
+				ADOP *= D(k);
 			if (ADOP > ::pow(0.14, 2 * i))
 			{
 				sdNLAmbValue.erase(std::prev(sdNLAmbValue.rbegin().base()));
 				continue;
 			}
-			if (lambda(VAmb, Qnl_, NLAmbF, s, 2))
+
+			VAmb.resize(i);
+			L_.resize(i, i);
+			D_.resize(i);
+			for (int m = 0; m < i; m++)
+			{
+				VAmb(m) = Nl(start + m);
+				D_(m) = D(start + m);
+				for (int n = 0; n < i; n++)
+					L_(m, n) = L(start + m, start + n);
+			}
+			if (lambdaFactored(VAmb, L_, D_, F, s, 2))
 			{
 				sdNLAmbValue.erase(std::prev(sdNLAmbValue.rbegin().base()));
 				continue;
 			}
 
+			// back to the order of sdNLAmbValue
+			NLAmbF.resize(i, 2);
+			for (int m = 0; m < i; m++)
+			{
+				NLAmbF(m, 0) = F(i - 1 - m, 0);
+				NLAmbF(m, 1) = F(i - 1 - m, 1);
+			}
+
 			if (debug)
 			{
-				std::cout << "Qnl_" << std::endl;
-				std::cout << Qnl_ << std::endl;
 				std::cout << "NL Ambiguity Fixed: " << std::endl;
 				std::cout << NLAmbF << std::endl;
 				std::cout << "s" << std::endl;
@@ -761,7 +846,22 @@ to float solution!");
 			else
 			{
 				if (opts.ambFixMode == Options::SDIFILS)
-					return LAMBDAFixIFNLAmb();
+				{
+					resetStats();
+					bool fixed(LAMBDAFixIFNLAmb());
+					if (pTraceStream && pTraceStream->isTraced())
+					{
+						const LambdaStats& st(getTotalStats());
+						std::ostringstream oss;
+						oss << st.calls << " " << st.nodes << " "
+							<< st.shrinks << " " << st.gaussOps << " "
+							<< st.permutations << " " << st.failures << " "
+							<< st.seconds * 1e3;
+						traceT(pTraceStream, "LAMBDA calls/nodes/shrinks/"
+							"gauss/permutations/failures/ms: ", oss.str());
+					}
+					return fixed;
+				}
 				else if (opts.ambFixMode == Options::SDIFROUND)
 				{
 					arData.NFixed = arData.NFixedNn;
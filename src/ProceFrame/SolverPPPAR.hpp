@@ -21,6 +21,7 @@
 #include "ComputeDerivative.hpp"
 #include "EquSys.hpp"
 #include "Trace.hpp"
+#include "SolutionWriter.hpp"
 
 //#include "Trace.hpp"
 
@@ -80,10 +81,10 @@ namespace fippp
 			frq = opt.frqs;
 		}
 
-		void setStream(std::ofstream* solStream)
+		void setStream(SolutionStream* solStream)
 		{ pSolStream = solStream; }
 
-		void setTraceStream(std::ofstream* stream)
+		void setTraceStream(TraceStream* stream)
 		{ pTraceStream = stream; }
 
 		void setSolutions(const Vector<double>& sols)
@@ -101,7 +102,7 @@ namespace fippp
 		Matrix<double> getPminus() const
 		{ return P; }
 
-		void setUPD(UPDDataReader& pUpd)
+		void setUPD(const UPDDataReader& pUpd)
 		{ pUPDData = &pUpd; }
 
 		virtual ~PPPAR() {};
@@ -298,13 +299,13 @@ namespace fippp
 		// satellite-elve map
 		MapElvSat ElvSatMap;
 		// upd data 
-		UPDDataReader* pUPDData;
+		const UPDDataReader* pUPDData;
 		// float solution reference position
 		Position refPos;
 		Position rcvPos;
 		// out file stream
-		std::ofstream* pSolStream;
-		std::ofstream* pTraceStream;
+		SolutionStream* pSolStream;
+		TraceStream* pTraceStream;
 		// epoch ARData
 		ARData arData;
 		valueSatFixMap sdNLAmbValue;
@@ -18,7 +18,7 @@ using namespace gpstk::StringUtils;
 
 namespace fippp
 {
-	int SolverPPPAll::classIndex = 9600000;
+	std::atomic<int> SolverPPPAll::classIndex(9600000);
 
 	int SolverPPPAll::getIndex() const
 	{ return index; }
@@ -3915,12 +3915,14 @@ namespace fippp
 			{
 				equSystem.dumpEquations(cout);
 			}
-			int numUnknowns( equSystem.getTotalNumVariables() );
+			// the columns of the unknowns are kept from one epoch to the
+			// next by EquSys, plus some spare columns (see the constructor)
+			int numColumns( equSystem.getNumColumns() );
 
 			currentUnkSet = equSystem.getVarUnknowns();
 			
 			measVector = equSystem.getPrefitsVector();
-			hMatrix = equSystem.getGeometryMatrix();
+			hMatrix = equSystem.getGeometryRows();
 			rMatrix = equSystem.getWeightsMatrix();
 
 			if (bdsComb)
@@ -3942,94 +3944,104 @@ namespace fippp
 			// reset filter
 			CommonTime epoch(gRin.header.epoch);
 
-			if (firstTime)
+			// previous column of the unknown of each column, -1 for new
+			// unknowns and spare columns. The spare columns have variance
+			// 1 and no correlation, so they stay out of the filter.
+			std::vector<int> oldIndex(numColumns, -1);
+			std::vector<double> initVar(numColumns, 1.0);
+			for (const auto& v : currentUnkSet)
 			{
-				Vector<double> initialState(numUnknowns, 0.0);
-				Matrix<double> initialCov(numUnknowns, numUnknowns, 0.0);
-				for (auto v : currentUnkSet)
+				int nowIndex = v.getNowIndex();
+				oldIndex[nowIndex] = firstTime ? -1 : v.getPreIndex();
+				initVar[nowIndex] = v.getInitialVariance();
+			}
+
+			if (firstTime || numColumns != static_cast<int>(P.rows()))
+			{
+				// first epoch, or EquSys added or compacted the spare
+				// columns: copy the kept unknowns to a new matrix
+				Vector<double> currentState(numColumns, 0.0);
+				Matrix<double> currentCov(numColumns, numColumns, 0.0);
+				for (int j = 0; j < numColumns; j++)
 				{
-					int index = v.getNowIndex();
-					initialCov(index, index) = v.getInitialVariance();
+					int oldJ = oldIndex[j];
+					// new variable, only the diagonal element is assigned
+					if (oldJ == -1)
+					{
+						currentCov(j, j) = initVar[j];
+						continue;
+					}
+
+					currentState(j) = xhat(oldJ);
+					for (int i = 0; i < numColumns; i++)
+					{
+						int oldI = oldIndex[i];
+						if (oldI != -1)
+							currentCov(i, j) = P(oldI, oldJ);
+					}
 				}
 
-				// reset kalman filter state and covariance matrix
-				xhat = initialState;
-				P = initialCov;
+				// Reset Kalman filter to current state and covariance matrix
+				xhat = currentState;
+				P = currentCov;
 
 				// firstTime false
 				firstTime = false;
 			}
 			else
 			{
-				Vector<double> currentState(numUnknowns, 0.0);
-				Matrix<double> currentCov(numUnknowns, numUnknowns, 0.0);
-				// Fill the state vector
-				for (auto v : currentUnkSet)
+				// xhat and P still hold the last solution. Only the
+				// columns whose unknown changed are written, O(n) each:
+				// the unknowns moved from the end into the column of an
+				// unknown that set, then the new unknowns and the spare
+				// columns.
+				std::vector<int> moved;
+				for (int j = 0; j < numColumns; j++)
 				{
-					int now_index = v.getNowIndex();
-					int old_index = v.getPreIndex();
-					if (old_index != -1)
-					{
-						currentState(now_index) = solution(old_index);
-					}
+					if (oldIndex[j] != -1 && oldIndex[j] != j)
+						moved.push_back(j);
 				}
 
-				// We need a copy of 'currentUnkSet'
-				VariableSet tempSet(currentUnkSet);
-				for (auto v : currentUnkSet)
+				// rows first, then columns, so the elements between two
+				// moved unknowns are read from the right place
+				for (size_t k = 0; k < moved.size(); k++)
 				{
-					int nowIndex = v.getNowIndex();
-					int oldIndex = v.getPreIndex();
+					int j(moved[k]), oldJ(oldIndex[moved[k]]);
+					xhat(j) = xhat(oldJ);
+					for (int i = 0; i < numColumns; i++)
+						P(j, i) = P(oldJ, i);
+				}
+				for (size_t k = 0; k < moved.size(); k++)
+				{
+					int j(moved[k]), oldJ(oldIndex[moved[k]]);
+					for (int i = 0; i < numColumns; i++)
+						P(i, j) = P(i, oldJ);
+				}
 
-					// old Variable
-					if (oldIndex != -1)
-					{
-						for (auto v2 : tempSet)
-						{
-							int nowIndex2 = v2.getNowIndex();
-							int oldIndex2 = v2.getPreIndex();
-
-							// old Variable
-							if (oldIndex2 != -1)
-							{
-								currentCov(nowIndex, nowIndex2)
-									= currentCov(nowIndex2, nowIndex)
-									= covMatrix(oldIndex, oldIndex2);
-							}
-							else // new variable
-							{
-								currentCov(nowIndex, nowIndex2)
-									= currentCov(nowIndex2, nowIndex)
-									= 0.0;
-							}
-						}
-					}
-					else // new variable
+				for (int j = 0; j < numColumns; j++)
+				{
+					if (oldIndex[j] != -1)
+						continue;
+
+					xhat(j) = 0.0;
+					for (int i = 0; i < numColumns; i++)
 					{
-						// only diagnol element is assigned to the new variable
-						currentCov(nowIndex, nowIndex) = v.getInitialVariance();
+						P(i, j) = 0.0;
+						P(j, i) = 0.0;
 					}
-
-					// erase var
-					tempSet.erase(v);
-
-				}  // End of for( VariableSet::const_iterator itVar1 = currentUnkSet...'
-
-				   // Reset Kalman filter to current state and covariance matrix
-				xhat = currentState;
-				P = currentCov;
-
+					P(j, j) = initVar[j];
+				}
 			}	// end of if firstTime
 
 
 
-			// State Transition Matrix (PhiMatrix)
-			phiMatrix = equSystem.getPhiMatrix();
-			qMatrix = equSystem.getQMatrix();
+			// State Transition Matrix (PhiMatrix), diagonal
+			phiVector = equSystem.getPhiVector();
+			qVector = equSystem.getQVector();
 
 			traceSet(pTraceStream, "unknown state: ", currentUnkSet);
-			traceMatrix(pTraceStream, "preFilter phiMatrix: ", phiMatrix);
-			traceMatrix(pTraceStream, "preFilter qMatrix: ", qMatrix);
+			traceVector(pTraceStream, "preFilter phiVector: ", phiVector);
+			traceVector(pTraceStream, "preFilter qVector: ", qVector);
 
 			if (0)
 			{
@@ -4040,11 +4052,11 @@ namespace fippp
 				{
 					cout << *itUnk << std::endl;
 				}
-				cout << "phiMatrix" << endl;
-				cout << phiMatrix << endl;
+				cout << "phiVector" << endl;
+				cout << phiVector << endl;
 
-				cout << "qMatrix" << endl;
-				cout << qMatrix << endl;
+				cout << "qVector" << endl;
+				cout << qVector << endl;
 			}
 
 		}
@@ -4066,7 +4078,7 @@ namespace fippp
 	/// <returns></returns>
 	gnssRinex& SolverPPPAll::Compute(gnssRinex& gRin)
 	{
-		TimeUpdate(phiMatrix, qMatrix);
+		TimeUpdate(phiVector, qVector);
 		MeasUpdate(measVector, hMatrix, rMatrix);
 		//KalmanFilter(phiMatrix, qMatrix, measVector, hMatrix, rMatrix);
 		return gRin;
@@ -4200,22 +4212,15 @@ namespace fippp
 	/// <summary>
 	/// 
 	/// </summary>
-	/// <param name="phiMatrix"></param>
-	/// <param name="processNoiseCovariance"></param>
+	/// <param name="phiVector"></param>
+	/// <param name="qVector"></param>
 	/// <returns></returns>
-	int SolverPPPAll::TimeUpdate(const Matrix<double>& phiMatrix,
-		const Matrix<double>& processNoiseCovariance)
+	int SolverPPPAll::TimeUpdate(const Vector<double>& phiVector,
+		const Vector<double>& qVector)
 		noexcept(false)
 	{
-		// Check whether the phiMatrix is square
-		if (!(phiMatrix.isSquare()))
-		{
-			InvalidSolver e("phiMatrix is not square");
-			GPSTK_THROW(e);
-		}
-
-		// Get the number of unknowns being processed
-		int numUnknowns(equSystem.getTotalNumVariables());
+		// Get the number of unknowns being processed, with the spare columns
+		int numUnknowns(equSystem.getNumColumns());
 		int stateSize(xhat.size());
 		if (!(stateSize == numUnknowns))
 		{
@@ -4224,36 +4229,51 @@ do not match the number of unknowns");
 			GPSTK_THROW(e);
 		}
 
-		int phiRow = static_cast<int>(phiMatrix.rows());
+		int phiRow = static_cast<int>(phiVector.size());
 		if (!(phiRow == numUnknowns))
 		{
 			InvalidSolver e("Number of unknowns does not match dimension \
-of phiMatrix");
+of phiVector");
 			GPSTK_THROW(e);
 		}
 
-		if (!(qMatrix.isSquare()))
-		{
-			InvalidSolver e("qMatrix is not square");
-			GPSTK_THROW(e);
-		}
-
-		int qRow = static_cast<int>(qMatrix.rows());
+		int qRow = static_cast<int>(qVector.size());
 		if (!(qRow == numUnknowns))
 		{
 			InvalidSolver e("Number of unknowns does not match dimension \
-of qMatrix");
+of qVector");
 			GPSTK_THROW(e);
 		}
 
 		try
 		{
-			// Compute the a priori state vector
-			xhatminus = phiMatrix * xhat;	
-			Matrix<double> phiT(transpose(phiMatrix));
-			// Compute the a priori estimate error covariance matrix
-			Pminus = phiMatrix * P * phiT + processNoiseCovariance;
+			const size_t n(numUnknowns);
+
+			// Compute the a priori state vector, x- = Phi * x
+			xhatminus.resize(n);
+			for (size_t i = 0; i < n; i++)
+				xhatminus(i) = phiVector(i) * xhat(i);
+
+			// Compute the a priori estimate error covariance matrix,
+			// Phi * P * Phi^T + Q. With a diagonal Phi this is P with the
+			// rows and columns of the unknowns with phi != 1 (white noise
+			// and reset states) scaled, plus Q on the diagonal.
+			Pminus = P;
+			for (size_t i = 0; i < n; i++)
+			{
+				const double phi(phiVector(i));
+				if (phi == 1.0)
+					continue;
 
+				for (size_t j = 0; j < n; j++)
+				{
+					Pminus(i, j) *= phi;
+					Pminus(j, i) *= phi;
+				}
+			}
+
+			for (size_t i = 0; i < n; i++)
+				Pminus(i, i) += qVector(i);
 		}
 		catch (...)
 		{
@@ -4273,7 +4293,7 @@ of qMatrix");
 	/// <param name="weightMatrix"></param>
 	/// <returns></returns>
 	int SolverPPPAll::MeasUpdate(const Vector<double>& prefitResiduals,
-		const Matrix<double>& designMatrix,
+		const SparseRowMatrix& designMatrix,
 		const Matrix<double>& weightMatrix)
 		noexcept(false)
 	{
@@ -4323,10 +4343,17 @@ matrix and a priori state estimation vector do not match.");
 			GPSTK_THROW(e);
 		}
 
+		// UD factorized update, the information form below is kept
+		// as fallback when the factorization fails
+		if (opts.measUpdate == Options::UDSeq &&
+			MeasUpdateUD(prefitResiduals, designMatrix, weightMatrix) == 0)
+		{
+			return 0;
+		}
+
 		//Matrix<double> invWeight(inverseChol(weightMatrix));
 		//// After checking sizes, let's do the real correction work
 		Matrix<double> invPMinus;
-		Matrix<double> designMatrixT(transpose(designMatrix));
 
 		try
 		{
@@ -4339,13 +4366,48 @@ matrix and a priori state estimation vector do not match.");
 			return -1;
 		}
 
+		// H^T * W, with the products of H summed over the nonzero
+		// elements only, in the order of the dense product
+		const size_t nObs(pRow), nUnk(aprioriStateRow);
+		Matrix<double> htw(nUnk, nObs, 0.0);
+		std::vector<size_t> wCols;
+		for (size_t i = 0; i < nObs; i++)
+		{
+			wCols.clear();
+			for (size_t k = 0; k < nObs; k++)
+			{
+				if (weightMatrix(i, k) != 0.0)
+					wCols.push_back(k);
+			}
+
+			for (size_t e = designMatrix.begin(i); e < designMatrix.end(i); e++)
+			{
+				const size_t j(designMatrix.col(e));
+				const double h(designMatrix.val(e));
+				for (size_t c = 0; c < wCols.size(); c++)
+					htw(j, wCols[c]) += h * weightMatrix(i, wCols[c]);
+			}
+		}
+
 		try
 		{
-			Matrix<double> invTemp(designMatrixT * weightMatrix * designMatrix +
-				invPMinus);
+			// H^T * W * H + inverse(P-)
+			Matrix<double> invTemp(nUnk, nUnk, 0.0);
+			for (size_t k = 0; k < nObs; k++)
+			{
+				for (size_t e = designMatrix.begin(k); e < designMatrix.end(k); e++)
+				{
+					const size_t l(designMatrix.col(e));
+					const double h(designMatrix.val(e));
+					for (size_t j = 0; j < nUnk; j++)
+					{
+						if (htw(j, k) != 0.0)
+							invTemp(j, l) += htw(j, k) * h;
+					}
+				}
+			}
+			invTemp += invPMinus;
 			
-			/*Matrix<double> invTemp(designMatrixT * invWeight * designMatrix +
-				invPMinus);*/
 			// Compute the a posteriori error covariance matrix
 			P = inverseChol(invTemp);
 		}
@@ -4358,10 +4420,8 @@ matrix and a priori state estimation vector do not match.");
 
 		try
 		{
-			xhat = P * ((designMatrixT * weightMatrix * prefitResiduals) +
+			xhat = P * ((htw * prefitResiduals) +
 				(invPMinus * xhatminus));
-			/*xhat = P * ((designMatrixT * invWeight * prefitResiduals) +
-				(invPMinus * xhatminus));*/
 		}
 		catch (Exception e)
 		{
@@ -4386,6 +4446,203 @@ matrix and a priori state estimation vector do not match.");
 		return 0;
 	}	// end of measUpdate();
 	/// <summary>
+	/// factorize the symmetric matrix P = U * D * U^T (Bierman),
+	/// columns are solved from the last one to the first one
+	/// </summary>
+	/// <param name="pMatrix"> symmetric positive definite matrix </param>
+	/// <param name="uMatrix"> unit upper triangular factor </param>
+	/// <param name="dVector"> diagonal factor </param>
+	/// <returns> false if pMatrix is not positive definite </returns>
+	bool SolverPPPAll::factorUD(const Matrix<double>& pMatrix,
+		Matrix<double>& uMatrix, Vector<double>& dVector) const
+	{
+		const size_t n(pMatrix.rows());
+		uMatrix.resize(n, n, 0.0);
+		dVector.resize(n, 0.0);
+
+		for (size_t jj = n; jj > 0; jj--)
+		{
+			size_t j(jj - 1);
+
+			double d(pMatrix(j, j));
+			for (size_t k = j + 1; k < n; k++)
+				d -= dVector(k) * uMatrix(j, k) * uMatrix(j, k);
+
+			if (!(d > 0.0))
+				return false;
+
+			dVector(j) = d;
+			uMatrix(j, j) = 1.0;
+
+			for (size_t i = 0; i < j; i++)
+			{
+				double sum(pMatrix(i, j));
+				for (size_t k = j + 1; k < n; k++)
+					sum -= dVector(k) * uMatrix(i, k) * uMatrix(j, k);
+				uMatrix(i, j) = sum / d;
+			}
+		}
+
+		return true;
+	}	// end of factorUD()
+	/// <summary>
+	/// UD factorized measurement update. The observations are whitened
+	/// with the cholesky factor of each block of the weight matrix
+	/// (a block holds the correlated equations of one satellite, a
+	/// diagonal weight gives blocks of one) and then processed one by
+	/// one with the Bierman scalar update, so no n*n inverse is formed.
+	/// </summary>
+	/// <param name="prefitResiduals"></param>
+	/// <param name="designMatrix"></param>
+	/// <param name="weightMatrix"></param>
+	/// <returns> 0 if success, -1 if a factorization failed and the
+	/// filter is unchanged </returns>
+	int SolverPPPAll::MeasUpdateUD(const Vector<double>& prefitResiduals,
+		const SparseRowMatrix& designMatrix,
+		const Matrix<double>& weightMatrix)
+		noexcept(false)
+	{
+		const size_t nObs(prefitResiduals.size());
+		const size_t nUnk(xhatminus.size());
+
+		Matrix<double> uMatrix;
+		Vector<double> dVector;
+		if (!factorUD(Pminus, uMatrix, dVector))
+			return -1;
+
+		Vector<double> x(xhatminus);
+
+		// whitened observation row and its residual
+		Vector<double> h(nUnk, 0.0), f(nUnk, 0.0), v(nUnk, 0.0), b(nUnk, 0.0);
+
+		size_t start(0);
+		while (start < nObs)
+		{
+			// the block ends at the last equation correlated with any
+			// equation of the block
+			size_t end(start);
+			for (size_t k = start; k <= end; k++)
+			{
+				for (size_t j = nObs; j > end + 1; j--)
+				{
+					if (weightMatrix(k, j - 1) != 0.0)
+					{
+						end = j - 1;
+						break;
+					}
+				}
+			}
+			const size_t m(end - start + 1);
+
+			// cholesky of the weight block, Wb = L * L^T
+			Matrix<double> L(m, m, 0.0);
+			for (size_t j = 0; j < m; j++)
+			{
+				double d(weightMatrix(start + j, start + j));
+				for (size_t k = 0; k < j; k++)
+					d -= L(j, k) * L(j, k);
+				if (!(d > 0.0))
+					return -1;
+
+				L(j, j) = std::sqrt(d);
+				for (size_t i = j + 1; i < m; i++)
+				{
+					double sum(weightMatrix(start + i, start + j));
+					for (size_t k = 0; k < j; k++)
+						sum -= L(i, k) * L(j, k);
+					L(i, j) = sum / L(j, j);
+				}
+			}
+
+			// L^T * e has unit covariance, so each whitened row is a
+			// scalar observation with variance 1
+			for (size_t r = 0; r < m; r++)
+			{
+				double z(0.0);
+				for (size_t c = 0; c < nUnk; c++)
+					h(c) = 0.0;
+				for (size_t k = r; k < m; k++)
+				{
+					double l(L(k, r));
+					if (l == 0.0)
+						continue;
+					z += l * prefitResiduals(start + k);
+					for (size_t e = designMatrix.begin(start + k);
+						e < designMatrix.end(start + k); e++)
+						h(designMatrix.col(e)) += l * designMatrix.val(e);
+				}
+
+				// innovation with respect to the current state
+				double innov(z);
+				for (size_t c = 0; c < nUnk; c++)
+					innov -= h(c) * x(c);
+
+				// f = U^T * h, v = D * f
+				for (size_t j = 0; j < nUnk; j++)
+				{
+					double sum(h(j));
+					for (size_t i = 0; i < j; i++)
+						sum += uMatrix(i, j) * h(i);
+					f(j) = sum;
+					v(j) = dVector(j) * sum;
+				}
+
+				// Bierman update of U, D and the unscaled gain b
+				double alpha(1.0);
+				for (size_t j = 0; j < nUnk; j++)
+				{
+					double beta(alpha);
+					alpha += f(j) * v(j);
+					double lambda(-f(j) / beta);
+					dVector(j) *= beta / alpha;
+
+					for (size_t i = 0; i < j; i++)
+					{
+						double uij(uMatrix(i, j));
+						uMatrix(i, j) = uij + b(i) * lambda;
+						b(i) += uij * v(j);
+					}
+					b(j) = v(j);
+				}
+
+				for (size_t j = 0; j < nUnk; j++)
+					x(j) += b(j) / alpha * innov;
+			}
+
+			start = end + 1;
+		}
+
+		// P = U * D * U^T
+		P.resize(nUnk, nUnk);
+		for (size_t j = 0; j < nUnk; j++)
+		{
+			for (size_t i = 0; i <= j; i++)
+			{
+				double sum(0.0);
+				for (size_t k = j; k < nUnk; k++)
+					sum += uMatrix(i, k) * dVector(k) * uMatrix(j, k);
+				P(i, j) = sum;
+				P(j, i) = sum;
+			}
+		}
+
+		xhat = x;
+		xhatminus = xhat;
+		Pminus = P;
+		solution = xhat;
+		covMatrix = P;
+		// Compute the postfit residuals Vector
+		postfitResiduals = prefitResiduals - (designMatrix * solution);
+		// If everything is fine so far, then the results should be valid
+		valid = true;
+
+		//trace
+		traceVector(pTraceStream, "afterFilter xhat: ", xhat);
+		traceVector(pTraceStream, "afterFilter postfitResiduals: ", postfitResiduals);
+
+		return 0;
+	}	// end of MeasUpdateUD()
+	/// <summary>
 	/// 
 	/// </summary>
 	/// <param name="type"></param>
@@ -4408,23 +4665,21 @@ matrix and a priori state estimation vector do not match.");
 		// Else, return the corresponding value
 		return tempVarSet;
 	}	//end of getVarSet()
-	void SolverPPPAll::printTime(std::ofstream* outStr,
+	void SolverPPPAll::printTime(SolutionStream* outStr,
 		const CommonTime& epoch)
 	{
 		YDSTime time(epoch);
 		CivilTime cvT(epoch);
 
 		// print time
-		*outStr << fixed
-			<< setprecision(2)
-			<< setw(4) << time.year
-			<< setw(3) << cvT.month
-			<< setw(3) << cvT.day
-			<< setw(3) << cvT.hour
-			<< setw(3) << cvT.minute
-			<< setw(6) << cvT.second
-			<< setw(4) << time.doy
-			<< setw(9) << time.sod;
+		outStr->putInt(time.year, 4)
+			.putInt(cvT.month, 3)
+			.putInt(cvT.day, 3)
+			.putInt(cvT.hour, 3)
+			.putInt(cvT.minute, 3)
+			.putFixed(cvT.second, 6, 2)
+			.putInt(time.doy, 4)
+			.putFixed(time.sod, 9, 2);
 	}
 	void SolverPPPAll::printOptState(const CommonTime& epoch,
 		const gnssRinex& gRin)
@@ -4433,78 +4688,78 @@ matrix and a priori state estimation vector do not match.");
 		if (opts.outState && !pFloatStaStream)
 		{
 			std::string fOutf = opts.aimOutPath + ".state";
-			pFloatStaStream = new ofstream(fOutf.c_str(), ios::out);
-			if (!pFloatStaStream->is_open())
+			pFloatStaStream = new SolutionStream;
+			if (!pFloatStaStream->open(fOutf, pSolWriter))
 			{
 				std::cout << "Cannot open file: " << fOutf << std::endl;
-				pFloatStaStream = NULL;
 				delete pFloatStaStream;
+				pFloatStaStream = NULL;
 			}
 		}
 		if (opts.outAmb && !pFloatAmbStream)
 		{
 			std::string fOutf = opts.aimOutPath + ".amb";
-			pFloatAmbStream = new ofstream(fOutf.c_str(), ios::out);
-			if (!pFloatAmbStream->is_open())
+			pFloatAmbStream = new SolutionStream;
+			if (!pFloatAmbStream->open(fOutf, pSolWriter))
 			{
 				std::cout << "Cannot open file: " << fOutf << std::endl;
-				pFloatAmbStream = NULL;
 				delete pFloatAmbStream;
+				pFloatAmbStream = NULL;
 			}
 		}
 		if (opts.outEle && !pEleAziStream)
 		{
 			std::string fOutf = opts.aimOutPath + ".ele";
-			pEleAziStream = new ofstream(fOutf.c_str(), ios::out);
-			if (!pEleAziStream->is_open())
+			pEleAziStream = new SolutionStream;
+			if (!pEleAziStream->open(fOutf, pSolWriter))
 			{
 				std::cout << "Cannot open file: " << fOutf << std::endl;
-				pEleAziStream = NULL;
 				delete pEleAziStream;
+				pEleAziStream = NULL;
 			}
 		}
 		if (opts.outPdop && !pPDOPStream)
 		{
 			std::string fOutf = opts.aimOutPath + ".pdop";
-			pPDOPStream = new ofstream(fOutf.c_str(), ios::out);
-			if (!pPDOPStream->is_open())
+			pPDOPStream = new SolutionStream;
+			if (!pPDOPStream->open(fOutf, pSolWriter))
 			{
 				std::cout << "Cannot open file: " << fOutf << std::endl;
-				pPDOPStream = NULL;
 				delete pPDOPStream;
+				pPDOPStream = NULL;
 			}
 		}
 		if (opts.outResL && !pResLStream)
 		{
 			std::string fOutf = opts.aimOutPath + ".resl";
-			pResLStream = new ofstream(fOutf.c_str(), ios::out);
-			if (!pResLStream->is_open())
+			pResLStream = new SolutionStream;
+			if (!pResLStream->open(fOutf, pSolWriter))
 			{
 				std::cout << "Cannot open file: " << fOutf << std::endl;
-				pResLStream = NULL;
 				delete pResLStream;
+				pResLStream = NULL;
 			}
 		}
 		if (opts.outResP && !pResPStream)
 		{
 			std::string fOutf = opts.aimOutPath + ".resp";
-			pResPStream = new ofstream(fOutf.c_str(), ios::out);
-			if (!pResPStream->is_open())
+			pResPStream = new SolutionStream;
+			if (!pResPStream->open(fOutf, pSolWriter))
 			{
 				std::cout << "Cannot open file: " << fOutf << std::endl;
-				pResPStream = NULL;
 				delete pResPStream;
+				pResPStream = NULL;
 			}
 		}
 		if (opts.outTrop && !pTropStream)
 		{
 			std::string fOutf = opts.aimOutPath + ".trop";
-			pTropStream = new ofstream(fOutf.c_str(), ios::out);
-			if (!pTropStream->is_open())
+			pTropStream = new SolutionStream;
+			if (!pTropStream->open(fOutf, pSolWriter))
 			{
 				std::cout << "Cannot open file: " << fOutf << std::endl;
-				pTropStream = NULL;
 				delete pTropStream;
+				pTropStream = NULL;
 			}
 		}
 		// End of out file stream
@@ -4517,8 +4772,8 @@ matrix and a priori state estimation vector do not match.");
 			// print time line
 			*pFloatStaStream << "# ";
 			printTime(pFloatStaStream, epoch);
-			*pFloatStaStream << setw(6) << gRin.numSats();
-			*pFloatStaStream << std::endl;
+			pFloatStaStream->putInt(gRin.numSats(), 6);
+			pFloatStaStream->endl();
 			// record data
 			satTypeStrValue satValues;
 			auto itData = gRin.body.begin();
@@ -4590,7 +4845,7 @@ matrix and a priori state estimation vector do not match.");
 				*pFloatStaStream << " " << asChar(sat.system);
 				if (sat.id < 10)
 					*pFloatStaStream << "0";
-				*pFloatStaStream << sat.id;
+				pFloatStaStream->putInt(sat.id);
 				// out values
 				for (auto itType = itValues->second.begin();
 					itType != itValues->second.end();
@@ -4599,17 +4854,12 @@ matrix and a priori state estimation vector do not match.");
 					string strType(itType->first);
 					double value(itType->second);
 					// out type
-					*pFloatStaStream
-						<< setw(10)
-						<< strType;
+					pFloatStaStream->putText(strType, 10);
 					// out value
-					*pFloatStaStream
-						<< fixed
-						<< setprecision(4)
-						<< setw(11) << value;
+					pFloatStaStream->putFixed(value, 11, 4);
 				}	// End of the types
 				// new line
-				*pFloatStaStream << endl;
+				pFloatStaStream->endl();
 			}	// End of for loop the data
 		}	// End of output states
 		if (pPDOPStream)
@@ -4617,23 +4867,18 @@ matrix and a priori state estimation vector do not match.");
 			// print time
 			*pPDOPStream << "# ";
 			printTime(pPDOPStream, epoch);
-			*pPDOPStream << setw(6) << gRin.numSats();
+			pPDOPStream->putInt(gRin.numSats(), 6);
 			*pPDOPStream << " #";
 			double value(gRin.header.dops[1]);
-			*pPDOPStream
-				<< fixed
-				<< setprecision(4)
-				<< setw(10)
-				<< value
-				<< endl;
+			pPDOPStream->putFixed(value, 10, 4).endl();
 		}
 		if (pFloatAmbStream)
 		{
 			// print time
 			*pFloatAmbStream << "# ";
 			printTime(pFloatAmbStream, epoch);
-			*pFloatAmbStream << setw(6) << gRin.numSats();
-			*pFloatAmbStream << std::endl;
+			pFloatAmbStream->putInt(gRin.numSats(), 6);
+			pFloatAmbStream->endl();
 			// print value
 			satTypeStrValue satValues;
 			// record data
@@ -4663,7 +4908,7 @@ matrix and a priori state estimation vector do not match.");
 				*pFloatAmbStream << " " << asChar(sat.system);
 				if (sat.id < 10)
 					*pFloatAmbStream << "0";
-				*pFloatAmbStream << sat.id;
+				pFloatAmbStream->putInt(sat.id);
 				// out values
 				for(auto itType=itValues->second.begin();
 					itType!=itValues->second.end();
@@ -4672,26 +4917,21 @@ matrix and a priori state estimation vector do not match.");
 					string strType(itType->first);
 					double value(itType->second);
 					// out type
-					*pFloatAmbStream
-						<< setw(10)
-						<< strType;
+					pFloatAmbStream->putText(strType, 10);
 					// out value
-					*pFloatAmbStream
-						<< fixed
-						<< setprecision(4)
-						<< setw(10) << value;
+					pFloatAmbStream->putFixed(value, 10, 4);
 				}	// End of the types
 				// new line
-				*pFloatAmbStream << endl;
+				pFloatAmbStream->endl();
 			}	// End of for loop the data
 		}	// End of if pFloatAmbStream
 		if (pEleAziStream)
 		{
 			// time
-			(*pEleAziStream) << "# ";
+			*pEleAziStream << "# ";
 			printTime(pEleAziStream, epoch);
-			*pEleAziStream << setw(6) << gRin.numSats();
-			*pEleAziStream << endl;
+			pEleAziStream->putInt(gRin.numSats(), 6);
+			pEleAziStream->endl();
 			// value
 			auto itData = gRin.body.begin();
 			for (itData;
@@ -4706,41 +4946,34 @@ matrix and a priori state estimation vector do not match.");
 					<< asChar(sat.system);
 				if (sat.id < 10)
 					*pEleAziStream << "0";
-				* pEleAziStream 
-					<< sat.id
-					<< fixed
-					<< setprecision(4)
-					<< setw(10) << ele
-					<< setw(10) << azi
-					<< endl;
+				pEleAziStream->putInt(sat.id)
+					.putFixed(ele, 10, 4)
+					.putFixed(azi, 10, 4)
+					.endl();
 			}	// End of for loop
 		} // End of output elev azi
 		if (pTropStream)
 		{
 			// time
-			(*pTropStream) << "# ";
+			*pTropStream << "# ";
 			printTime(pTropStream, epoch);
-			*pTropStream << setw(6) << gRin.numSats();
+			pTropStream->putInt(gRin.numSats(), 6);
 			*pTropStream << " #";
 			// value
 			int ind(getVariable(TypeID::wetMap, currentUnkSet).getNowIndex());
 			double trop(solution(ind));
 			// out
-			*pTropStream
-				<< fixed
-				<< setprecision(4)
-				<< setw(10) << trop
-				<< endl;
+			pTropStream->putFixed(trop, 10, 4).endl();
 		}
 		if (pResLStream)
 		{
 			// variable
 			satTypeStrValue satValues;
 			// time
-			(*pResLStream) << "# ";
+			*pResLStream << "# ";
 			printTime(pResLStream, epoch);
-			*pResLStream << setw(6) << gRin.numSats();
-			*pResLStream << endl;
+			pResLStream->putInt(gRin.numSats(), 6);
+			pResLStream->endl();
 			int i(0);
 			auto itEqu = equSys.begin();
 			for (itEqu;
@@ -4769,7 +5002,7 @@ matrix and a priori state estimation vector do not match.");
 				*pResLStream << " " << asChar(sat.system);
 				if (sat.id < 10)
 					*pResLStream << "0";
-				*pResLStream << sat.id;
+				pResLStream->putInt(sat.id);
 				// out values
 				for(auto itType=itValues->second.begin();
 					itType!=itValues->second.end();
@@ -4778,17 +5011,12 @@ matrix and a priori state estimation vector do not match.");
 					string strType(itType->first);
 					double value(itType->second);
 					// out type
-					*pResLStream 
-						<< setw(10)
-						<< strType;
+					pResLStream->putText(strType, 10);
 					// out value
-					*pResLStream
-						<< fixed
-						<< setprecision(4)
-						<< setw(10) << value;
+					pResLStream->putFixed(value, 10, 4);
 				}	// End of for loop the types
 				// new line
-				*pResLStream << endl;
+				pResLStream->endl();
 			}	// End of for loop the record data
 		}
 		if (pResPStream)
@@ -4796,10 +5024,10 @@ matrix and a priori state estimation vector do not match.");
 			// variable
 			satTypeStrValue satValues;
 			// time
-			(*pResPStream) << "# ";
+			*pResPStream << "# ";
 			printTime(pResPStream, epoch);
-			*pResPStream << setw(6) << gRin.numSats();
-			*pResPStream << endl;
+			pResPStream->putInt(gRin.numSats(), 6);
+			pResPStream->endl();
 			// record data
 			int i(0);
 			auto itEqu = equSys.begin();
@@ -4829,7 +5057,7 @@ matrix and a priori state estimation vector do not match.");
 				*pResPStream << " " << asChar(sat.system);
 				if (sat.id < 10)
 					*pResPStream << "0";
-				*pResPStream << sat.id;
+				pResPStream->putInt(sat.id);
 				// out values
 				for (auto itType = itValues->second.begin();
 					itType != itValues->second.end();
@@ -4838,17 +5066,12 @@ matrix and a priori state estimation vector do not match.");
 					string strType(itType->first);
 					double value(itType->second);
 					// out type
-					*pResPStream
-						<< setw(10)
-						<< strType;
+					pResPStream->putText(strType, 10);
 					// out value
-					*pResPStream
-						<< fixed
-						<< setprecision(4)
-						<< setw(10) << value;
+					pResPStream->putFixed(value, 10, 4);
 				}	// End of for loop the types
 				// new line
-				*pResPStream << endl;
+				pResPStream->endl();
 			}	// End of for loop the record data
 		}	// End of if(pResPStream)
 
@@ -4856,7 +5079,7 @@ matrix and a priori state estimation vector do not match.");
 	void SolverPPPAll::printNewLine()
 	{
 		if (pFloatSolStream != NULL)
-			*pFloatSolStream << std::endl;
+			pFloatSolStream->endl();
 	}
 	/// <summary>
 	/// 
@@ -4866,7 +5089,7 @@ matrix and a priori state estimation vector do not match.");
 	/// <param name="stateVec"></param>
 	/// <param name="covMatrix"></param>
 	/// <param name="numSat"></param>
-	void SolverPPPAll::printSols(std::ofstream* outStr,
+	void SolverPPPAll::printSols(SolutionStream* outStr,
 		const CommonTime& epoch,
 		const Vector<double>& state,
 		const Matrix<double>& covMatrix,
@@ -4902,38 +5125,30 @@ matrix and a priori state estimation vector do not match.");
 			rmsXYZ = std::sqrt(SQR(dx_) + SQR(dy_) + SQR(dz_));
 		}
 		
-		*outStr << fixed
-			<< setprecision(4)
-			<< setw(15) << x
-			<< setw(15) << y
-			<< setw(15) << z;
+		outStr->putFixed(x, 15, 4)
+			.putFixed(y, 15, 4)
+			.putFixed(z, 15, 4);
 
 		if (outENU)
 		{
 			// out enu value
-			*outStr << fixed
-				<< setprecision(4)
-				<< setw(9) << e
-				<< setw(9) << n
-				<< setw(9) << u
-				<< setw(9) << rmsENU
-				<< setw(3) << 6
-				;
+			outStr->putFixed(e, 9, 4)
+				.putFixed(n, 9, 4)
+				.putFixed(u, 9, 4)
+				.putFixed(rmsENU, 9, 4)
+				.putInt(6, 3);
 		}
 		else
 		{
 			// out dx dy dz value
-			*outStr << fixed
-				<< setprecision(4)
-				<< setw(9) << dx_
-				<< setw(9) << dy_
-				<< setw(9) << dz_
-				<< setw(9) << rmsXYZ
-				<< setw(3) << 6
-				;
+			outStr->putFixed(dx_, 9, 4)
+				.putFixed(dy_, 9, 4)
+				.putFixed(dz_, 9, 4)
+				.putFixed(rmsXYZ, 9, 4)
+				.putInt(6, 3);
 		}
 		
-		* outStr << endl;
+		outStr->endl();
 	}	// end of printSols
 	/// <summary>
 	/// 
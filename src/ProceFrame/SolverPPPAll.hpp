@@ -3,6 +3,7 @@
 #ifndef FiPPP_SolverPPPAll_HPP
 #define FiPPP_SolverPPPAll_HPP
 
+#include <atomic>
 
 
 #include "SolverBase.hpp"
@@ -15,6 +16,7 @@
 #include "XYZ2ENU.hpp"
 
 #include "Trace.hpp"
+#include "SolutionWriter.hpp"
 
 using namespace gpstk;
 
@@ -34,6 +36,7 @@ namespace fippp
 			firstKalman(true),
 			pFloatSolStream(NULL),
 			pTraceStream(NULL),
+			pSolWriter(NULL),
 			pFloatStaStream(NULL),
 			pFloatAmbStream(NULL),
 			pEleAziStream(NULL),
@@ -45,6 +48,11 @@ namespace fippp
 			gpsCombTypeSet.clear();
 			galCombTypeSet.clear();
 			bdsCombTypeSet.clear();
+
+			// keep the columns of the unknowns between epochs, so a
+			// satellite that rises or sets only changes its own rows
+			// and columns of the covariance
+			equSystem.setFreeSlots(8);
 		}
 		// Set ambiguity parameter settings according to ionoopt
 		virtual SolverPPPAll& setAmbSet();
@@ -81,20 +89,25 @@ namespace fippp
 
 
 
-		/** Time Update of the kalman filter.
+		/** Time Update of the kalman filter. Phi and Q are diagonal, one
+		 *  stochastic model per unknown, so only the rows and columns of
+		 *  the unknowns with phi != 1 are touched.
 		 *
-		 * @param gData    Data object holding the data.
+		 * @param phiVector    diagonal of the state transition matrix.
+		 * @param qVector      diagonal of the process noise covariance.
 		 */
-		virtual int TimeUpdate(const Matrix<double>& phiMatrix,
-			const Matrix<double>& processNoiseCovariance)
+		virtual int TimeUpdate(const Vector<double>& phiVector,
+			const Vector<double>& qVector)
 			noexcept(false);
 
 		/** Measurement Update of the kalman filter.
 		 *
-		 * @param gData    Data object holding the data.
+		 * @param prefitResiduals    prefit residuals of the equations.
+		 * @param designMatrix       geometry matrix, in sparse rows.
+		 * @param weightMatrix       weights of the equations.
 		 */
 		virtual int MeasUpdate(const Vector<double>& prefitResiduals,
-			const Matrix<double>& designMatrix,
+			const SparseRowMatrix& designMatrix,
 			const Matrix<double>& weightMatrix)
 			noexcept(false);
 
@@ -138,15 +151,20 @@ namespace fippp
 		/// Returns an index identifying this object.
 		virtual void setUpEquations(void);
 
-		void setFwdOutStream(std::ofstream* pStream)
+		void setFwdOutStream(SolutionStream* pStream)
 		{
 			pFloatSolStream = pStream;
 		};
 
-		void setTraceStream(std::ofstream* pStream)
+		void setTraceStream(TraceStream* pStream)
 		{ pTraceStream = pStream; }
 
-		void printSols(std::ofstream* outStr,
+		/// writer of the .state, .amb, .ele, .pdop, .resl, .resp and
+		/// .trop files, NULL to write them in this thread
+		void setSolutionWriter(SolutionWriter* pWriter)
+		{ pSolWriter = pWriter; }
+
+		void printSols(SolutionStream* outStr,
 			const CommonTime& epoch,
 			const Vector<double>& stateVec,
 			const Matrix<double>& covMatrix,
@@ -157,7 +175,7 @@ namespace fippp
 		void printOptState(const CommonTime& epoch,
 			const gnssRinex& gRin);
 
-		void printTime(std::ofstream* outStr,
+		void printTime(SolutionStream* outStr,
 			const CommonTime& epoch);
 
 		virtual Variable getVariable(const TypeID& type,
@@ -218,23 +236,22 @@ namespace fippp
 
 		// default destructor
 		virtual ~SolverPPPAll() {
-			// free pointer
+			// free pointer, the solution stream belongs to the caller
 			pFloatSolStream = NULL;
-			delete pFloatSolStream;
-			pFloatStaStream = NULL;
 			delete pFloatStaStream;
-			pEleAziStream = NULL;
+			pFloatStaStream = NULL;
 			delete pEleAziStream;
-			pFloatAmbStream = NULL;
+			pEleAziStream = NULL;
 			delete pFloatAmbStream;
-			pPDOPStream = NULL;
+			pFloatAmbStream = NULL;
 			delete pPDOPStream;
-			pTropStream = NULL;
+			pPDOPStream = NULL;
 			delete pTropStream;
-			pResLStream = NULL;
+			pTropStream = NULL;
 			delete pResLStream;
-			pResPStream = NULL;
+			pResLStream = NULL;
 			delete pResPStream;
+			pResPStream = NULL;
 		};
 
 	private:
@@ -294,26 +311,27 @@ namespace fippp
 
 		CommonTime firtEpoch;
 
-		std::ofstream* pFloatSolStream;
-		std::ofstream* pTraceStream;
-
-		std::ofstream* pFloatAmbStream;
-		std::ofstream* pFloatStaStream;
-		std::ofstream* pEleAziStream;	// elevation, azimuth, trop and CS
-		std::ofstream* pResPStream;
-		std::ofstream* pResLStream;
-		std::ofstream* pPDOPStream;
-		std::ofstream* pTropStream;
+		SolutionStream* pFloatSolStream;
+		TraceStream* pTraceStream;
+		SolutionWriter* pSolWriter;
+
+		SolutionStream* pFloatAmbStream;
+		SolutionStream* pFloatStaStream;
+		SolutionStream* pEleAziStream;	// elevation, azimuth, trop and CS
+		SolutionStream* pResPStream;
+		SolutionStream* pResLStream;
+		SolutionStream* pPDOPStream;
+		SolutionStream* pTropStream;
 		/// matrix for solution
 
-		 /// State Transition Matrix (PhiMatrix)
-		Matrix<double> phiMatrix;
+		 /// Diagonal of the State Transition Matrix (PhiMatrix)
+		Vector<double> phiVector;
 
-		/// Noise covariance matrix (QMatrix)
-		Matrix<double> qMatrix;
+		/// Diagonal of the Noise covariance matrix (QMatrix)
+		Vector<double> qVector;
 
-		/// Geometry matrix
-		Matrix<double> hMatrix;
+		/// Geometry matrix, in sparse rows
+		SparseRowMatrix hMatrix;
 
 		/// Weights matrix
 		Matrix<double> rMatrix;
@@ -465,8 +483,9 @@ namespace fippp
 
 		TypeIDSet			reclkTypeSet;
 
-		/// Initial index assigned to this class.
-		static int classIndex;
+		/// Initial index assigned to this class; the stations are
+		/// processed by several threads.
+		static std::atomic<int> classIndex;
 
 		/// Index belonging to this object.
 		int index;
@@ -486,6 +505,26 @@ namespace fippp
 			const TypeID& type, double& a, double& b, double& c)
 			noexcept(false);		
 
+		/// <summary>
+		/// UD factorized measurement update, observations are
+		/// processed one by one and no inverse matrix is formed
+		/// </summary>
+		/// <param name="prefitResiduals"></param>
+		/// <param name="designMatrix"></param>
+		/// <param name="weightMatrix"></param>
+		/// <returns> -1 if Pminus or the weights are not positive definite </returns>
+		int MeasUpdateUD(const Vector<double>& prefitResiduals,
+			const SparseRowMatrix& designMatrix,
+			const Matrix<double>& weightMatrix)
+			noexcept(false);
+
+		/// <summary>
+		/// factorize the symmetric matrix P = U * D * U^T,
+		/// U is unit upper triangular, D is diagonal
+		/// </summary>
+		bool factorUD(const Matrix<double>& pMatrix,
+			Matrix<double>& uMatrix, Vector<double>& dVector) const;
+
 	};	// end of class 'SolverPPPAll'
 }
 
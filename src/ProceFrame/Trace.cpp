@@ -3,9 +3,531 @@
 * 2023-05
 * added by ragn wang
 */
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
 #include "Trace.hpp"
+#include "CivilTime.hpp"
 
 namespace fippp
 {
-	
-}
\ No newline at end of file
+	namespace
+	{
+		const char traceMagic[8] = { 'F','I','P','P','P','T','R','C' };
+		const char chunkMagic[4] = { 'C','H','N','K' };
+		const uint32_t traceVersion = 1;
+		const uint32_t byteOrderMark = 0x01020304;
+
+		const size_t headerSize = 8 + 4 * 4;
+		const size_t chunkHeaderSize = 4 + 3 * 4;
+		const size_t recordHeaderSize = 2 * 2 + 4 * 4 + 3 * 4 + 8;
+
+		// chunks are written when they reach this size
+		const size_t chunkSize = 4 << 20;
+
+		// record coding flags
+		const uint16_t codingXor = 1;
+		const uint16_t codingShuffle = 2;
+
+		template <class T>
+		void put(std::vector<char>& buf, const T& value)
+		{
+			const char* p(reinterpret_cast<const char*>(&value));
+			buf.insert(buf.end(), p, p + sizeof(T));
+		}
+
+		template <class T>
+		T get(const char*& p)
+		{
+			T value;
+			std::memcpy(&value, p, sizeof(T));
+			p += sizeof(T);
+			return value;
+		}
+
+		// byte plane k of the n doubles of 'in' goes to out[k*n .. k*n+n-1],
+		// so the bytes that change little between records are together
+		void shuffle(const double* in, size_t n, char* out)
+		{
+			const char* p(reinterpret_cast<const char*>(in));
+			for (size_t i = 0; i < n; i++)
+				for (size_t k = 0; k < 8; k++)
+					out[k * n + i] = p[i * 8 + k];
+		}
+
+		void unshuffle(const char* in, size_t n, double* out)
+		{
+			char* p(reinterpret_cast<char*>(out));
+			for (size_t i = 0; i < n; i++)
+				for (size_t k = 0; k < 8; k++)
+					p[i * 8 + k] = in[k * n + i];
+		}
+
+		void xorWith(double* v, const double* prev, size_t n)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				uint64_t a, b;
+				std::memcpy(&a, &v[i], 8);
+				std::memcpy(&b, &prev[i], 8);
+				a ^= b;
+				std::memcpy(&v[i], &a, 8);
+			}
+		}
+
+		// Run-length coding: a control byte c < 128 is followed by c+1
+		// bytes copied as they are, c >= 128 by one byte repeated
+		// c-125 times (3 to 130)
+		void pack(const char* in, size_t n, std::vector<char>& out)
+		{
+			out.clear();
+			out.reserve(n / 2 + 16);
+			size_t i(0), lit(0);
+			while (i < n)
+			{
+				size_t run(1);
+				while (i + run < n && run < 130 && in[i + run] == in[i])
+					run++;
+				if (run >= 3)
+				{
+					out.push_back(static_cast<char>(125 + run));
+					out.push_back(in[i]);
+					i += run;
+					continue;
+				}
+
+				// literal bytes up to the next run of 3
+				lit = i;
+				while (i < n && i - lit < 128)
+				{
+					if (i + 2 < n && in[i] == in[i + 1] && in[i] == in[i + 2])
+						break;
+					i++;
+				}
+				out.push_back(static_cast<char>(i - lit - 1));
+				out.insert(out.end(), in + lit, in + i);
+			}
+		}
+
+		bool unpack(const char* in, size_t n, std::vector<char>& out,
+			size_t rawSize)
+		{
+			out.clear();
+			out.reserve(rawSize);
+			size_t i(0);
+			while (i < n)
+			{
+				unsigned char c(static_cast<unsigned char>(in[i++]));
+				if (c < 128)
+				{
+					size_t len(size_t(c) + 1);
+					if (i + len > n)
+						return false;
+					out.insert(out.end(), in + i, in + i + len);
+					i += len;
+				}
+				else
+				{
+					if (i >= n)
+						return false;
+					out.insert(out.end(), size_t(c) - 125, in[i++]);
+				}
+			}
+			return out.size() == rawSize;
+		}
+
+	}	// End of anonymous namespace
+
+
+	TraceStream::TraceStream()
+		: format(Text), compress(false), decimation(1), maxDim(0),
+		  epochCount(0), selected(true), chunkRecords(0)
+	{}
+
+
+	TraceStream::~TraceStream()
+	{
+		close();
+	}
+
+
+	bool TraceStream::open(const std::string& file, int fmt, bool compressed)
+	{
+		close();
+
+		format = (fmt == Binary) ? Binary : Text;
+		compress = (format == Binary) && compressed;
+		epochCount = 0;
+		selected = true;
+
+		if (format == Text)
+		{
+			ofs.open(file.c_str(), ios::out);
+			if (!ofs.is_open())
+				return false;
+			ofs << fixed << setprecision(8);
+			return true;
+		}
+
+		ofs.open(file.c_str(), ios::out | ios::binary | ios::trunc);
+		if (!ofs.is_open())
+			return false;
+
+		std::vector<char> head;
+		head.insert(head.end(), traceMagic, traceMagic + 8);
+		put(head, traceVersion);
+		put(head, byteOrderMark);
+		put(head, static_cast<uint32_t>(compress ? 1 : 0));
+		put(head, static_cast<uint32_t>(0));
+		ofs.write(&head[0], head.size());
+
+		chunk.clear();
+		chunk.reserve(chunkSize + chunkSize / 4);
+		chunkRecords = 0;
+		previous.clear();
+
+		return ofs.good();
+	}
+
+
+	void TraceStream::close()
+	{
+		if (!ofs.is_open())
+			return;
+		if (format == Binary)
+			flushChunk();
+		ofs.close();
+	}
+
+
+	void TraceStream::setEpoch(const CommonTime& t)
+	{
+		epoch = t;
+		selected = (epochCount++ % decimation) == 0;
+		if (!isTraced())
+			return;
+
+		if (format == Text)
+		{
+			ofs << "epoch: " << '\n'
+				<< CivilTime(epoch).printf("%04Y/%02m/%02d %02H:%02M:%06.3f")
+				<< '\n';
+			return;
+		}
+
+		// the chunks end at an epoch, once they are large enough
+		if (chunk.size() >= chunkSize)
+			flushChunk();
+		record(recEpoch, std::string(), 0, 0, NULL, NULL, 0);
+	}
+
+
+	void TraceStream::text(const std::string& name, const std::string& value)
+	{
+		if (!isTraced())
+			return;
+
+		if (format == Text)
+		{
+			ofs << name << '\n' << value << '\n';
+			return;
+		}
+		record(recText, name, 1, value.size(), NULL, value.data(), value.size());
+	}
+
+
+	void TraceStream::vector(const std::string& name, const double* v, size_t n)
+	{
+		if (!isTraced())
+			return;
+
+		if (maxDim > 0 && n > size_t(maxDim))
+			n = maxDim;
+
+		if (format == Text)
+		{
+			ofs << name << '\n';
+			for (size_t i = 0; i < n; i++)
+				ofs << " " << v[i] << '\n';
+			return;
+		}
+		record(recVector, name, n, 1, v, NULL, 0);
+	}
+
+
+	void TraceStream::matrix(const std::string& name, const Matrix<double>& m)
+	{
+		if (!isTraced())
+			return;
+
+		size_t rows(m.rows()), cols(m.cols());
+		if (maxDim > 0)
+		{
+			rows = std::min(rows, size_t(maxDim));
+			cols = std::min(cols, size_t(maxDim));
+		}
+
+		if (format == Text)
+		{
+			ofs << name << '\n';
+			if (rows == m.rows() && cols == m.cols())
+				ofs << m << '\n';
+			else
+				ofs << Matrix<double>(m, 0, 0, rows, cols) << '\n';
+			return;
+		}
+
+		work.resize(rows * cols);
+		for (size_t i = 0; i < rows; i++)
+			for (size_t j = 0; j < cols; j++)
+				work[i * cols + j] = m(i, j);
+		record(recMatrix, name, rows, cols,
+			work.empty() ? NULL : &work[0], NULL, 0);
+	}
+
+
+	void TraceStream::record(int type, const std::string& name,
+		size_t rows, size_t cols, const double* data,
+		const char* bytes, size_t nBytes)
+	{
+		const size_t n(data ? rows * cols : 0);
+		if (data)
+			nBytes = n * 8;
+
+		uint16_t coding(0);
+		std::vector<double>* prev(NULL);
+		if (compress && n > 0)
+		{
+			coding = codingShuffle;
+			std::vector<double>& last(previous[name]);
+			if (last.size() == n)
+			{
+				coding |= codingXor;
+				prev = &last;
+			}
+		}
+
+		long day, sod;
+		double fsod;
+		TimeSystem ts;
+		epoch.get(day, sod, fsod, ts);
+
+		put(chunk, static_cast<uint16_t>(type));
+		put(chunk, coding);
+		put(chunk, static_cast<uint32_t>(name.size()));
+		put(chunk, static_cast<uint32_t>(rows));
+		put(chunk, static_cast<uint32_t>(cols));
+		put(chunk, static_cast<uint32_t>(nBytes));
+		put(chunk, static_cast<int32_t>(day));
+		put(chunk, static_cast<int32_t>(sod));
+		put(chunk, static_cast<int32_t>(ts));
+		put(chunk, fsod);
+		chunk.insert(chunk.end(), name.begin(), name.end());
+
+		if (coding)
+		{
+			std::vector<double> values(data, data + n);
+			if (prev)
+				xorWith(&values[0], &(*prev)[0], n);
+			size_t at(chunk.size());
+			chunk.resize(at + nBytes);
+			shuffle(&values[0], n, &chunk[at]);
+			previous[name].assign(data, data + n);
+		}
+		else if (data)
+		{
+			const char* p(reinterpret_cast<const char*>(data));
+			chunk.insert(chunk.end(), p, p + nBytes);
+		}
+		else if (bytes)
+		{
+			chunk.insert(chunk.end(), bytes, bytes + nBytes);
+		}
+
+		chunkRecords++;
+	}
+
+
+	void TraceStream::flushChunk()
+	{
+		if (chunkRecords == 0)
+			return;
+
+		const char* payload(&chunk[0]);
+		size_t stored(chunk.size());
+		if (compress)
+		{
+			pack(&chunk[0], chunk.size(), packed);
+			payload = packed.empty() ? NULL : &packed[0];
+			stored = packed.size();
+		}
+
+		std::vector<char> head;
+		head.insert(head.end(), chunkMagic, chunkMagic + 4);
+		put(head, static_cast<uint32_t>(chunkRecords));
+		put(head, static_cast<uint32_t>(chunk.size()));
+		put(head, static_cast<uint32_t>(stored));
+		ofs.write(&head[0], head.size());
+		if (stored)
+			ofs.write(payload, stored);
+
+		chunk.clear();
+		chunkRecords = 0;
+		previous.clear();
+	}
+
+
+	TraceReader::TraceReader()
+		: compress(false), pos(0)
+	{}
+
+
+	bool TraceReader::open(const std::string& file)
+	{
+		ifs.open(file.c_str(), ios::in | ios::binary);
+		if (!ifs)
+			return false;
+
+		char head[headerSize];
+		if (!ifs.read(head, headerSize))
+			return false;
+
+		const char* p(head);
+		if (std::memcmp(p, traceMagic, 8) != 0)
+			return false;
+		p += 8;
+		if (get<uint32_t>(p) != traceVersion ||
+			get<uint32_t>(p) != byteOrderMark)
+			return false;
+		compress = (get<uint32_t>(p) & 1) != 0;
+
+		chunk.clear();
+		pos = 0;
+		return true;
+	}
+
+
+	bool TraceReader::readChunk()
+		noexcept(false)
+	{
+		char head[chunkHeaderSize];
+		if (!ifs.read(head, chunkHeaderSize))
+		{
+			if (ifs.gcount() == 0)
+				return false;
+			Exception e("Trace file truncated in a chunk header");
+			GPSTK_THROW(e);
+		}
+
+		const char* p(head);
+		if (std::memcmp(p, chunkMagic, 4) != 0)
+		{
+			Exception e("Trace file chunk header not found");
+			GPSTK_THROW(e);
+		}
+		p += 4;
+		get<uint32_t>(p);
+		uint32_t rawSize(get<uint32_t>(p));
+		uint32_t stored(get<uint32_t>(p));
+
+		std::vector<char> buf(stored);
+		if (stored && !ifs.read(&buf[0], stored))
+		{
+			Exception e("Trace file truncated in a chunk");
+			GPSTK_THROW(e);
+		}
+
+		if (compress)
+		{
+			if (!unpack(stored ? &buf[0] : NULL, stored, chunk, rawSize))
+			{
+				Exception e("Trace file chunk cannot be decoded");
+				GPSTK_THROW(e);
+			}
+		}
+		else
+		{
+			chunk.swap(buf);
+		}
+
+		pos = 0;
+		previous.clear();
+		return true;
+	}
+
+
+	bool TraceReader::next(TraceRecord& rec)
+		noexcept(false)
+	{
+		while (pos >= chunk.size())
+		{
+			if (!readChunk())
+				return false;
+		}
+
+		if (chunk.size() - pos < recordHeaderSize)
+		{
+			Exception e("Trace file record header cut");
+			GPSTK_THROW(e);
+		}
+
+		const char* p(&chunk[pos]);
+		rec.type = get<uint16_t>(p);
+		uint16_t coding(get<uint16_t>(p));
+		uint32_t nameLength(get<uint32_t>(p));
+		rec.rows = get<uint32_t>(p);
+		rec.cols = get<uint32_t>(p);
+		uint32_t nBytes(get<uint32_t>(p));
+		long day(get<int32_t>(p));
+		long sod(get<int32_t>(p));
+		TimeSystem ts(static_cast<TimeSystem>(get<int32_t>(p)));
+		double fsod(get<double>(p));
+
+		if (chunk.size() - pos < recordHeaderSize + nameLength + nBytes)
+		{
+			Exception e("Trace file record cut");
+			GPSTK_THROW(e);
+		}
+
+		rec.epoch.set(day, sod, fsod, ts);
+		rec.name.assign(p, nameLength);
+		p += nameLength;
+
+		rec.data.clear();
+		rec.text.clear();
+		if (rec.type == TraceStream::recText)
+		{
+			rec.text.assign(p, nBytes);
+		}
+		else
+		{
+			const size_t n(nBytes / 8);
+			rec.data.resize(n);
+			if (n > 0)
+			{
+				if (coding & codingShuffle)
+					unshuffle(p, n, &rec.data[0]);
+				else
+					std::memcpy(&rec.data[0], p, n * 8);
+
+				std::vector<double>& last(previous[rec.name]);
+				if (coding & codingXor)
+				{
+					if (last.size() != n)
+					{
+						Exception e("Trace file record refers to a missing one");
+						GPSTK_THROW(e);
+					}
+					xorWith(&rec.data[0], &last[0], n);
+				}
+				if (coding)
+					last = rec.data;
+			}
+		}
+
+		pos += recordHeaderSize + nameLength + nBytes;
+		return true;
+	}
+
+}
@@ -3,42 +3,191 @@
 #define FIPPP_TRACE_HPP
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
 #include <set>
 
 #include "Matrix.hpp"
 #include "Vector.hpp"
 #include "Triple.hpp"
+#include "CommonTime.hpp"
 
 using namespace gpstk;
 using namespace std;
 
 namespace fippp
 {
+	/// <summary>
+	/// Destination of the trace. It writes the text dump of the
+	/// matrices and vectors as before, or records of raw doubles in
+	/// a binary file, read back by the TraceReader program.
+	///
+	/// Binary file, in native byte order: a header of 24 bytes
+	///   magic[8] version byteOrder flags reserved (uint32)
+	/// followed by chunks
+	///   magic[4] records rawSize storedSize (uint32), then storedSize
+	///   bytes, run-length coded if the file is compressed
+	/// The raw chunk is a list of records
+	///   type coding (uint16) nameLength rows cols dataSize (uint32)
+	///   day sod timeSystem (int32) fsod (double), then the name and
+	///   dataSize bytes: rows x cols doubles by rows, or the text.
+	/// With compression, the doubles of a record are XORed with the
+	/// previous record of the same name and size in the chunk, and
+	/// stored byte plane by byte plane.
+	/// </summary>
+	class TraceStream
+	{
+	public:
+
+		enum Format
+		{
+			Text = 1,
+			Binary = 2
+		};
+
+		enum RecordType
+		{
+			recEpoch = 1,
+			recText = 2,
+			recVector = 3,
+			recMatrix = 4
+		};
+
+		TraceStream();
+
+		~TraceStream();
+
+		/// open the file, as Text or Binary
+		bool open(const std::string& file, int fmt, bool compressed = false);
+
+		/// write the records kept and close the file
+		void close();
+
+		bool is_open() const
+		{ return ofs.is_open(); }
+
+		/// trace one epoch out of n
+		void setDecimation(int n)
+		{ decimation = (n > 1) ? n : 1; }
+
+		/// write the leading n x n block of the matrices and the first
+		/// n elements of the vectors, 0 for all
+		void setMaxDim(int n)
+		{ maxDim = (n > 0) ? n : 0; }
+
+		/// start a new epoch, the records that follow belong to it
+		void setEpoch(const CommonTime& t);
+
+		/// the current epoch is written
+		bool isTraced() const
+		{ return ofs.is_open() && selected; }
+
+		void text(const std::string& name, const std::string& value);
+
+		void vector(const std::string& name, const double* v, size_t n);
+
+		void matrix(const std::string& name, const Matrix<double>& m);
+
+	private:
+
+		void record(int type, const std::string& name,
+			size_t rows, size_t cols, const double* data,
+			const char* bytes, size_t nBytes);
+
+		void flushChunk();
+
+		std::ofstream ofs;
+		int format;
+		bool compress;
+		int decimation;
+		int maxDim;
+		long epochCount;
+		bool selected;
+		CommonTime epoch;
+
+		/// raw chunk being filled
+		std::vector<char> chunk;
+		unsigned long chunkRecords;
+
+		/// last doubles of each name in the chunk, for the XOR coding
+		std::map<std::string, std::vector<double> > previous;
+
+		/// work arrays of the coding
+		std::vector<double> work;
+		std::vector<char> packed;
+	};
+
+
+	/// <summary>
+	/// One record of a binary trace file
+	/// </summary>
+	struct TraceRecord
+	{
+		int type;
+		std::string name;
+		CommonTime epoch;
+		size_t rows;
+		size_t cols;
+		std::vector<double> data;
+		std::string text;
+	};
+
+
+	/// <summary>
+	/// Sequential reader of the binary trace files written by TraceStream
+	/// </summary>
+	class TraceReader
+	{
+	public:
+
+		TraceReader();
+
+		/// open the file and check its header
+		bool open(const std::string& file);
+
+		/// the next record, false at the end of the file
+		/// @throw Exception if the file is corrupt
+		bool next(TraceRecord& rec) noexcept(false);
+
+		bool isCompressed() const
+		{ return compress; }
+
+	private:
+
+		bool readChunk() noexcept(false);
+
+		std::ifstream ifs;
+		bool compress;
+
+		std::vector<char> chunk;
+		size_t pos;
+		std::map<std::string, std::vector<double> > previous;
+	};
+
 
 	template<typename T>
-	void traceMatrix(std::ofstream* traceStream, std::string name, const Matrix<T>& matrix)
+	void traceMatrix(TraceStream* traceStream, std::string name, const Matrix<T>& matrix)
 	{
-		if (traceStream)
+		if (traceStream && traceStream->isTraced())
 		{
-			(*traceStream) << name << endl;
-			(*traceStream) << matrix << endl;
+			traceStream->matrix(name, matrix);
 		}
 	}
 
 	template<typename T>
-	void traceVector(std::ofstream* traceStream, std::string name, const Vector<T>& vec)
+	void traceVector(TraceStream* traceStream, std::string name, const Vector<T>& vec)
 	{
-		if (traceStream)
+		if (traceStream && traceStream->isTraced())
 		{
-			(*traceStream) << name << endl;
-			//(*traceStream) << endl;
-			for (auto itData = vec.begin();
-				itData != vec.end();
-				++itData)
-			{
-				(*traceStream) << " "
-					<< *itData << endl;
-			}
+			std::vector<double> values(vec.size());
+			for (size_t i = 0; i < vec.size(); i++)
+				values[i] = static_cast<double>(vec[i]);
+			traceStream->vector(name, values.empty() ? NULL : &values[0],
+				values.size());
 		}
 	}
 
@@ -52,31 +201,36 @@ namespace fippp
 	//}
 
 	template<typename T>
-	void traceSet(std::ofstream* traceStream, std::string name, const std::set<T>& sets)
+	void traceSet(TraceStream* traceStream, std::string name, const std::set<T>& sets)
 	{
-		if (traceStream != NULL)
+		if (traceStream != NULL && traceStream->isTraced())
 		{
-			(*traceStream) << name << endl;
+			std::ostringstream oss;
 			for (auto itData = sets.begin();
 				itData != sets.end();
 				++itData)
 			{
-				(*traceStream) << " "
+				oss << " "
 					<< *itData << endl;
 			}
+			std::string value(oss.str());
+			if (!value.empty())
+				value.erase(value.size() - 1);
+			traceStream->text(name, value);
 		}
 	}
 
 
 	template<typename T>
-	void traceT(std::ofstream* traceStream, const std::string& name, const T& t)
+	void traceT(TraceStream* traceStream, const std::string& name, const T& t)
 	{
-		if (traceStream != NULL)
+		if (traceStream != NULL && traceStream->isTraced())
 		{
-			(*traceStream) << name << endl;
-			(*traceStream) << fixed
+			std::ostringstream oss;
+			oss << fixed
 				<< setprecision(8)
-				<<t << endl;
+				<<t;
+			traceStream->text(name, oss.str());
 		}
 	}
 	//template<typename T>
@@ -97,8 +251,7 @@ namespace fippp
 	//		//	traceT(traceStream, name, t);
 	//	}
 	//}
-	
+
 }
 
 #endif // !FIPPP_TRACE_HPP
-
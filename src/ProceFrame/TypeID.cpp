@@ -6,6 +6,8 @@
  * added many types 2023-03
  */
 
+#include <unordered_map>
+
 #include "TypeID.hpp"
 #include "Exception.hpp"
 
@@ -499,16 +501,39 @@ namespace gpstk
     };
 
 
+    namespace
+    {
+          // Index of 'tStrings' by name, built once on first use. The first
+          // entry wins when a name is repeated, as in a linear scan.
+        const std::unordered_map<std::string, int>& typeNameIndex()
+        {
+            static const std::unordered_map<std::string, int> nameIndex(
+                []()
+                {
+                    std::unordered_map<std::string, int> index;
+                    index.reserve(TypeID::count);
+                    for(int i=0; i<TypeID::count; i++)
+                    {
+                        index.emplace(TypeID::tStrings[i], i);
+                    }
+                    return index;
+                }() );
+
+            return nameIndex;
+        }
+    }
+
+
     // Explicit constructor
     TypeID::TypeID(std::string name)
     {
-        for(int i=0; i<count; i++) 
+        const std::unordered_map<std::string, int>& index( typeNameIndex() );
+
+        std::unordered_map<std::string, int>::const_iterator it( index.find(name) );
+        if( it != index.end() )
         {
-           if(tStrings[i] == name ) 
-           {
-              type = static_cast<ValueType>(i);
-              return;
-           }
+            type = static_cast<ValueType>(it->second);
+            return;
         }
 
         // if it comes here, the type is unknown
@@ -549,9 +574,7 @@ namespace gpstk
     // convert this object to a string representation
     std::string TypeID::asString() const
     {
-        std::ostringstream oss;
-        oss << TypeID::tStrings[type];
-        return oss.str();
+        return TypeID::tStrings[type];
     }
 
 
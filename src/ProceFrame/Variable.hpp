@@ -9,6 +9,9 @@
 #define GPSTK_VARIABLE_HPP
 
 
+#include <functional>
+#include <unordered_map>
+
 #include "DataStructures.hpp"
 #include "StochasticModel.hpp"
 
@@ -451,6 +454,26 @@ namespace gpstk
    }; // End of class 'Variable'
 
 
+      /** Hash of a Variable, for unordered containers. It mixes the
+       *  fields compared by Variable::operator==, except the source: the
+       *  unknowns of an equation system mostly share it, and hashing its
+       *  name would cost more than the collisions.
+       */
+   struct VariableHash
+   {
+      size_t operator()(const Variable& v) const
+      {
+         SatID sat(v.getSatellite());
+         size_t h( std::hash<int>()(v.getTypeOrder()) );
+         h = h*31 + std::hash<int>()(static_cast<int>(v.getType().type));
+         h = h*31 + std::hash<int>()(static_cast<int>(sat.system));
+         h = h*31 + std::hash<int>()(sat.id);
+         h = h*31 + std::hash<double>()(v.getArc());
+         return h;
+      }
+   };
+
+
       /// A structure used to store the coefficent information for a Variable.
    struct Coefficient
    {
@@ -528,6 +551,7 @@ namespace gpstk
    typedef std::map<Variable, Coefficient> VarCoeffMap;
    typedef std::map<CommonTime, VariableSet> epochVarsMap;
    typedef std::map<Variable, std::vector<double> > VariableVectorMap;;
+   typedef std::unordered_map<Variable, int, VariableHash> VariableIndexMap;
 
    typedef std::map<CommonTime, VariableEstDataMap> epochVarEstDataMap;
 
@@ -4,6 +4,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <memory>
 
 #include "CommonTime.hpp"
 #include "YDSTime.hpp"
@@ -14,12 +15,15 @@
 #include "DataStructures.hpp"
 #include "SatelliteSystem.hpp"
 #include "FreqConsts.hpp"
+#include "EpochContext.hpp"
 //#include "Variable.hpp"
 
 using namespace gpstk::StringUtils;
 
 namespace gpstk
 {
+   struct gnssRinexFileHeader;
+
    /// Defines a header containing the source and epoch of data, plus extra
    /// data extracted from a Rinex file
    /// only keep useful data
@@ -40,6 +44,9 @@ namespace gpstk
       string        antType;
       Triple        antennaDeltaHEN;
       Triple        antennaPosition;
+
+      /// types of data added by addRxData(); the epochs built from a
+      /// gnssRinexFileHeader leave it empty, see obsTypes()
       SysTypesMap   mapObsTypes;
 
       // added by ragnwang
@@ -54,14 +61,132 @@ namespace gpstk
       // ecef2neu rotate matrix; Note, converted to 'neu'
       Matrix<double> neuRotateMatrix;   // neu = dxyz * neuRotateMatrix
       ////////////////////////////////////////////
+      /// filled by addRxData() only, see glonassFreq()
       std::map<RinexSatID/*SatID*/, int> glonassFreqNo;
 
-      // satellite-indexed types
+      /// observation types of the file, read from 'fileHeader' when it
+      /// is set, without a copy per epoch
+      const SysTypesMap& obsTypes() const;
+
+      /// GLONASS frequency numbers of the file, as obsTypes()
+      const std::map<RinexSatID/*SatID*/, int>& glonassFreq() const;
+
+      // satellite-indexed types; they change with the observations
+      // of the epoch and are rewritten by the processors
       std::map<RinexSatID/*SatID*/, TypeIDVec> satTypes;
       std::map<RinexSatID/*SatID*/, TypeIDVec> satShortTypes;
 
+      // header of the observation file, shared by all its epochs
+      std::shared_ptr<const gnssRinexFileHeader> fileHeader;
+
+      // Sun/Moon, Earth orientation of the epoch, set by
+      // ComputeEpochContext; empty if it did not run
+      std::shared_ptr<const EpochContext> context;
+
    }; // End of struct 'sourceRinexHeader'
 
+   /// Observation types of one Rinex3ObsHeader converted to TypeID. It is
+   /// built once per observation file and reused for every epoch, so no
+   /// type name is built or looked up per observation.
+   struct gnssObsTypeTable
+   {
+      gnssObsTypeTable() {};
+
+      /// Build the table from the header; throws InvalidType if a header
+      /// observation code has no TypeID.
+      explicit gnssObsTypeTable(const Rinex3ObsHeader& rxHeader)
+         noexcept(false)
+      {
+         for (auto& isys : rxHeader.mapObsTypes)
+         {
+            TypeIDVec& longTypes = mapObsTypes[isys.first];
+            TypeIDVec& shortTypes = mapShortTypes[isys.first];
+            std::vector<double>& typeScales = mapTypeScales[isys.first];
+            for (auto& itype : isys.second)
+            {
+               TypeID typeId(itype.asString() + isys.first[0]);
+               longTypes.push_back(typeId);
+
+               // phase is stored in meters
+               const std::string& typeStr = TypeID::tStrings[typeId.type];
+               double scale(1.0);
+               if (typeStr[0] == 'L')
+               {
+                  scale = getWavelength(asSatelliteSystem(isys.first[0]),
+                     int(typeStr[1]) - 48);
+               }
+               typeScales.push_back(scale);
+
+               // e.g. C1CG -> C1G. Unknown short types are kept as
+               // 'Unknown' and only reported if such data is used.
+               TypeID shortType;
+               try
+               {
+                  shortType = TypeID(typeStr.substr(0, 2) + typeStr.substr(3, 1));
+               }
+               catch (InvalidType& e)
+               {
+                  shortType = TypeID(TypeID::Unknown);
+               }
+               shortTypes.push_back(shortType);
+            }
+         }
+      };
+
+      /// long types (e.g. C1CG) of each system, in header order
+      SysTypesMap mapObsTypes;
+
+      /// short type (e.g. C1G) of each entry of 'mapObsTypes'
+      SysTypesMap mapShortTypes;
+
+      /// factor applied to each entry of 'mapObsTypes', the wavelength
+      /// for phase (cycles -> meters) and 1 for the other types
+      std::map<std::string, std::vector<double> > mapTypeScales;
+
+   }; // End of struct 'gnssObsTypeTable'
+
+   /// Per-file part of the gnssRinex header. It is built once from the
+   /// Rinex3ObsHeader and then only shared (read only) by the epochs of
+   /// the file, so the Rinex3ObsHeader is not copied into every epoch.
+   struct gnssRinexFileHeader
+   {
+      /// throws InvalidType if a header observation code has no TypeID
+      explicit gnssRinexFileHeader(const Rinex3ObsHeader& rxHeader)
+         noexcept(false)
+         : beginEpoch(rxHeader.beginEpoch),
+           endEpoch(rxHeader.endEpoch),
+           source(rxHeader.fileSys, rxHeader.markerName),
+           antType(rxHeader.antType),
+           antennaDeltaHEN(rxHeader.antennaDeltaHEN),
+           antennaPosition(rxHeader.antennaPosition),
+           interval(rxHeader.interval),
+           glonassFreqNo(rxHeader.glonassFreqNo),
+           obsTypes(rxHeader)
+      {};
+
+      CommonTime    beginEpoch, endEpoch;
+      SourceID      source;
+      string        antType;
+      Triple        antennaDeltaHEN;
+      Triple        antennaPosition;
+      double        interval;
+      std::map<RinexSatID/*SatID*/, int> glonassFreqNo;
+
+      /// observation types of the file
+      gnssObsTypeTable obsTypes;
+
+   }; // End of struct 'gnssRinexFileHeader'
+
+   inline const SysTypesMap& gnssRinexHeader::obsTypes() const
+   {
+      return fileHeader ? fileHeader->obsTypes.mapObsTypes : mapObsTypes;
+   }
+
+   inline const std::map<RinexSatID, int>& gnssRinexHeader::glonassFreq() const
+   {
+      return fileHeader ? fileHeader->glonassFreqNo : glonassFreqNo;
+   }
+
    struct gnssRinex : gnssData<gnssRinexHeader, satTypeValueMap>
    {
         /// Default constructor
@@ -72,53 +197,50 @@ namespace gpstk
          * @param gds     gnssRinex object containing data to be added.
          */
        gnssRinex(const Rinex3ObsData& rxData )
+          : gnssRinex(rxData, std::make_shared<const gnssRinexFileHeader>(rxData.auxHeader))
+       {};
+
+        /** Adds 'Rx3ObsData' object data to this structure, using the
+         *  header of the file built once for all the epochs.
+         *  'rxData.auxHeader' is not used.
+         *
+         * @param rxData      epoch data.
+         * @param fileHeader  header of the observation file.
+         */
+       gnssRinex(const Rinex3ObsData& rxData,
+                 const std::shared_ptr<const gnssRinexFileHeader>& fileHeader)
        {
+           const gnssRinexFileHeader& fh = *fileHeader;
+           const gnssObsTypeTable& typeTable = fh.obsTypes;
+
+           (*this).header.fileHeader = fileHeader;
            (*this).header.epoch = rxData.time;
-           (*this).header.beginEpoch = rxData.auxHeader.beginEpoch;
-           (*this).header.endEpoch = rxData.auxHeader.endEpoch;
+           (*this).header.beginEpoch = fh.beginEpoch;
+           (*this).header.endEpoch = fh.endEpoch;
            (*this).header.epochFlag = rxData.epochFlag;
-           (*this).header.source  = SourceID(rxData.auxHeader.fileSys, rxData.auxHeader.markerName);
-           (*this).header.antType = rxData.auxHeader.antType;
-           (*this).header.antennaDeltaHEN = rxData.auxHeader.antennaDeltaHEN;
-           (*this).header.antennaPosition = rxData.auxHeader.antennaPosition;
-           (*this).header.interval = rxData.auxHeader.interval;
-           for (auto& isys : rxData.auxHeader.mapObsTypes)
-           {
-               SysTypesMap::iterator sysType = (*this).header.mapObsTypes.find(isys.first);
-               if (sysType == (*this).header.mapObsTypes.end())
-               {
-                   TypeIDVec typeIdVec;
-                   sysType = (*this).header.mapObsTypes.emplace(isys.first, typeIdVec).first;
-               }
-               for (auto& itype : isys.second)
-               {
-                   TypeID typeId(itype.asString() + isys.first[0]);
-                   sysType->second.push_back(typeId);
-               }
-           }
-
-           //(*this).header.mapObsTypes   = rxData.header.mapObsTypes;
-           (*this).header.glonassFreqNo = rxData.auxHeader.glonassFreqNo;
+           (*this).header.source  = fh.source;
+           (*this).header.antType = fh.antType;
+           (*this).header.antennaDeltaHEN = fh.antennaDeltaHEN;
+           (*this).header.antennaPosition = fh.antennaPosition;
+           (*this).header.interval = fh.interval;
 
            satTypeValueMap satTypeValue;
            for (auto& isat : rxData.obs)
            {
-               RinexSatID satId = isat.first;
-               satTypeValueMap::iterator satDatas = satTypeValue.find(isat.first);
-               if (satDatas == satTypeValue.end())
-               {
-                   typeValueMap typeValMap;
-                   satDatas = satTypeValue.emplace(isat.first, typeValMap).first;
-                   (*this).header.satTypes[isat.first].clear();
-                   (*this).header.satShortTypes[isat.first].clear();
-               }
-               typeValueMap typeValue;
+               typeValueMap& satDatas = satTypeValue[isat.first];
+               TypeIDVec& satTypeVec = (*this).header.satTypes[isat.first];
+               TypeIDVec& satShortTypeVec = (*this).header.satShortTypes[isat.first];
+               satTypeVec.clear();
+               satShortTypeVec.clear();
+
                std::string shortSys(1, asChar(isat.first.system));
-               SysTypesMap::iterator satTypes = (*this).header.mapObsTypes.find(shortSys);
-               if (satTypes == (*this).header.mapObsTypes.end())
+               SysTypesMap::const_iterator satTypes = typeTable.mapObsTypes.find(shortSys);
+               if (satTypes == typeTable.mapObsTypes.end())
                {
                    continue;
                }
+               const TypeIDVec& shortTypeVec = typeTable.mapShortTypes.find(shortSys)->second;
+               const std::vector<double>& scaleVec = typeTable.mapTypeScales.find(shortSys)->second;
 
                for (int i = 0 ;i < satTypes->second.size();++i)
                {
@@ -126,27 +248,25 @@ namespace gpstk
                    {
                        continue;
                    }
-                   std::string longTypeStr = satTypes->second[i].asString();
-				   double obsData = isat.second[i].data;
-				   if (longTypeStr[0] == 'L')
+                   const TypeID& longType = satTypes->second[i];
+				   double obsData = isat.second[i].data * scaleVec[i];
+                   satDatas.emplace(longType, obsData);
+                   satTypeVec.push_back(longType);
+
+				   TypeID shortType = shortTypeVec[i];
+				   if (shortType == TypeID::Unknown)
 				   {
-					   double welve = getWavelength(isat.first.system, int(longTypeStr[1]) - 48);
-					   obsData = obsData * welve;
+					   // reports the unknown type as before
+					   const std::string& longTypeStr = TypeID::tStrings[longType.type];
+					   shortType = TypeID(longTypeStr.substr(0, 2) + longTypeStr.substr(3, 1));
 				   }
-                   satDatas->second.emplace(satTypes->second[i], obsData);
-                   (*this).header.satTypes[isat.first].push_back(satTypes->second[i]);
-                   
-				   TypeID shortType = TypeID(longTypeStr.substr(0, 2) + longTypeStr.substr(3, 1));
-                   auto isExist = find((*this).header.satShortTypes[isat.first].begin(), (*this).header.satShortTypes[isat.first].end(), shortType);
-                   if (isExist == (*this).header.satShortTypes[isat.first].end())
+                   auto isExist = find(satShortTypeVec.begin(), satShortTypeVec.end(), shortType);
+                   if (isExist == satShortTypeVec.end())
                    {
-                       (*this).header.satShortTypes[isat.first].push_back(shortType);
+                       satShortTypeVec.push_back(shortType);
                    }
                }
            }
-// 
-//            (*this).header.satTypes      = rxData.satTypes;
-//            (*this).header.satShortTypes = rxData.satShortTypes;
            (*this).body = satTypeValue;
        };
 
@@ -237,8 +357,9 @@ namespace gpstk
            if(detail)
            {
                s << "mapObsTypes" << endl;
-               for(auto sys=(*this).header.mapObsTypes.begin(); 
-                        sys!=(*this).header.mapObsTypes.end(); sys++)
+               const SysTypesMap& mapObsTypes = (*this).header.obsTypes();
+               for(auto sys=mapObsTypes.begin(); 
+                        sys!=mapObsTypes.end(); sys++)
                {
                    s << (*sys).first << " ";
                    for(auto type=(*sys).second.begin();type!=(*sys).second.end();type++)
@@ -413,8 +534,8 @@ namespace gpstk
            (*this).header.sourceAntType[gRin.header.source] = gRin.header.antType;
            (*this).header.sourceAntennaDeltaHEN[gRin.header.source] = gRin.header.antennaDeltaHEN;
            (*this).header.sourceAntennaPosition[gRin.header.source] = gRin.header.antennaPosition;
-           (*this).header.sourceMapObsTypes[gRin.header.source] = gRin.header.mapObsTypes;
-           (*this).header.sourceGlonassFreqNo[gRin.header.source] = gRin.header.glonassFreqNo;
+           (*this).header.sourceMapObsTypes[gRin.header.source] = gRin.header.obsTypes();
+           (*this).header.sourceGlonassFreqNo[gRin.header.source] = gRin.header.glonassFreq();
            (*this).header.sourceSatTypes[gRin.header.source] = gRin.header.satTypes;
            (*this).header.sourceSatShortTypes[gRin.header.source] = gRin.header.satShortTypes;
 
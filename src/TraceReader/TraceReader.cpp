@@ -0,0 +1,173 @@
+#pragma ident "$Id$"
+/*
+* Convert a binary trace file (trace = 2) to the text of the text
+* trace (trace = 1), or list the records it holds.
+*
+* Usage: TraceReader -i station.trb [-n name] [-p 8] [-s]
+*/
+#include <iostream>
+#include <iomanip>
+#include <map>
+
+#include "BasicFramework.hpp"
+#include "Trace.hpp"
+#include "CivilTime.hpp"
+#include "StringUtils.hpp"
+
+using namespace std;
+using namespace gpstk;
+using namespace gpstk::StringUtils;
+using namespace fippp;
+
+class TraceReaderApp : public BasicFramework
+{
+public:
+	TraceReaderApp(char* arg0);
+
+protected:
+
+	// Method that will take care of processing
+	virtual void process();
+
+private:
+
+	// the record is written, given the names asked for
+	bool isSelected(const TraceRecord& rec) const;
+
+	CommandOptionWithAnyArg _input;
+	CommandOptionWithAnyArg _name;
+	CommandOptionWithNumberArg _precision;
+	CommandOptionNoArg _summary;
+};
+
+TraceReaderApp::TraceReaderApp(char* arg0)
+	: BasicFramework(arg0,
+		"Convert a binary trace file of FiPPPSolver to text."),
+	  _input('i', "input",
+		" [-i|--input]           Binary trace file.", true),
+	  _name('n', "name",
+		" [-n|--name]            Only the records whose name holds this text."),
+	  _precision('p', "precision",
+		" [-p|--precision]       Digits after the point (default 8)."),
+	  _summary('s', "summary",
+		" [-s|--summary]         Count of records and values per name.")
+{
+	_input.setMaxCount(1);
+	_precision.setMaxCount(1);
+}
+
+bool TraceReaderApp::isSelected(const TraceRecord& rec) const
+{
+	if (!_name.getCount() || rec.type == TraceStream::recEpoch)
+		return true;
+	for (size_t i = 0; i < _name.getValue().size(); i++)
+	{
+		if (rec.name.find(_name.getValue()[i]) != string::npos)
+			return true;
+	}
+	return false;
+}
+
+void TraceReaderApp::process()
+{
+	int precision(8);
+	if (_precision.getCount())
+		precision = asInt(_precision.getValue()[0]);
+
+	const string& file = _input.getValue()[0];
+	TraceReader reader;
+	if (!reader.open(file))
+	{
+		cerr << "cannot read " << file << ": not a binary trace file" << endl;
+		exitCode = EXIST_ERROR;
+		return;
+	}
+
+	// records and values of each name
+	map<string, pair<long, long> > counts;
+	long epochs(0);
+
+	cout << fixed << setprecision(precision);
+	TraceRecord rec;
+	try
+	{
+		while (reader.next(rec))
+		{
+			if (rec.type == TraceStream::recEpoch)
+				epochs++;
+			if (!isSelected(rec))
+				continue;
+
+			if (_summary.getCount())
+			{
+				if (rec.type != TraceStream::recEpoch)
+				{
+					pair<long, long>& c(counts[rec.name]);
+					c.first++;
+					c.second += long(rec.data.size());
+				}
+				continue;
+			}
+
+			switch (rec.type)
+			{
+			case TraceStream::recEpoch:
+				cout << "epoch: " << '\n'
+					<< CivilTime(rec.epoch).printf("%04Y/%02m/%02d %02H:%02M:%06.3f")
+					<< '\n';
+				break;
+			case TraceStream::recText:
+				cout << rec.name << '\n' << rec.text << '\n';
+				break;
+			case TraceStream::recVector:
+				cout << rec.name << '\n';
+				for (size_t i = 0; i < rec.data.size(); i++)
+					cout << " " << rec.data[i] << '\n';
+				break;
+			case TraceStream::recMatrix:
+				cout << rec.name << '\n';
+				if (rec.data.empty())
+					cout << Matrix<double>(rec.rows, rec.cols) << '\n';
+				else
+					cout << Matrix<double>(rec.rows, rec.cols, &rec.data[0]) << '\n';
+				break;
+			default:
+				cerr << "unknown record type " << rec.type
+					<< " (" << rec.name << ")" << endl;
+				break;
+			}
+		}
+	}
+	catch (Exception& e)
+	{
+		cout.flush();
+		cerr << file << ": " << e.getText() << endl;
+		exitCode = EXIST_ERROR;
+	}
+
+	if (_summary.getCount())
+	{
+		cout << "epochs " << epochs
+			<< (reader.isCompressed() ? ", compressed" : "") << endl;
+		cout << setw(8) << "records" << setw(12) << "values" << "  name" << endl;
+		for (auto it = counts.begin(); it != counts.end(); ++it)
+		{
+			cout << setw(8) << it->second.first
+				<< setw(12) << it->second.second
+				<< "  " << it->first << endl;
+		}
+	}
+	cout.flush();
+}
+
+int main(int argc, char* argv[])
+{
+	TraceReaderApp program(argv[0]);
+	if (!program.initialize(argc, argv))
+		return 0;
+
+	if (!program.run())
+		return 1;
+
+	return program.exitCode;
+}
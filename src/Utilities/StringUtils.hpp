@@ -53,6 +53,7 @@
 #include <cstdio>   /// @todo Get rid of the stdio.h dependency if possible.
 #include <cctype>
 #include <limits>
+#include <algorithm>
 
 #ifdef _WIN32
 #if _MSC_VER < 1700 && _MSVCRT_
@@ -718,6 +719,84 @@ namespace gpstk
       inline long asInt(const std::string& s)
       { return strtol(s.c_str(), 0, 10); }
 
+         /**
+          * Convert a fixed-width field to a double precision floating
+          * point number without building a string.  Plain decimal
+          * fields ([sign]digits[.digits], e.g. the RINEX F14.3 data)
+          * are converted in place, anything else goes through strtod.
+          * @param s start of the field.
+          * @param len width of the field.
+          * @return same value as asDouble(std::string(s, len)).
+          */
+      inline double asDouble(const char* s, std::string::size_type len)
+      {
+         static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6,
+                                         1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+                                         1e13, 1e14, 1e15 };
+         std::string::size_type i = 0;
+         while (i < len && s[i] == ' ')
+            i++;
+         bool neg = false;
+         if (i < len && (s[i] == '-' || s[i] == '+'))
+         {
+            neg = (s[i] == '-');
+            i++;
+         }
+         unsigned long long mant = 0;
+         int nDigits = 0, nFrac = 0;
+         for (; i < len && s[i] >= '0' && s[i] <= '9'; i++, nDigits++)
+            mant = mant * 10 + (s[i] - '0');
+         if (i < len && s[i] == '.')
+         {
+            for (i++; i < len && s[i] >= '0' && s[i] <= '9'; i++, nDigits++, nFrac++)
+               mant = mant * 10 + (s[i] - '0');
+         }
+            // the mantissa is exact below 2^53 and so is the power of
+            // ten, the division is then correctly rounded like strtod
+         if (nDigits > 0 && nDigits <= 15 && (i == len || s[i] == ' '))
+         {
+            double v = static_cast<double>(mant) / pow10[nFrac];
+            return neg ? -v : v;
+         }
+         char buf[64];
+         std::string::size_type n = (len < sizeof(buf) - 1) ? len : sizeof(buf) - 1;
+         std::copy(s, s + n, buf);
+         buf[n] = '\0';
+         return strtod(buf, 0);
+      }
+
+         /**
+          * Convert a fixed-width field to an integer without building
+          * a string.
+          * @param s start of the field.
+          * @param len width of the field.
+          * @return same value as asInt(std::string(s, len)).
+          */
+      inline long asInt(const char* s, std::string::size_type len)
+      {
+         std::string::size_type i = 0;
+         while (i < len && s[i] == ' ')
+            i++;
+         bool neg = false;
+         if (i < len && (s[i] == '-' || s[i] == '+'))
+         {
+            neg = (s[i] == '-');
+            i++;
+         }
+         long v = 0;
+         int nDigits = 0;
+         for (; i < len && s[i] >= '0' && s[i] <= '9' && nDigits < 18; i++, nDigits++)
+            v = v * 10 + (s[i] - '0');
+            // other leading white space and long fields go through strtol
+         if (nDigits < 18 && (nDigits > 0 || i == len || !isspace(s[i])))
+            return neg ? -v : v;
+         char buf[64];
+         std::string::size_type n = (len < sizeof(buf) - 1) ? len : sizeof(buf) - 1;
+         std::copy(s, s + n, buf);
+         buf[n] = '\0';
+         return strtol(buf, 0, 10);
+      }
+
          /**
           * Convert a string to an unsigned integer.
           * @param s string containing a number.